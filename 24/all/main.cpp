@@ -0,0 +1,347 @@
+#include <algorithm>            // for max, min, sort
+#include <answer_cache.hpp>     // for AnswerCache, AnswerKey, hash_bytes
+#include <atomic>               // for atomic
+#include <chrono>               // for duration, steady_clock
+#include <cstddef>              // for size_t
+#include <cstdint>              // for uint64_t
+#include <ctime>                // for clock_gettime, timespec, CLOCK_THREAD_...
+#include <d01.hpp>              // for part_1, part_2
+#include <d02.hpp>              // for part_1, part_2
+#include <d03.hpp>              // for part_1, part_2
+#include <d04.hpp>              // for part_1, part_2
+#include <d05.hpp>              // for part_1, part_2
+#include <d06.hpp>              // for part_1, part_2
+#include <d07.hpp>              // for part_1, part_2
+#include <d08.hpp>              // for part_1, part_2
+#include <d09.hpp>              // for part_1, part_2
+#include <d10.hpp>              // for part_1, part_2
+#include <d11.hpp>              // for part_1, part_2
+#include <d12.hpp>              // for part_1, part_2
+#include <d13.hpp>              // for part_1, part_2
+#include <d14.hpp>              // for part_1, part_2
+#include <d15.hpp>              // for part_1, part_2
+#include <d16.hpp>              // for part_1, part_2
+#include <d17.hpp>              // for part_1, part_2
+#include <d18.hpp>              // for part_1, part_2
+#include <d19.hpp>              // for part_1, part_2
+#include <d20.hpp>              // for part_1, part_2
+#include <d21.hpp>              // for part_1, part_2
+#include <d22.hpp>              // for part_1, part_2
+#include <d23.hpp>              // for part_1, part_2
+#include <d24.hpp>              // for part_1, part_2
+#include <d25.hpp>              // for part_1, part_2
+#include <exception>            // for exception
+#include <filesystem>           // for exists
+#include <input_prefetcher.hpp> // for InputPrefetcher
+#include <iomanip>              // for operator<<, setw, setprecision
+#include <ios>                  // for fixed, left
+#include <iostream>             // for basic_ostream, operator<<, endl, cerr,...
+#include <map>                  // for map
+#include <null_buffer.hpp>      // for NullBuffer
+#include <optional>             // for optional, nullopt
+#include <ostream>              // for ostream
+#include <registry.hpp>         // for RegisteredDay, find_registered_day
+#include <set>                  // for set
+#include <stdexcept>            // for runtime_error
+#include <string>               // for string, stoul, operator+, to_string
+#include <thread>               // for thread
+#include <vector>               // for vector
+
+// Runs every part of every day in one process, spread over a pool of threads,
+// then prints how long each took. Parts are handed out longest expected first,
+// so the slow ones start straight away and the whole run takes about as long as
+// the slowest part rather than the sum of all of them.
+//
+// Usage: aoc-all [--threads N] [--day N]... [--input-root DIR] [--no-cache]
+//
+// The input for day NN is read from DIR/dNN/input.txt, DIR defaulting to the
+// top of the source tree. Days without an input file are skipped. Exits non
+// zero if any part threw.
+//
+// With AOC_CACHE_DIR set, parts already solved for the same input by the same
+// build of the day are read from the AnswerCache there instead, unless given
+// --no-cache.
+
+struct Options {
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  std::set<int> days;
+  std::string input_root = AOC_TOP_DIR;
+  bool cache = true;
+};
+
+Options parse_options(int argc, char *argv[]) {
+  Options options;
+  for (int index = 1; index < argc; ++index) {
+    const std::string arg = argv[index];
+    if (arg == "--no-cache") {
+      options.cache = false;
+      continue;
+    }
+    if (index + 1 >= argc) {
+      throw std::runtime_error("Missing value for " + arg);
+    }
+    const std::string value = argv[++index];
+    if (arg == "--threads") {
+      options.threads = std::stoul(value);
+    } else if (arg == "--day") {
+      options.days.insert(std::stoi(value));
+    } else if (arg == "--input-root") {
+      options.input_root = value;
+    } else {
+      throw std::runtime_error("Unknown option: " + arg);
+    }
+  }
+  if (options.threads == 0) {
+    throw std::runtime_error("Need at least one thread");
+  }
+  return options;
+}
+
+using PartFunction = std::string (*)(const std::string &);
+
+struct Part {
+  int day;
+  int part;
+  // Only used to order the work, so rough figures are fine. Taken from
+  // aoc-bench on a Release build.
+  double expected_ms;
+  PartFunction solve;
+};
+
+// clang-format off
+const std::vector<Part> PARTS = {
+    {1, 1, 0.1, d01::part_1},    {1, 2, 0.2, d01::part_2},
+    {2, 1, 0.1, d02::part_1},    {2, 2, 0.3, d02::part_2},
+    {3, 1, 0.1, d03::part_1},    {3, 2, 0.3, d03::part_2},
+    {4, 1, 0.7, d04::part_1},    {4, 2, 0.2, d04::part_2},
+    {5, 1, 1.1, d05::part_1},    {5, 2, 2.6, d05::part_2},
+    {6, 1, 0.1, d06::part_1},    {6, 2, 2.3, d06::part_2},
+    {7, 1, 1.0, d07::part_1},    {7, 2, 33.4, d07::part_2},
+    {8, 1, 0.2, d08::part_1},    {8, 2, 0.6, d08::part_2},
+    {9, 1, 1.2, d09::part_1},    {9, 2, 24.4, d09::part_2},
+    {10, 1, 0.1, d10::part_1},   {10, 2, 0.1, d10::part_2},
+    {11, 1, 1.5, d11::part_1},   {11, 2, 47.1, d11::part_2},
+    {12, 1, 2.3, d12::part_1},   {12, 2, 4.0, d12::part_2},
+    {13, 1, 0.1, d13::part_1},   {13, 2, 0.1, d13::part_2},
+    {14, 1, 0.2, d14::part_1},   {14, 2, 2.3, d14::part_2},
+    {15, 1, 0.1, d15::part_1},   {15, 2, 0.2, d15::part_2},
+    {16, 1, 0.8, d16::part_1},   {16, 2, 0.7, d16::part_2},
+    {17, 1, 0.1, d17::part_1},   {17, 2, 0.3, d17::part_2},
+    {18, 1, 0.2, d18::part_1},   {18, 2, 4.7, d18::part_2},
+    {19, 1, 1.7, d19::part_1},   {19, 2, 1.7, d19::part_2},
+    {20, 1, 0.1, d20::part_1},   {20, 2, 10.1, d20::part_2},
+    {21, 1, 0.1, d21::part_1},   {21, 2, 0.3, d21::part_2},
+    {22, 1, 0.4, d22::part_1},   {22, 2, 1234.4, d22::part_2},
+    {23, 1, 9.1, d23::part_1},   {23, 2, 2.6, d23::part_2},
+    {24, 1, 0.4, d24::part_1},   {24, 2, 0.1, d24::part_2},
+    {25, 1, 0.4, d25::part_1},   {25, 2, 0.1, d25::part_2},
+};
+// clang-format on
+
+struct Task {
+  const Part *part;
+  std::string filepath;
+  // Only set when there is a cache to check
+  const AnswerCache *cache;
+  AnswerKey key;
+};
+
+struct Result {
+  std::string answer;
+  double wall_ms{};
+  double cpu_ms{};
+  bool failed{};
+  bool cached{};
+};
+
+double to_ms(const timespec &time) {
+  return time.tv_sec * 1e3 + time.tv_nsec / 1e6;
+}
+
+// CPU time spent by the calling thread only, so that parts running alongside
+// each other are not charged for one another
+double thread_cpu_ms() {
+  timespec time{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return to_ms(time);
+}
+
+Result run_task(const Task &task) {
+  Result result;
+  const auto wall_start = std::chrono::steady_clock::now();
+  const double cpu_start = thread_cpu_ms();
+  const auto cached =
+      task.cache ? task.cache->find(task.key, task.part->part) : std::nullopt;
+  if (cached) {
+    result.answer = *cached;
+    result.cached = true;
+  } else {
+    try {
+      result.answer = task.part->solve(task.filepath);
+      if (task.cache) {
+        task.cache->store(task.key, task.part->part, result.answer);
+      }
+    } catch (const std::exception &error) {
+      result.answer = std::string("error: ") + error.what();
+      result.failed = true;
+    }
+  }
+  result.cpu_ms = thread_cpu_ms() - cpu_start;
+  result.wall_ms = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - wall_start)
+                       .count();
+  return result;
+}
+
+// Workers pull the next task off a shared counter, so a thread that finishes a
+// short part early just moves on to the next one in line
+std::vector<Result> run_tasks(const std::vector<Task> &tasks,
+                              const size_t num_threads) {
+  std::vector<Result> results(tasks.size());
+  std::atomic<size_t> next_task{};
+  auto worker = [&]() {
+    for (size_t index = next_task++; index < tasks.size();
+         index = next_task++) {
+      results[index] = run_task(tasks[index]);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < std::min(num_threads, tasks.size());
+       ++index) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+std::string day_name(const int day) {
+  return std::string(day < 10 ? "d0" : "d") + std::to_string(day);
+}
+
+void print_table(std::ostream &out, const std::vector<Task> &tasks,
+                 const std::vector<Result> &results) {
+  // Indexed by day then part, pointing back into the results
+  std::vector<std::vector<const Result *>> by_day(
+      PARTS.back().day + 1, std::vector<const Result *>(3, nullptr));
+  for (size_t index = 0; index < tasks.size(); ++index) {
+    by_day[tasks[index].part->day][tasks[index].part->part] = &results[index];
+  }
+
+  out << std::fixed << std::setprecision(2);
+  out << std::left << std::setw(6) << "day" << std::right << std::setw(12)
+      << "part 1 ms" << std::setw(12) << "part 2 ms"
+      << "  answers" << std::endl;
+  for (size_t day = 1; day < by_day.size(); ++day) {
+    const auto *part_1 = by_day[day][1];
+    const auto *part_2 = by_day[day][2];
+    if (part_1 == nullptr || part_2 == nullptr) {
+      continue;
+    }
+    out << std::left << std::setw(6) << day_name(day) << std::right
+        << std::setw(12) << part_1->wall_ms << std::setw(12) << part_2->wall_ms
+        << "  " << part_1->answer << " / " << part_2->answer << std::endl;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << std::endl;
+    return -1;
+  }
+
+  std::optional<AnswerCache> cache;
+  if (options.cache) {
+    cache = AnswerCache::from_environment();
+  }
+
+  std::vector<Task> tasks;
+  std::vector<std::string> filepaths;
+  for (const auto &part : PARTS) {
+    if (!options.days.empty() && !options.days.contains(part.day)) {
+      continue;
+    }
+    const std::string name = day_name(part.day);
+    const std::string filepath = options.input_root + "/" + name + "/input.txt";
+    if (!std::filesystem::exists(filepath)) {
+      if (part.part == 1) {
+        std::cerr << "Skipping " << name << ", no " << filepath << std::endl;
+      }
+      continue;
+    }
+    if (part.part == 1) {
+      filepaths.push_back(filepath);
+    }
+    tasks.push_back({&part, filepath, nullptr, {}});
+  }
+
+  // Every input is read at once, up front, for the cache keys. This also
+  // leaves them all in the page cache for the parts, which map their own, so
+  // none of them waits on storage.
+  std::map<std::string, uint64_t> input_hashes;
+  {
+    InputPrefetcher prefetcher(filepaths);
+    while (auto loaded = prefetcher.next()) {
+      if (loaded->input) {
+        input_hashes[loaded->filepath] = hash_bytes(loaded->input->data());
+      }
+    }
+  }
+
+  if (cache) {
+    for (auto &task : tasks) {
+      const std::string name = day_name(task.part->day);
+      const RegisteredDay *day = find_registered_day(name);
+      if (day == nullptr) {
+        throw std::runtime_error("No registration for " + name);
+      }
+      // An input that could not be read fails in the part instead
+      const auto hash = input_hashes.find(task.filepath);
+      if (hash != input_hashes.end()) {
+        task.cache = &*cache;
+        task.key = AnswerKey{name, day->build_id, hash->second};
+      }
+    }
+  }
+
+  std::sort(tasks.begin(), tasks.end(), [](const Task &lhs, const Task &rhs) {
+    return lhs.part->expected_ms > rhs.part->expected_ms;
+  });
+
+  std::ostream out(std::cout.rdbuf());
+  NullBuffer null_buffer;
+  std::cout.rdbuf(&null_buffer);
+
+  const auto wall_start = std::chrono::steady_clock::now();
+  const auto results = run_tasks(tasks, options.threads);
+  const double wall_ms = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - wall_start)
+                             .count();
+
+  std::cout.rdbuf(out.rdbuf());
+
+  print_table(out, tasks, results);
+
+  double cpu_ms{};
+  bool any_failed{};
+  size_t num_cached{};
+  for (const auto &result : results) {
+    cpu_ms += result.cpu_ms;
+    any_failed = any_failed || result.failed;
+    num_cached += size_t(result.cached);
+  }
+  out << std::endl
+      << "wall " << wall_ms << " ms, summed cpu " << cpu_ms << " ms over "
+      << std::min(options.threads, tasks.size()) << " threads" << std::endl;
+  if (cache) {
+    out << num_cached << " of " << results.size() << " parts from the cache"
+        << std::endl;
+  }
+
+  return any_failed ? 1 : 0;
+}
@@ -0,0 +1,369 @@
+#include <algorithm>              // for sort
+#include <allocation_counter.hpp> // for AllocationCounter, AllocationStats
+#include <chrono>                 // for duration, steady_clock
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint64_t
+#include <d01.hpp>                // for Solution
+#include <d02.hpp>                // for Solution
+#include <d03.hpp>                // for Solution
+#include <d04.hpp>                // for Solution
+#include <d05.hpp>                // for Solution
+#include <d06.hpp>                // for Solution
+#include <d07.hpp>                // for Solution
+#include <d08.hpp>                // for Solution
+#include <d09.hpp>                // for Solution
+#include <d10.hpp>                // for Solution
+#include <d11.hpp>                // for Solution
+#include <d12.hpp>                // for Solution
+#include <d13.hpp>                // for Solution
+#include <d14.hpp>                // for Solution
+#include <d15.hpp>                // for Solution
+#include <d16.hpp>                // for Solution
+#include <d17.hpp>                // for Solution
+#include <d18.hpp>                // for Solution
+#include <d19.hpp>                // for Solution
+#include <d20.hpp>                // for Solution
+#include <d21.hpp>                // for Solution
+#include <d22.hpp>                // for Solution
+#include <d23.hpp>                // for Solution
+#include <d24.hpp>                // for Solution
+#include <d25.hpp>                // for Solution
+#include <filesystem>             // for exists
+#include <functional>             // for function
+#include <input_view.hpp>         // for InputView
+#include <iostream>               // for basic_ostream, operator<<, endl, cer...
+#include <null_buffer.hpp>        // for NullBuffer
+#include <optional>               // for optional, nullopt
+#include <ostream>                // for ostream
+#include <perf_counters.hpp>      // for PerfCounters
+#include <set>                    // for set
+#include <solver.hpp>             // for Solver
+#include <stdexcept>              // for runtime_error
+#include <string>                 // for string, stoul, operator+, to_string
+#include <vector>                 // for vector
+
+// Times every day on its input, in separate phases: loading the file into an
+// InputView, parsing it, then each part on the already parsed input. Every
+// phase is run a number of times after a few warmup runs. Results go to stdout
+// as CSV or JSON so runs from different commits can be diffed.
+//
+// Usage: aoc-bench [--iterations N] [--warmup N] [--format csv|json]
+//                  [--day N]... [--input-root DIR] [--counters]
+//
+// The input for day NN is read from DIR/dNN/input.txt, DIR defaulting to the
+// top of the source tree. Days without an input file are skipped.
+//
+// --counters also reads hardware performance counters over the timed runs of
+// every phase, and adds cycles and instructions per run, IPC and miss rates to
+// the results. Whatever the system cannot count is left empty.
+//
+// A build with AOC_COUNT_ALLOCATIONS on also adds the allocations and bytes
+// allocated per run, the most bytes live at once in any run, and the peak
+// resident set of the process as of the end of each phase.
+
+struct Options {
+  size_t iterations = 10;
+  size_t warmup = 2;
+  bool json = false;
+  std::set<int> days;
+  std::string input_root = AOC_TOP_DIR;
+  bool counters = false;
+};
+
+struct Stats {
+  std::string day;
+  std::string phase;
+  size_t iterations;
+  double min_ns;
+  double median_ns;
+  double p99_ns;
+  // Summed over the timed runs, then divided by their number
+  PerfCounters::Readings counters;
+  // Allocations and bytes per run, but the peak over all of them
+  AllocationStats allocations;
+  uint64_t peak_rss_bytes;
+};
+
+Options parse_options(int argc, char *argv[]) {
+  Options options;
+  for (int index = 1; index < argc; ++index) {
+    const std::string arg = argv[index];
+    if (arg == "--counters") {
+      options.counters = true;
+      continue;
+    }
+    if (index + 1 >= argc) {
+      throw std::runtime_error("Missing value for " + arg);
+    }
+    const std::string value = argv[++index];
+    if (arg == "--iterations") {
+      options.iterations = std::stoul(value);
+    } else if (arg == "--warmup") {
+      options.warmup = std::stoul(value);
+    } else if (arg == "--format") {
+      if (value != "csv" && value != "json") {
+        throw std::runtime_error("Unknown format: " + value);
+      }
+      options.json = value == "json";
+    } else if (arg == "--day") {
+      options.days.insert(std::stoi(value));
+    } else if (arg == "--input-root") {
+      options.input_root = value;
+    } else {
+      throw std::runtime_error("Unknown option: " + arg);
+    }
+  }
+  if (options.iterations == 0) {
+    throw std::runtime_error("Need at least one iteration");
+  }
+  return options;
+}
+
+// Nearest rank percentile over sorted samples
+double percentile(const std::vector<double> &sorted_samples,
+                  const size_t percent) {
+  const size_t rank = (percent * sorted_samples.size() + 99) / 100;
+  return sorted_samples[rank == 0 ? 0 : rank - 1];
+}
+
+Stats measure(const std::string &day, const std::string &phase,
+              const Options &options, PerfCounters *counters,
+              const std::function<void()> &run) {
+  for (size_t index = 0; index < options.warmup; ++index) {
+    run();
+  }
+
+  std::vector<double> samples;
+  samples.reserve(options.iterations);
+  AllocationCounter allocation_counter;
+  if (counters != nullptr) {
+    counters->start();
+  }
+  for (size_t index = 0; index < options.iterations; ++index) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    const auto stop = std::chrono::steady_clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  auto readings =
+      counters != nullptr ? counters->stop() : PerfCounters::Readings{};
+  for (auto &value : readings.m_values) {
+    value /= options.iterations;
+  }
+  auto allocations = allocation_counter.stop();
+  allocations.m_allocations /= options.iterations;
+  allocations.m_bytes /= options.iterations;
+
+  std::sort(samples.begin(), samples.end());
+  return {day,
+          phase,
+          options.iterations,
+          samples.front(),
+          percentile(samples, 50),
+          percentile(samples, 99),
+          readings,
+          allocations,
+          peak_rss_bytes()};
+}
+
+template <Solver Solution>
+void bench_day(const std::string &name, const std::string &filepath,
+               const Options &options, PerfCounters *counters,
+               std::vector<Stats> &results) {
+  // Keep the answers alive so that the calls cannot be optimized out
+  std::string answer;
+
+  results.push_back(measure(name, "load", options, counters, [&]() {
+    const InputView input(filepath);
+    answer = std::to_string(input.lines().size());
+  }));
+
+  const InputView input(filepath);
+
+  // Includes tearing the parsed input back down
+  results.push_back(measure(name, "parse", options, counters, [&]() {
+    [[maybe_unused]] const auto parsed = Solution::parse(input);
+  }));
+
+  const auto parsed = Solution::parse(input);
+
+  results.push_back(measure(name, "part_1", options, counters, [&]() {
+    answer = Solution::solve_part_1(parsed);
+  }));
+  results.push_back(measure(name, "part_2", options, counters, [&]() {
+    answer = Solution::solve_part_2(parsed);
+  }));
+}
+
+using BenchFunction = void (*)(const std::string &, const std::string &,
+                               const Options &, PerfCounters *,
+                               std::vector<Stats> &);
+
+struct Day {
+  int number;
+  BenchFunction bench;
+};
+
+const std::vector<Day> DAYS = {
+    {1, bench_day<d01::Solution>},  {2, bench_day<d02::Solution>},
+    {3, bench_day<d03::Solution>},  {4, bench_day<d04::Solution>},
+    {5, bench_day<d05::Solution>},  {6, bench_day<d06::Solution>},
+    {7, bench_day<d07::Solution>},  {8, bench_day<d08::Solution>},
+    {9, bench_day<d09::Solution>},  {10, bench_day<d10::Solution>},
+    {11, bench_day<d11::Solution>}, {12, bench_day<d12::Solution>},
+    {13, bench_day<d13::Solution>}, {14, bench_day<d14::Solution>},
+    {15, bench_day<d15::Solution>}, {16, bench_day<d16::Solution>},
+    {17, bench_day<d17::Solution>}, {18, bench_day<d18::Solution>},
+    {19, bench_day<d19::Solution>}, {20, bench_day<d20::Solution>},
+    {21, bench_day<d21::Solution>}, {22, bench_day<d22::Solution>},
+    {23, bench_day<d23::Solution>}, {24, bench_day<d24::Solution>},
+    {25, bench_day<d25::Solution>},
+};
+
+const std::vector<std::string> COUNTER_COLUMNS = {
+    "cycles",   "instructions", "ipc",
+    "l1d_mpki", "llc_mpki",     "branch_miss_pct"};
+
+// In the order of COUNTER_COLUMNS, empty for whatever was not counted
+std::vector<std::optional<double>>
+counter_values(const PerfCounters::Readings &readings) {
+  const auto count = [&](const PerfCounters::Event event) {
+    return readings.m_has_value[event]
+               ? std::optional<double>(readings.m_values[event])
+               : std::nullopt;
+  };
+  return {count(PerfCounters::CYCLES),
+          count(PerfCounters::INSTRUCTIONS),
+          readings.instructions_per_cycle(),
+          readings.misses_per_kilo_instruction(PerfCounters::L1D_MISSES),
+          readings.misses_per_kilo_instruction(PerfCounters::LLC_MISSES),
+          readings.branch_miss_percent()};
+}
+
+const std::vector<std::string> ALLOCATION_COLUMNS = {
+    "allocations", "allocated_bytes", "peak_live_bytes", "peak_rss_bytes"};
+
+// In the order of ALLOCATION_COLUMNS
+std::vector<uint64_t> allocation_values(const Stats &stats) {
+  return {stats.allocations.m_allocations, stats.allocations.m_bytes,
+          stats.allocations.m_peak_live_bytes, stats.peak_rss_bytes};
+}
+
+void print_csv(std::ostream &out, const std::vector<Stats> &results,
+               const bool with_counters) {
+  out << "day,phase,iterations,min_ns,median_ns,p99_ns";
+  if (with_counters) {
+    for (const auto &column : COUNTER_COLUMNS) {
+      out << "," << column;
+    }
+  }
+  if constexpr (ALLOCATION_COUNTING) {
+    for (const auto &column : ALLOCATION_COLUMNS) {
+      out << "," << column;
+    }
+  }
+  out << std::endl;
+  for (const auto &stats : results) {
+    out << stats.day << "," << stats.phase << "," << stats.iterations << ","
+        << static_cast<long long>(stats.min_ns) << ","
+        << static_cast<long long>(stats.median_ns) << ","
+        << static_cast<long long>(stats.p99_ns);
+    if (with_counters) {
+      for (const auto &value : counter_values(stats.counters)) {
+        out << ",";
+        if (value) {
+          out << *value;
+        }
+      }
+    }
+    if constexpr (ALLOCATION_COUNTING) {
+      for (const auto value : allocation_values(stats)) {
+        out << "," << value;
+      }
+    }
+    out << std::endl;
+  }
+}
+
+void print_json(std::ostream &out, const std::vector<Stats> &results,
+                const bool with_counters) {
+  out << "[" << std::endl;
+  for (size_t index = 0; index < results.size(); ++index) {
+    const auto &stats = results[index];
+    out << "  {\"day\": \"" << stats.day << "\", \"phase\": \""
+        << stats.phase << "\", \"iterations\": " << stats.iterations
+        << ", \"min_ns\": " << static_cast<long long>(stats.min_ns)
+        << ", \"median_ns\": " << static_cast<long long>(stats.median_ns)
+        << ", \"p99_ns\": " << static_cast<long long>(stats.p99_ns);
+    if (with_counters) {
+      const auto values = counter_values(stats.counters);
+      for (size_t column = 0; column < COUNTER_COLUMNS.size(); ++column) {
+        out << ", \"" << COUNTER_COLUMNS[column] << "\": ";
+        if (values[column]) {
+          out << *values[column];
+        } else {
+          out << "null";
+        }
+      }
+    }
+    if constexpr (ALLOCATION_COUNTING) {
+      const auto values = allocation_values(stats);
+      for (size_t column = 0; column < ALLOCATION_COLUMNS.size(); ++column) {
+        out << ", \"" << ALLOCATION_COLUMNS[column] << "\": " << values[column];
+      }
+    }
+    out << "}" << (index + 1 < results.size() ? "," : "") << std::endl;
+  }
+  out << "]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << std::endl;
+    return -1;
+  }
+
+  std::optional<PerfCounters> counters;
+  if (options.counters) {
+    counters.emplace();
+    if (!counters->status().empty()) {
+      std::cerr << counters->status() << std::endl;
+    }
+  }
+
+  std::ostream out(std::cout.rdbuf());
+  NullBuffer null_buffer;
+  std::cout.rdbuf(&null_buffer);
+
+  std::vector<Stats> results;
+  for (const auto &day : DAYS) {
+    if (!options.days.empty() && !options.days.contains(day.number)) {
+      continue;
+    }
+
+    const std::string name =
+        std::string(day.number < 10 ? "d0" : "d") + std::to_string(day.number);
+    const std::string filepath = options.input_root + "/" + name + "/input.txt";
+    if (!std::filesystem::exists(filepath)) {
+      std::cerr << "Skipping " << name << ", no " << filepath << std::endl;
+      continue;
+    }
+
+    day.bench(name, filepath, options, counters ? &*counters : nullptr,
+              results);
+  }
+
+  std::cout.rdbuf(out.rdbuf());
+
+  if (options.json) {
+    print_json(out, results, options.counters);
+  } else {
+    print_csv(out, results, options.counters);
+  }
+
+  return 0;
+}
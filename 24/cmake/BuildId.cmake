@@ -0,0 +1,24 @@
+# Writes OUTPUT, a header defining AOC_DAY_BUILD_ID as a hash of a day's built
+# library and of core, which together decide every answer the day gives. Run
+# with cmake -P after both are built:
+#
+#   cmake -DDAY_LIBRARY=... -DCORE_LIBRARY=... -DOUTPUT=... -P BuildId.cmake
+#
+# The header is only rewritten when the hash changes, so relinking without
+# changing anything does not rebuild what includes it.
+
+file(SHA256 ${DAY_LIBRARY} day_hash)
+file(SHA256 ${CORE_LIBRARY} core_hash)
+string(SHA256 build_hash "${day_hash}${core_hash}")
+string(SUBSTRING ${build_hash} 0 16 build_id)
+
+set(contents "#pragma once\n\n#define AOC_DAY_BUILD_ID \"${build_id}\"\n")
+
+if (EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} old_contents)
+  if (old_contents STREQUAL contents)
+    return()
+  endif()
+endif()
+
+file(WRITE ${OUTPUT} ${contents})
@@ -0,0 +1,127 @@
+# Selects how every target is compiled. Timings are only meaningful from one of
+# the optimized profiles, since the default keeps AddressSanitizer on.
+#
+#   Sanitize     AddressSanitizer, no optimization (the default)
+#   Release      -O3, link-time optimization and -march=native
+#   PGOGenerate  Release, instrumented to record a profile when run
+#   PGOUse       Release, optimized with the profile recorded by PGOGenerate
+#
+# The PGO pipeline is driven end to end by cmake/PGOPipeline.cmake.
+
+set(AOC_BUILD_PROFILE "Sanitize" CACHE STRING "Build profile for all targets")
+set_property(CACHE AOC_BUILD_PROFILE
+  PROPERTY STRINGS Sanitize Release PGOGenerate PGOUse)
+
+option(AOC_NATIVE_ARCH "Tune optimized profiles for the building machine" ON)
+
+set(AOC_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH
+  "Where PGOGenerate writes, and PGOUse reads, profile data")
+
+set(AOC_PGO_PROFDATA "${AOC_PGO_DIR}/default.profdata")
+
+message(STATUS "Build profile: ${AOC_BUILD_PROFILE}")
+
+if (AOC_BUILD_PROFILE STREQUAL "Sanitize")
+
+  add_compile_options(-fsanitize=address -fno-omit-frame-pointer)
+  add_link_options(-fsanitize=address)
+
+elseif (AOC_BUILD_PROFILE MATCHES "^(Release|PGOGenerate|PGOUse)$")
+
+  add_compile_options(-O3 -DNDEBUG)
+
+  if (AOC_NATIVE_ARCH)
+    add_compile_options(-march=native)
+  endif()
+
+  include(CheckIPOSupported)
+  check_ipo_supported(RESULT aoc_ipo_supported OUTPUT aoc_ipo_output LANGUAGES CXX)
+  if (aoc_ipo_supported)
+    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+  else()
+    message(WARNING "Link-time optimization unavailable: ${aoc_ipo_output}")
+  endif()
+
+else()
+
+  message(FATAL_ERROR "Unknown AOC_BUILD_PROFILE: ${AOC_BUILD_PROFILE}")
+
+endif()
+
+if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+  set(aoc_pgo_is_clang ON)
+else()
+  set(aoc_pgo_is_clang OFF)
+endif()
+
+if (AOC_BUILD_PROFILE STREQUAL "PGOGenerate")
+
+  file(MAKE_DIRECTORY ${AOC_PGO_DIR})
+  if (aoc_pgo_is_clang)
+    add_compile_options(-fprofile-instr-generate=${AOC_PGO_DIR}/%m.profraw)
+    add_link_options(-fprofile-instr-generate=${AOC_PGO_DIR}/%m.profraw)
+  else()
+    add_compile_options(-fprofile-generate=${AOC_PGO_DIR})
+    add_link_options(-fprofile-generate=${AOC_PGO_DIR})
+  endif()
+
+elseif (AOC_BUILD_PROFILE STREQUAL "PGOUse")
+
+  if (aoc_pgo_is_clang)
+    if (NOT EXISTS ${AOC_PGO_PROFDATA})
+      message(FATAL_ERROR "No merged profile at ${AOC_PGO_PROFDATA}, "
+        "build and run pgo-train with AOC_BUILD_PROFILE=PGOGenerate first")
+    endif()
+    add_compile_options(-fprofile-instr-use=${AOC_PGO_PROFDATA})
+  else()
+    # Days without an input.txt to train on simply have no profile
+    add_compile_options(-fprofile-use=${AOC_PGO_DIR} -fprofile-partial-training
+      -Wno-missing-profile)
+  endif()
+
+endif()
+
+# Runs every day on its own input.txt to record a profile, merging the raw
+# profiles when the compiler needs it. Each make_my_day adds its day to this.
+if (AOC_BUILD_PROFILE STREQUAL "PGOGenerate")
+
+  add_custom_target(pgo-train ALL)
+
+  if (aoc_pgo_is_clang)
+    if (APPLE)
+      set(aoc_llvm_profdata xcrun llvm-profdata)
+    else()
+      find_program(aoc_llvm_profdata_path NAMES llvm-profdata REQUIRED)
+      set(aoc_llvm_profdata ${aoc_llvm_profdata_path})
+    endif()
+    add_custom_command(TARGET pgo-train POST_BUILD
+      COMMAND ${CMAKE_COMMAND}
+              -DAOC_PGO_DIR=${AOC_PGO_DIR}
+              -DAOC_PGO_PROFDATA=${AOC_PGO_PROFDATA}
+              "-DAOC_LLVM_PROFDATA=${aoc_llvm_profdata}"
+              -P ${CMAKE_CURRENT_LIST_DIR}/PGOMerge.cmake
+      COMMENT "Merging PGO profiles into ${AOC_PGO_PROFDATA}"
+      VERBATIM)
+  endif()
+
+endif()
+
+function(add_pgo_training day_target input_file)
+  if (NOT AOC_BUILD_PROFILE STREQUAL "PGOGenerate")
+    return()
+  endif()
+  if (NOT EXISTS ${input_file})
+    message(STATUS "No ${input_file}, ${day_target} will not be trained")
+    return()
+  endif()
+
+  # Past the AnswerCache, which would otherwise answer every run after the
+  # first without the solver running to be profiled
+  add_custom_target(${day_target}-pgo-train
+    COMMAND $<TARGET_FILE:${day_target}> --no-cache ${input_file}
+    DEPENDS ${day_target}
+    COMMENT "Training ${day_target} on ${input_file}"
+    VERBATIM)
+
+  add_dependencies(pgo-train ${day_target}-pgo-train)
+endfunction()
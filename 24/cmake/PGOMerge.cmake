@@ -0,0 +1,14 @@
+# Merges the raw clang profiles written by a PGOGenerate build into the single
+# file PGOUse reads. Run by the pgo-train target.
+#
+#   cmake -DAOC_PGO_DIR=... -DAOC_PGO_PROFDATA=... -DAOC_LLVM_PROFDATA=... -P
+
+file(GLOB aoc_raw_profiles "${AOC_PGO_DIR}/*.profraw")
+
+if (NOT aoc_raw_profiles)
+  message(FATAL_ERROR "No raw profiles in ${AOC_PGO_DIR}, did training run?")
+endif()
+
+execute_process(
+  COMMAND ${AOC_LLVM_PROFDATA} merge -output=${AOC_PGO_PROFDATA} ${aoc_raw_profiles}
+  COMMAND_ERROR_IS_FATAL ANY)
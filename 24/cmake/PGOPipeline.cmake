@@ -0,0 +1,41 @@
+# Builds the whole tree instrumented, trains every day on its input.txt and
+# then rebuilds the same tree optimized with the recorded profile.
+#
+# Usage, from the directory holding the top-level CMakeLists.txt:
+#
+#   cmake -DAOC_BINARY_DIR=_pgo_build -P cmake/PGOPipeline.cmake
+#
+# The same build directory is used for both passes so that the compiler can
+# match each object file to its profile.
+
+if (NOT DEFINED AOC_SOURCE_DIR)
+  get_filename_component(AOC_SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+endif()
+
+if (NOT DEFINED AOC_BINARY_DIR)
+  set(AOC_BINARY_DIR "${AOC_SOURCE_DIR}/_pgo_build")
+endif()
+
+include(ProcessorCount)
+ProcessorCount(aoc_jobs)
+if (aoc_jobs EQUAL 0)
+  set(aoc_jobs 1)
+endif()
+
+function(aoc_run)
+  execute_process(COMMAND ${ARGV} COMMAND_ERROR_IS_FATAL ANY)
+endfunction()
+
+message(STATUS "PGO: building instrumented tree in ${AOC_BINARY_DIR}")
+file(REMOVE_RECURSE "${AOC_BINARY_DIR}/pgo")
+aoc_run(${CMAKE_COMMAND} -S ${AOC_SOURCE_DIR} -B ${AOC_BINARY_DIR}
+  -DAOC_BUILD_PROFILE=PGOGenerate)
+
+# Building the default target includes pgo-train, which runs every day
+message(STATUS "PGO: training")
+aoc_run(${CMAKE_COMMAND} --build ${AOC_BINARY_DIR} -j ${aoc_jobs})
+
+message(STATUS "PGO: rebuilding with the recorded profile")
+aoc_run(${CMAKE_COMMAND} -S ${AOC_SOURCE_DIR} -B ${AOC_BINARY_DIR}
+  -DAOC_BUILD_PROFILE=PGOUse)
+aoc_run(${CMAKE_COMMAND} --build ${AOC_BINARY_DIR} -j ${aoc_jobs} --clean-first)
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint> // for uint64_t, int64_t
+#include <string>  // for string
+
+// Counts heap allocations made through operator new by the calling thread.
+//
+// Counting is opt in: only a build configured with -DAOC_COUNT_ALLOCATIONS=ON
+// replaces the global operator new and delete with versions that keep the
+// counts. Otherwise every count reads as zero and nothing costs anything.
+//
+// Counts are kept per thread, so parts solved side by side do not mix. Memory
+// freed by a different thread than allocated it is taken off the live bytes of
+// the freeing thread.
+
+#ifdef AOC_COUNT_ALLOCATIONS
+constexpr bool ALLOCATION_COUNTING = true;
+#else
+constexpr bool ALLOCATION_COUNTING = false;
+#endif
+
+struct AllocationStats {
+  uint64_t m_allocations{};
+  uint64_t m_bytes{};
+  // Most bytes live at once, over what was live when counting started
+  uint64_t m_peak_live_bytes{};
+
+  // One line of the counts, in human units
+  std::string summary() const;
+};
+
+// Counts from construction until stop. Counters can be nested, each one seeing
+// its own peak.
+class AllocationCounter {
+public:
+  AllocationCounter();
+
+  AllocationCounter(const AllocationCounter &) = delete;
+  AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+  AllocationStats stop();
+
+private:
+  uint64_t m_start_allocations{};
+  uint64_t m_start_bytes{};
+  int64_t m_start_live_bytes{};
+  // The peak an enclosing counter had seen, to put back on stop
+  int64_t m_outer_peak_live_bytes{};
+};
+
+// Bytes in B, KiB or MiB, whichever reads best
+std::string format_bytes(const uint64_t bytes);
+
+// High water mark of the resident set of the whole process so far, from
+// getrusage. Works whether or not allocations are counted.
+uint64_t peak_rss_bytes();
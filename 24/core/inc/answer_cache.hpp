@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>     // for uint64_t
+#include <filesystem>  // for path
+#include <optional>    // for optional
+#include <string>      // for string
+#include <string_view> // for string_view
+
+// A fast 64 bit hash of the bytes, the same on every run and machine, for
+// telling inputs apart. Not meant to stand up to anyone crafting collisions.
+uint64_t hash_bytes(const std::string_view bytes);
+
+// What an answer was worked out from: the build of the day's code, and the
+// input it was run on
+struct AnswerKey {
+  std::string day_id;
+  // From the registry, a hash of the built dNN-lib and core
+  std::string build_id;
+  uint64_t input_hash;
+};
+
+// Answers already worked out, kept on disk so that running a day again on an
+// input it has already solved, with the same build, is a file read. One file
+// per part, at DIR/dNN/<build id>/<input hash>.partN.
+//
+// Opt in by setting AOC_CACHE_DIR to the directory to keep them in. The driver,
+// aoc-all and the tests all check it first unless given --no-cache.
+class AnswerCache {
+public:
+  explicit AnswerCache(std::filesystem::path directory);
+
+  // From AOC_CACHE_DIR, or nullopt when that is not set
+  static std::optional<AnswerCache> from_environment();
+
+  std::optional<std::string> find(const AnswerKey &key, const int part) const;
+
+  // Written to a file of its own then renamed into place, so that runs side by
+  // side never read half an answer. A cache that cannot be written to only
+  // costs solving again next time, so failures are ignored.
+  void store(const AnswerKey &key, const int part,
+             const std::string &answer) const;
+
+private:
+  std::filesystem::path path_of(const AnswerKey &key, const int part) const;
+
+  std::filesystem::path m_directory;
+};
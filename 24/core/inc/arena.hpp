@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>         // for size_t, byte
+#include <memory_resource> // for monotonic_buffer_resource, memory_resource
+
+// Memory for the short lived containers of a single solve. Everything is handed
+// out from one buffer by bumping a pointer, and nothing is given back until the
+// whole arena is released or destroyed, which is a single step however many
+// allocations were made. When the buffer runs out, further blocks come from the
+// heap and are freed along with the arena.
+//
+// Containers opt in by being the std::pmr variant and taking resource() at
+// construction. Copying a pmr container does not carry the arena over, so
+// results leaving a function should be moved rather than copied.
+//
+// Not thread safe: one arena per solve, and so per thread.
+class Arena {
+public:
+  enum class Backing {
+    // A plain heap allocation
+    Heap,
+    // An anonymous mapping backed by huge pages where the system allows it,
+    // which saves TLB misses when the arena gets large
+    HugePages,
+  };
+
+  static constexpr size_t DEFAULT_CAPACITY = size_t(1) << 20;
+
+#ifdef AOC_ARENA_HUGE_PAGES
+  static constexpr Backing DEFAULT_BACKING = Backing::HugePages;
+#else
+  static constexpr Backing DEFAULT_BACKING = Backing::Heap;
+#endif
+
+  explicit Arena(const size_t capacity = DEFAULT_CAPACITY,
+                 const Backing backing = DEFAULT_BACKING);
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  ~Arena();
+
+  std::pmr::memory_resource *resource() {
+    return &m_resource;
+  }
+
+  // Frees everything allocated so far in one go, going back to the start of
+  // the buffer. Containers still using the arena must already be empty.
+  void release() {
+    m_resource.release();
+  }
+
+private:
+  size_t m_capacity;
+  Backing m_backing;
+  std::byte *m_buffer;
+  std::pmr::monotonic_buffer_resource m_resource;
+};
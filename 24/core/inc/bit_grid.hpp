@@ -0,0 +1,124 @@
+#pragma once
+
+#include <bit>          // for countr_zero
+#include <core_lib.hpp> // for Position, FlatOffset
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <vector>       // for vector
+
+// A grid of booleans at one bit per cell, for visited and obstacle sets that
+// would otherwise be a std::set of positions. Each row starts on a fresh 64 bit
+// word, so whole rows can be combined and shifted a word at a time.
+//
+// The cells of a FlatGrid are best kept in a single row as wide as its buffer,
+// indexed by FlatIndex, or one such row per heading where the heading matters
+// too.
+//
+// Bits past the width of a row are always kept clear, so that they never show
+// up in count or for_each_set.
+class BitGrid {
+public:
+  using Word = uint64_t;
+
+  static constexpr size_t WORD_BITS = 64;
+
+  BitGrid() = default;
+
+  BitGrid(const size_t height, const size_t width);
+
+  size_t height() const {
+    return m_height;
+  }
+
+  size_t width() const {
+    return m_width;
+  }
+
+  bool test(const size_t row, const size_t col) const {
+    return (word(row, col) >> (col % WORD_BITS)) & 1;
+  }
+
+  void set(const size_t row, const size_t col) {
+    word(row, col) |= Word(1) << (col % WORD_BITS);
+  }
+
+  void reset(const size_t row, const size_t col) {
+    word(row, col) &= ~(Word(1) << (col % WORD_BITS));
+  }
+
+  // Sets the cell, returning whether it already was
+  bool test_and_set(const size_t row, const size_t col) {
+    const Word mask = Word(1) << (col % WORD_BITS);
+    Word &cell_word = word(row, col);
+    const bool was_set = (cell_word & mask) != 0;
+    cell_word |= mask;
+    return was_set;
+  }
+
+  bool test(const Position &position) const {
+    return test(size_t(position.first), size_t(position.second));
+  }
+
+  void set(const Position &position) {
+    set(size_t(position.first), size_t(position.second));
+  }
+
+  // Number of cells set
+  size_t count() const;
+
+  bool none() const;
+
+  void clear();
+
+  // Both grids have to be the same size
+  BitGrid &operator|=(const BitGrid &other);
+  BitGrid &operator&=(const BitGrid &other);
+
+  // Row row of this grid combined with row other_row of other, which has to be
+  // as wide
+  void or_row(const size_t row, const BitGrid &other, const size_t other_row);
+  void and_row(const size_t row, const BitGrid &other, const size_t other_row);
+
+  // Moves every cell offset columns east (towards higher columns), or west if
+  // negative. Cells moved past either end of their row are dropped.
+  void shift_columns(const FlatOffset offset);
+
+  // Moves every row offset rows south (towards higher rows), or north if
+  // negative, filling in with empty rows
+  void shift_rows(const FlatOffset offset);
+
+  bool operator==(const BitGrid &other) const = default;
+
+  // Calls function(row, col) for every cell set, in row-major order
+  template <typename Function>
+  void for_each_set(const Function &function) const {
+    for (size_t row = 0; row < m_height; ++row) {
+      const Word *row_words = m_words.data() + row * m_words_per_row;
+      for (size_t word_index = 0; word_index < m_words_per_row; ++word_index) {
+        Word bits = row_words[word_index];
+        while (bits != 0) {
+          function(row, word_index * WORD_BITS + std::countr_zero(bits));
+          // Clear the lowest bit set
+          bits &= bits - 1;
+        }
+      }
+    }
+  }
+
+private:
+  Word &word(const size_t row, const size_t col) {
+    return m_words[row * m_words_per_row + col / WORD_BITS];
+  }
+
+  const Word &word(const size_t row, const size_t col) const {
+    return m_words[row * m_words_per_row + col / WORD_BITS];
+  }
+
+  // The bits of the last word of each row that are inside the grid
+  Word last_word_mask() const;
+
+  size_t m_height{};
+  size_t m_width{};
+  size_t m_words_per_row{};
+  std::vector<Word> m_words;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
-#include <string>  // for string
-#include <utility> // for pair
-#include <vector>  // for vector
+#include <array>          // for array
+#include <cstddef>        // for size_t, ptrdiff_t
+#include <input_view.hpp> // for Lines, InputView
+#include <string>         // for string
+#include <utility>        // for pair
+#include <vector>         // for vector
 
 using Coordinate = long long;
 
@@ -15,10 +18,106 @@ using Grid = std::vector<std::string>;
 template <typename EntryType>
 using Matrix2D = std::vector<std::vector<EntryType>>;
 
+// Linear index into the buffer of a FlatGrid, and the signed step between two
+// such indices
+using FlatIndex = std::size_t;
+using FlatOffset = std::ptrdiff_t;
+
+constexpr size_t NUM_NEIGHBOURS = 4;
+
+// Listed clockwise: north, east, south, west
+using NeighbourOffsets = std::array<FlatOffset, NUM_NEIGHBOURS>;
+
+// A Grid stored as one row-major buffer, surrounded by a one cell border of a
+// sentinel tile. Any single step from an interior cell lands either on another
+// interior cell or on the border, so walks only need to check the tile they
+// land on rather than the coordinates.
+class FlatGrid {
+public:
+  FlatGrid() = default;
+
+  FlatGrid(const Grid &grid, const Tile border);
+
+  FlatGrid(const Lines &lines, const Tile border);
+
+  FlatGrid(const Coordinate height, const Coordinate width, const Tile fill,
+           const Tile border);
+
+  Coordinate height() const {
+    return m_height;
+  }
+
+  Coordinate width() const {
+    return m_width;
+  }
+
+  Coordinate stride() const {
+    return m_stride;
+  }
+
+  // Number of tiles in the buffer, border included
+  size_t size() const {
+    return m_tiles.size();
+  }
+
+  Tile border() const {
+    return m_border;
+  }
+
+  FlatIndex to_index(const Coordinate row, const Coordinate col) const {
+    return FlatIndex((row + 1) * m_stride + (col + 1));
+  }
+
+  FlatIndex to_index(const Position &position) const {
+    return to_index(position.first, position.second);
+  }
+
+  Position to_position(const FlatIndex index) const {
+    return {Coordinate(index) / m_stride - 1, Coordinate(index) % m_stride - 1};
+  }
+
+  bool is_in_bounds(const Coordinate row, const Coordinate col) const {
+    return row >= 0 && row < m_height && col >= 0 && col < m_width;
+  }
+
+  const NeighbourOffsets &neighbour_offsets() const {
+    return m_neighbour_offsets;
+  }
+
+  Tile &operator[](const FlatIndex index) {
+    return m_tiles[index];
+  }
+
+  const Tile &operator[](const FlatIndex index) const {
+    return m_tiles[index];
+  }
+
+  // Index of the first interior tile matching, in row-major order
+  FlatIndex find(const Tile tile) const;
+
+  // Interior indices in row-major order
+  std::vector<FlatIndex> interior_indices() const;
+
+  Grid to_grid() const;
+
+private:
+  Coordinate m_height{};
+  Coordinate m_width{};
+  Coordinate m_stride{};
+  Tile m_border{};
+  NeighbourOffsets m_neighbour_offsets{};
+  std::vector<Tile> m_tiles;
+};
+
 void greet_day(const char *);
 
+Grid get_lines(const InputView &input);
+
 Grid get_lines_from_file(const std::string &filepath);
 
+FlatGrid get_flat_grid_from_file(const std::string &filepath,
+                                 const Tile border);
+
 void print_lines(const Grid &);
 
 bool is_in_bounds(const Grid &, const Coordinate row, const Coordinate col);
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <coroutine> // for coroutine_handle, suspend_always
+#include <cstddef>   // for ptrdiff_t
+#include <exception> // for exception_ptr, current_exception, rethrow_...
+#include <iterator>  // for input_iterator_tag, default_sentinel_t
+#include <memory>    // for addressof
+#include <utility>   // for exchange
+
+// A lazy sequence produced by a coroutine, in the manner of C++23's
+// std::generator: the coroutine runs up to each co_yield as the range is
+// iterated, and not at all before begin is called.
+//
+//   Generator<int> count_to(const int last) {
+//     for (int value = 1; value <= last; ++value) {
+//       co_yield value;
+//     }
+//   }
+//
+// Each value is handed out by reference to what was yielded, so it is only
+// valid until the iterator is next incremented. Anything thrown inside the
+// coroutine comes out of begin or operator++.
+//
+// Single pass: begin can only be called once.
+template <typename Value> class Generator {
+public:
+  struct promise_type {
+    const Value *m_value{};
+    std::exception_ptr m_exception;
+
+    Generator get_return_object() {
+      return Generator(Handle::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_always final_suspend() noexcept {
+      return {};
+    }
+
+    // A temporary yielded lives until the coroutine resumes, which is as long
+    // as the value is handed out for
+    std::suspend_always yield_value(const Value &value) noexcept {
+      m_value = std::addressof(value);
+      return {};
+    }
+
+    void return_void() noexcept {}
+
+    void unhandled_exception() {
+      m_exception = std::current_exception();
+    }
+
+    // Disallow co_await in generators
+    template <typename Other> void await_transform(Other &&) = delete;
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  class Iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Value;
+
+    Iterator() = default;
+
+    explicit Iterator(const Handle handle) : m_handle(handle) {}
+
+    const Value &operator*() const {
+      return *m_handle.promise().m_value;
+    }
+
+    const Value *operator->() const {
+      return m_handle.promise().m_value;
+    }
+
+    Iterator &operator++() {
+      resume(m_handle);
+      return *this;
+    }
+
+    void operator++(int) {
+      ++*this;
+    }
+
+    bool operator==(std::default_sentinel_t) const {
+      return !m_handle || m_handle.done();
+    }
+
+  private:
+    Handle m_handle;
+  };
+
+  Generator(const Generator &) = delete;
+  Generator &operator=(const Generator &) = delete;
+
+  Generator(Generator &&other) noexcept
+      : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+  Generator &operator=(Generator &&other) noexcept {
+    if (this != &other) {
+      release();
+      m_handle = std::exchange(other.m_handle, nullptr);
+    }
+    return *this;
+  }
+
+  ~Generator() {
+    release();
+  }
+
+  // Runs the coroutine up to its first value
+  Iterator begin() {
+    resume(m_handle);
+    return Iterator(m_handle);
+  }
+
+  std::default_sentinel_t end() const {
+    return {};
+  }
+
+private:
+  explicit Generator(const Handle handle) : m_handle(handle) {}
+
+  static void resume(const Handle handle) {
+    handle.resume();
+    if (handle.promise().m_exception) {
+      std::rethrow_exception(
+          std::exchange(handle.promise().m_exception, nullptr));
+    }
+  }
+
+  void release() {
+    if (m_handle) {
+      m_handle.destroy();
+    }
+    m_handle = nullptr;
+  }
+
+  Handle m_handle;
+};
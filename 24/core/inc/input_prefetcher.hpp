@@ -0,0 +1,84 @@
+#pragma once
+
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t
+#include <deque>              // for deque
+#include <input_view.hpp>     // for InputView
+#include <mutex>              // for mutex
+#include <optional>           // for optional
+#include <string>             // for string
+#include <thread>             // for thread
+#include <vector>             // for vector
+
+// Reads many input files at once and hands each one over as soon as it is in
+// memory, in whatever order they finish, so that solving the first inputs
+// overlaps with reading the rest.
+//
+// The reads are queued together through io_uring, so on a cold cache the
+// storage sees all of them at once instead of one after another. Where
+// io_uring is missing (an old kernel, or a seccomp policy that blocks it), or
+// AOC_IO_URING=0 is set, a pool of threads calling pread stands in.
+//
+// At most max_in_flight files are being read or waiting in next() at a time,
+// so memory stays bounded however far the solvers fall behind.
+class InputPrefetcher {
+public:
+  struct Loaded {
+    // Of the file in the filepaths given
+    size_t index;
+    std::string filepath;
+    // Unset when the file could not be read, with error saying why
+    std::optional<InputView> input;
+    std::string error;
+  };
+
+  explicit InputPrefetcher(std::vector<std::string> filepaths,
+                           const size_t max_in_flight = 64);
+
+  InputPrefetcher(const InputPrefetcher &) = delete;
+  InputPrefetcher &operator=(const InputPrefetcher &) = delete;
+
+  // Waits for reads already queued to finish, but starts no more
+  ~InputPrefetcher();
+
+  // The next file to finish loading, waiting for one if need be, or nullopt
+  // once all of them have been handed out. Safe to call from several threads
+  // at once.
+  std::optional<Loaded> next();
+
+  // "io_uring" or "pread"
+  const char *backend() const {
+    return m_backend;
+  }
+
+private:
+  class IoUring;
+
+  // Each runs on threads of their own until every file is loaded or the
+  // prefetcher is destroyed
+  void load_with_io_uring(IoUring &ring);
+  void load_with_pread();
+
+  // Counts one more file against max_in_flight, returning false if it is
+  // full, after waiting for room if wait is set. Always false once stopping.
+  bool reserve(const bool wait);
+
+  void finish(Loaded loaded);
+
+  std::vector<std::string> m_filepaths;
+  size_t m_max_in_flight;
+  const char *m_backend;
+
+  std::mutex m_mutex;
+  std::condition_variable m_ready_changed;
+  std::condition_variable m_room_changed;
+  std::deque<Loaded> m_ready;
+  // Started loading but not yet handed out
+  size_t m_num_outstanding{};
+  size_t m_num_handed_out{};
+  // Only used by the pread threads
+  size_t m_next_file{};
+  bool m_stopping{};
+
+  std::vector<std::thread> m_threads;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <memory>      // for unique_ptr
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <vector>      // for vector
+
+using Lines = std::vector<std::string_view>;
+
+// Read-only view of a whole input file. The file is memory mapped rather than
+// read into a buffer, and lines are only split out the first time they are
+// asked for, as views into the mapping. Nothing here allocates per line, so the
+// cost of loading is the cost of faulting the pages in.
+//
+// Every string_view handed out is only valid for the lifetime of the InputView.
+class InputView {
+public:
+  explicit InputView(const std::string &filepath);
+
+  // Takes over the size bytes of a file already read into buffer, such as an
+  // InputPrefetcher hands out
+  InputView(std::unique_ptr<char[]> buffer, const size_t size);
+
+  InputView(const InputView &) = delete;
+  InputView &operator=(const InputView &) = delete;
+
+  InputView(InputView &&other) noexcept;
+  InputView &operator=(InputView &&other) noexcept;
+
+  ~InputView();
+
+  // The whole file, newlines included
+  std::string_view data() const {
+    return std::string_view(m_data, m_size);
+  }
+
+  size_t size() const {
+    return m_size;
+  }
+
+  // Split the same way std::getline would: on '\n', with no trailing empty line
+  // for a final newline
+  const Lines &lines() const;
+
+private:
+  void release();
+
+  const char *m_data{};
+  size_t m_size{};
+  // Only set when the file was read rather than mapped
+  std::unique_ptr<char[]> m_buffer;
+  mutable Lines m_lines;
+  mutable bool m_has_lines{};
+};
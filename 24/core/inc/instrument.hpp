@@ -0,0 +1,73 @@
+#pragma once
+
+// Scoped timers and counters for finding out where a day spends its time,
+// without reaching for an external profiler.
+//
+//   AOC_SCOPE("name")      times the rest of the enclosing block
+//   AOC_COUNT("name", n)   adds n to a counter under the innermost scope
+//
+// Scopes nest, so a scope opened inside another shows up as its child in the
+// report, with counters hanging off whichever scope was open when they were
+// bumped. Every thread accumulates into its own tree, which is merged into the
+// process wide one when the thread exits. The merged tree is printed to
+// std::cerr when the process exits.
+//
+// Names must be string literals, since only the pointer is kept.
+//
+// Everything here compiles away unless the build is configured with
+// -DAOC_INSTRUMENT=ON. The count expression is then not evaluated either.
+
+#ifdef AOC_INSTRUMENT
+
+#include <chrono>  // for steady_clock
+#include <cstddef> // for size_t
+
+namespace instrument {
+
+struct Node;
+
+// Enters the child of the current scope called name, creating it if needed,
+// and makes it the current scope
+Node *enter(const char *name);
+
+// Adds the time since start to node, then makes its parent the current scope
+void leave(Node *node, std::chrono::steady_clock::time_point start);
+
+void count(const char *name, std::size_t amount);
+
+class ScopeTimer {
+public:
+  explicit ScopeTimer(const char *name)
+      : m_node(enter(name)), m_start(std::chrono::steady_clock::now()) {}
+
+  ScopeTimer(const ScopeTimer &) = delete;
+  ScopeTimer &operator=(const ScopeTimer &) = delete;
+
+  ~ScopeTimer() {
+    leave(m_node, m_start);
+  }
+
+private:
+  Node *m_node;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace instrument
+
+#define AOC_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define AOC_INSTRUMENT_CONCAT(a, b) AOC_INSTRUMENT_CONCAT_IMPL(a, b)
+
+#define AOC_SCOPE(name)                                                        \
+  const instrument::ScopeTimer AOC_INSTRUMENT_CONCAT(aoc_scope_, __LINE__)(name)
+
+#define AOC_COUNT(name, amount) instrument::count(name, amount)
+
+#else
+
+#define AOC_SCOPE(name) static_cast<void>(0)
+
+// sizeof keeps variables that are only counted from being reported as unused,
+// without evaluating anything
+#define AOC_COUNT(name, amount) static_cast<void>(sizeof(amount))
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+// Marks a function to be compiled three times over: for the baseline the
+// binary targets, for AVX2 and for AVX-512 (x86-64-v4). The loader picks one
+// by cpuid as the program starts, so a binary built without -march=native for
+// a mix of machines still runs the widest vectors each machine has.
+//
+// Only worth it on hot loops that vectorize, and only possible on functions
+// with a body in a .cpp file, not inline ones or templates. Expands to nothing
+// with AOC_MULTIVERSION off, or where the compiler or target cannot do it.
+#if defined(AOC_MULTIVERSION) && defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define AOC_MULTIVERSIONED
+#endif
+#endif
+
+#ifdef AOC_MULTIVERSIONED
+#define AOC_TARGET_CLONES                                                      \
+  __attribute__((target_clones("default", "avx2", "arch=x86-64-v4")))
+#else
+#define AOC_TARGET_CLONES
+#endif
+
+// Which build of the AOC_TARGET_CLONES functions this CPU runs
+const char *multiversion_level();
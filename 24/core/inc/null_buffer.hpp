@@ -0,0 +1,14 @@
+#pragma once
+
+#include <streambuf> // for streambuf
+
+// Swallows everything written to it. Some days print progress to std::cout,
+// which would otherwise end up interleaved with the results of the drivers that
+// run many days in one process. Holds no state, so it is safe to write to from
+// several threads at once.
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int character) override {
+    return character;
+  }
+};
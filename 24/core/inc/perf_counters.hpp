@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <optional> // for optional
+#include <string>   // for string
+
+// Hardware performance counters around a stretch of code, read through
+// perf_event_open on Linux. Used by the --counters modes of the drivers to
+// tell memory bound parts from compute bound ones.
+//
+// Every counter is opened in one group so that they all count over exactly the
+// same instructions. Counters the CPU or kernel does not offer are left out and
+// reported as missing, and if not even cycles can be counted (not Linux, no
+// PMU, perf_event_paranoid too strict) the whole thing is unavailable. Either
+// way, nothing throws: the caller just gets less to print.
+class PerfCounters {
+public:
+  enum Event : size_t {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,
+    LLC_MISSES,
+    BRANCHES,
+    BRANCH_MISSES,
+    NUM_EVENTS,
+  };
+
+  struct Readings {
+    std::array<uint64_t, NUM_EVENTS> m_values{};
+    std::array<bool, NUM_EVENTS> m_has_value{};
+    // Below one when the group was multiplexed with others and the values were
+    // scaled up from part of the time
+    double m_running_fraction{};
+
+    // Each of these is empty when the counters it needs are missing
+
+    std::optional<double> instructions_per_cycle() const;
+
+    // Misses per thousand instructions, MPKI
+    std::optional<double> misses_per_kilo_instruction(const Event misses) const;
+
+    std::optional<double> branch_miss_percent() const;
+
+    // One line of IPC and miss rates, leaving out whatever was not counted
+    std::string summary() const;
+  };
+
+  PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  ~PerfCounters();
+
+  bool is_available() const {
+    return m_file_descriptors[CYCLES] >= 0;
+  }
+
+  // Why the counters are unavailable, or which ones are missing
+  const std::string &status() const {
+    return m_status;
+  }
+
+  // Zeroes and starts every counter in the group
+  void start();
+
+  // Stops the group and reads what it counted since start
+  Readings stop();
+
+private:
+  std::array<int, NUM_EVENTS> m_file_descriptors;
+  std::string m_status;
+};
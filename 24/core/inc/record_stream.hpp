@@ -0,0 +1,56 @@
+#pragma once
+
+#include <concepts>      // for invocable
+#include <cstddef>       // for size_t
+#include <generator.hpp> // for Generator
+#include <string>        // for string
+#include <string_view>   // for string_view
+#include <type_traits>   // for invoke_result_t, remove_cvref_t
+
+// Streams the records of an input file without ever holding all of it, for
+// days that fold over independent records and so have no need for the whole
+// input at once. The file is read a chunk at a time into one buffer, which is
+// only ever as big as a chunk plus the longest record, so an input of any size
+// runs in the same memory.
+//
+// Records are split on separator, "\n" for lines or "\n\n" for blocks of lines
+// with a blank line between them. As with InputView::lines, a separator at the
+// very end does not make an empty record after it.
+//
+// Every string_view handed out points into the buffer, so it is only valid
+// until the next record is asked for. Records that are needed for longer have
+// to be copied or parsed.
+
+constexpr size_t RECORD_STREAM_CHUNK_SIZE = size_t(1) << 20;
+
+// Throws straight away if the file cannot be opened, rather than once the
+// records are iterated
+Generator<std::string_view>
+stream_record_text(const std::string &filepath,
+                   const std::string_view separator = "\n",
+                   const size_t chunk_size = RECORD_STREAM_CHUNK_SIZE);
+
+template <typename ParseRecord>
+using ParsedRecord =
+    std::remove_cvref_t<std::invoke_result_t<const ParseRecord &,
+                                             std::string_view>>;
+
+template <typename ParseRecord>
+Generator<ParsedRecord<ParseRecord>>
+parse_each_record(Generator<std::string_view> texts,
+                  const ParseRecord parse_record) {
+  for (const auto text : texts) {
+    co_yield parse_record(text);
+  }
+}
+
+// Each record of the file, parsed with parse_record. Only the parsed record
+// being handed out is held at any time.
+template <typename ParseRecord>
+  requires std::invocable<const ParseRecord &, std::string_view>
+Generator<ParsedRecord<ParseRecord>>
+stream_records(const std::string &filepath, const ParseRecord parse_record,
+               const std::string_view separator = "\n") {
+  return parse_each_record(stream_record_text(filepath, separator),
+                           parse_record);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string> // for string
+#include <vector> // for vector
+
+class AnswerCache;
+class InputView;
+class PerfCounters;
+struct RegisteredDay;
+
+// How a day is asked to run, from the command line
+struct RunOptions {
+  std::string filepath;
+  // Stream whichever parts can be straight off the file
+  bool stream = false;
+  // Wrapped around each part when set
+  PerfCounters *counters = nullptr;
+  // Checked for each part before solving it, and given each answer after,
+  // when set
+  const AnswerCache *cache = nullptr;
+};
+
+using RunDay = void (*)(const RegisteredDay &day, const RunOptions &options);
+
+// Both answers to a day on one input, and how long each step took
+struct DayResult {
+  std::string part_1;
+  std::string part_2;
+  double parse_ms{};
+  double part_1_ms{};
+  double part_2_ms{};
+};
+
+// Solves a day on one input already loaded, without printing anything of its
+// own, for running many inputs side by side. Safe to call from several threads
+// at once.
+using SolveDay = DayResult (*)(const InputView &input);
+
+struct RegisteredDay {
+  std::string id;
+  // A hash of the day's built library and core, which changes whenever
+  // either is rebuilt differently, for keying the AnswerCache
+  std::string build_id;
+  RunDay run;
+  SolveDay solve;
+};
+
+// Every day linked into the binary, in order of id. Days add themselves
+// before main starts, through a DayRegistrar in main/register_day.cpp, which
+// is compiled once per day with AOC_DAY_ID set. Linking in a day's
+// registration object is all it takes for a binary to be able to run it.
+const std::vector<RegisteredDay> &registered_days();
+
+// nullptr if no day of that id was linked in
+const RegisteredDay *find_registered_day(const std::string &id);
+
+struct DayRegistrar {
+  DayRegistrar(const std::string &id, const std::string &build_id,
+               const RunDay run, const SolveDay solve);
+};
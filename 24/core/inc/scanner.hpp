@@ -0,0 +1,168 @@
+#pragma once
+
+#include <bit>         // for endian, countr_zero
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t, int64_t
+#include <cstring>     // for memcpy
+#include <stdexcept>   // for runtime_error
+#include <string>      // for string, operator+
+#include <string_view> // for string_view
+
+// Reads numbers and fixed text off the front of a string_view, without copying
+// anything out of it. Meant to replace the stoi/substr style of parsing, which
+// builds a temporary string for every number.
+//
+// Nothing skips whitespace implicitly: anything between fields has to be
+// stepped over with expect or one of the skip functions. Running into text
+// that does not match throws.
+//
+// Numbers are not checked for overflow.
+class Scanner {
+public:
+  explicit Scanner(const std::string_view text) : m_text(text) {}
+
+  bool at_end() const {
+    return m_position >= m_text.size();
+  }
+
+  // Everything not consumed yet
+  std::string_view rest() const {
+    return m_text.substr(m_position);
+  }
+
+  // Steps over a run of unsigned decimal digits. Throws if there are none.
+  uint64_t next_uint() {
+    const size_t start = m_position;
+    uint64_t value{};
+    // Eight digits at a time while there are eight bytes left to load
+    while (m_text.size() - m_position >= sizeof(uint64_t)) {
+      const size_t num_digits = scan_eight_digits(value);
+      m_position += num_digits;
+      if (num_digits < sizeof(uint64_t)) {
+        break;
+      }
+    }
+    // Then one at a time for whatever is left near the end
+    if (m_text.size() - m_position < sizeof(uint64_t)) {
+      while (!at_end() && is_digit(m_text[m_position])) {
+        value = value * 10 + uint64_t(m_text[m_position] - '0');
+        ++m_position;
+      }
+    }
+    if (m_position == start) {
+      throw_expected("a number");
+    }
+    return value;
+  }
+
+  // Steps over an optional sign followed by unsigned decimal digits
+  int64_t next_int() {
+    if (!at_end() && (m_text[m_position] == '-' || m_text[m_position] == '+')) {
+      const bool is_negative = m_text[m_position] == '-';
+      ++m_position;
+      const int64_t magnitude = int64_t(next_uint());
+      return is_negative ? -magnitude : magnitude;
+    }
+    return int64_t(next_uint());
+  }
+
+  // Steps over literal, throwing if the text does not start with it
+  void expect(const std::string_view literal) {
+    if (!try_expect(literal)) {
+      throw_expected("\"" + std::string(literal) + "\"");
+    }
+  }
+
+  // Steps over literal if the text starts with it
+  bool try_expect(const std::string_view literal) {
+    if (rest().substr(0, literal.size()) != literal) {
+      return false;
+    }
+    m_position += literal.size();
+    return true;
+  }
+
+  // Steps over any run made up of the given delimiters
+  void skip_any(const std::string_view delimiters) {
+    while (!at_end() && delimiters.find(m_text[m_position]) !=
+                            std::string_view::npos) {
+      ++m_position;
+    }
+  }
+
+  // Steps forward to the next place next_int can read from, that is a digit or
+  // a sign followed by one. Returns false if there is none.
+  bool skip_to_int() {
+    while (!at_end()) {
+      const char current = m_text[m_position];
+      if (is_digit(current)) {
+        return true;
+      }
+      if ((current == '-' || current == '+') &&
+          m_position + 1 < m_text.size() &&
+          is_digit(m_text[m_position + 1])) {
+        return true;
+      }
+      ++m_position;
+    }
+    return false;
+  }
+
+private:
+  static bool is_digit(const char character) {
+    return character >= '0' && character <= '9';
+  }
+
+  // Loads the next eight bytes, appends however many of them lead with digits
+  // to value, and returns that count. The digits are found and converted with
+  // plain arithmetic on the whole word instead of a branch per character.
+  size_t scan_eight_digits(uint64_t &value) const {
+    if constexpr (std::endian::native != std::endian::little) {
+      // The word tricks below assume the first byte is the lowest one
+      size_t num_digits{};
+      while (num_digits < sizeof(uint64_t) &&
+             is_digit(m_text[m_position + num_digits])) {
+        value = value * 10 + uint64_t(m_text[m_position + num_digits] - '0');
+        ++num_digits;
+      }
+      return num_digits;
+    }
+
+    uint64_t chunk;
+    std::memcpy(&chunk, m_text.data() + m_position, sizeof(chunk));
+
+    // A byte is a digit when its high nibble is 3 both before and after adding
+    // 6, i.e. it lies in 0x30 to 0x39. Any other byte leaves a bit set here.
+    constexpr uint64_t HIGH_NIBBLES = 0xF0F0F0F0F0F0F0F0;
+    constexpr uint64_t DIGIT_NIBBLES = 0x3030303030303030;
+    const uint64_t non_digits =
+        ((chunk & HIGH_NIBBLES) ^ DIGIT_NIBBLES) |
+        (((chunk + 0x0606060606060606) & HIGH_NIBBLES) ^ DIGIT_NIBBLES);
+    const size_t num_digits =
+        non_digits == 0 ? sizeof(uint64_t) : std::countr_zero(non_digits) / 8;
+    if (num_digits == 0) {
+      return 0;
+    }
+
+    // Shift the digits up so that the missing leading ones read as zero, then
+    // combine neighbouring digits pairwise: 1 into 2 digit, 2 into 4, 4 into 8
+    chunk <<= 8 * (sizeof(uint64_t) - num_digits);
+    chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+    chunk = ((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+
+    value = value * POWERS_OF_TEN[num_digits] + chunk;
+    return num_digits;
+  }
+
+  [[noreturn]] void throw_expected(const std::string &what) const {
+    throw std::runtime_error("Expected " + what + " at \"" +
+                             std::string(rest().substr(0, 16)) + "\"");
+  }
+
+  static constexpr uint64_t POWERS_OF_TEN[] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+  std::string_view m_text;
+  size_t m_position{};
+};
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>   // for reverse, min_element
+#include <array>       // for array
+#include <bit>         // for bit_width
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t, uint64_t
+#include <deque>       // for deque
+#include <limits>      // for numeric_limits
+#include <span>        // for span
+#include <stdexcept>   // for runtime_error
+#include <type_traits> // for is_unsigned_v
+#include <utility>     // for pair
+#include <vector>      // for vector
+
+// Graph searches over states numbered densely from zero, so that distances and
+// predecessors live in flat arrays instead of maps or sets of tuples.
+//
+// Each day encodes its own states into ids (a FlatIndex already is one, and
+// LayeredStates covers a heading or similar on top of one) and describes the
+// graph with a neighbour function:
+//
+//   // Unweighted, for breadth_first_search
+//   neighbours(const StateId state, const auto &visit) { visit(next); ... }
+//
+//   // Weighted, for the others
+//   neighbours(const StateId state, const auto &visit) {
+//     visit(next, weight); ...
+//   }
+//
+// Every search can start from several sources at once, at distance zero, and
+// can stop as soon as a state matching is_target is settled. The results stay
+// in the SearchState passed in until the next search through it.
+
+using StateId = uint32_t;
+
+constexpr StateId NO_STATE = std::numeric_limits<StateId>::max();
+
+// Ids for (layer, index) pairs, such as a heading and a FlatIndex
+class LayeredStates {
+public:
+  LayeredStates(const size_t num_layers, const size_t layer_size)
+      : m_num_layers(num_layers), m_layer_size(layer_size) {
+    if (num_layers * layer_size >= NO_STATE) {
+      throw std::runtime_error("Too many states for a StateId!");
+    }
+  }
+
+  size_t size() const {
+    return m_num_layers * m_layer_size;
+  }
+
+  StateId encode(const size_t layer, const size_t index) const {
+    return StateId(layer * m_layer_size + index);
+  }
+
+  size_t layer(const StateId state) const {
+    return state / m_layer_size;
+  }
+
+  size_t index(const StateId state) const {
+    return state % m_layer_size;
+  }
+
+private:
+  size_t m_num_layers;
+  size_t m_layer_size;
+};
+
+// The distances and predecessors of one search at a time. Kept between
+// searches so that running many small searches over a big graph does not pay
+// for the whole graph each time: starting a search only clears the states the
+// last one reached.
+template <typename Distance = uint32_t> class SearchState {
+public:
+  static_assert(std::is_unsigned_v<Distance>);
+
+  static constexpr Distance UNREACHED = std::numeric_limits<Distance>::max();
+
+  explicit SearchState(const size_t num_states)
+      : m_distances(num_states, UNREACHED)
+      , m_predecessors(num_states, NO_STATE) {
+    if (num_states >= NO_STATE) {
+      throw std::runtime_error("Too many states for a StateId!");
+    }
+  }
+
+  size_t size() const {
+    return m_distances.size();
+  }
+
+  bool is_reached(const StateId state) const {
+    return m_distances[state] != UNREACHED;
+  }
+
+  Distance distance(const StateId state) const {
+    return m_distances[state];
+  }
+
+  // NO_STATE for the sources and anything not reached
+  StateId predecessor(const StateId state) const {
+    return m_predecessors[state];
+  }
+
+  // Every state given a distance, in the order they were first reached
+  const std::vector<StateId> &reached() const {
+    return m_reached;
+  }
+
+  // From the source the state was reached from to the state itself, or empty
+  // if it was not reached
+  std::vector<StateId> path_to(const StateId state) const {
+    std::vector<StateId> path;
+    if (!is_reached(state)) {
+      return path;
+    }
+    for (StateId current = state; current != NO_STATE;
+         current = m_predecessors[current]) {
+      path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+  }
+
+  // Forgets the last search
+  void reset() {
+    for (const StateId state : m_reached) {
+      m_distances[state] = UNREACHED;
+      m_predecessors[state] = NO_STATE;
+    }
+    m_reached.clear();
+  }
+
+  // Records state at distance if that is shorter than it had, returning
+  // whether it was
+  bool improve(const StateId state, const Distance distance,
+               const StateId predecessor) {
+    if (distance >= m_distances[state]) {
+      return false;
+    }
+    if (m_distances[state] == UNREACHED) {
+      m_reached.push_back(state);
+    }
+    m_distances[state] = distance;
+    m_predecessors[state] = predecessor;
+    return true;
+  }
+
+private:
+  std::vector<Distance> m_distances;
+  std::vector<StateId> m_predecessors;
+  std::vector<StateId> m_reached;
+};
+
+// For searches that run to the end
+struct NoTarget {
+  bool operator()(const StateId) const {
+    return false;
+  }
+};
+
+// A priority queue for keys that never go below the last one popped, as in
+// Dijkstra's algorithm and A* with a consistent heuristic. Entries sit in a
+// bucket by the highest bit in which their key differs from the last key
+// popped. Only the lowest non-empty bucket is ever sorted out, and each entry
+// can only move down, at most once per bit of the key, so both push and pop
+// are amortized constant time.
+template <typename Value> class RadixHeap {
+public:
+  using Key = uint64_t;
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  void push(const Key key, const Value &value) {
+    if (key < m_last) {
+      throw std::runtime_error("RadixHeap keys cannot go below the last pop!");
+    }
+    m_buckets[bucket_index(key)].emplace_back(key, value);
+    ++m_size;
+  }
+
+  // The entry with the lowest key
+  std::pair<Key, Value> pop() {
+    if (m_buckets[0].empty()) {
+      size_t index = 1;
+      while (m_buckets[index].empty()) {
+        ++index;
+      }
+      // Everything left in the bucket differs from the new lowest key in a
+      // lower bit than before, so moves down
+      auto &bucket = m_buckets[index];
+      m_last = std::min_element(bucket.begin(), bucket.end())->first;
+      for (const auto &entry : bucket) {
+        m_buckets[bucket_index(entry.first)].push_back(entry);
+      }
+      bucket.clear();
+    }
+    const auto entry = m_buckets[0].back();
+    m_buckets[0].pop_back();
+    --m_size;
+    return entry;
+  }
+
+private:
+  size_t bucket_index(const Key key) const {
+    return size_t(std::bit_width(key ^ m_last));
+  }
+
+  std::array<std::vector<std::pair<Key, Value>>, 65> m_buckets;
+  Key m_last{};
+  size_t m_size{};
+};
+
+// Unweighted shortest paths, by number of steps. Returns the first state
+// matching is_target to be reached, or NO_STATE.
+template <typename Distance, typename Neighbours, typename IsTarget = NoTarget>
+StateId breadth_first_search(SearchState<Distance> &search,
+                             const std::span<const StateId> sources,
+                             const Neighbours &neighbours,
+                             const IsTarget &is_target = {}) {
+  search.reset();
+  for (const StateId source : sources) {
+    search.improve(source, 0, NO_STATE);
+  }
+  // The reached list doubles as the queue: states are appended in the order
+  // they are first reached, which for a breadth first search is the order
+  // they are expanded in
+  for (size_t next = 0; next < search.reached().size(); ++next) {
+    const StateId state = search.reached()[next];
+    if (is_target(state)) {
+      return state;
+    }
+    const Distance next_distance = search.distance(state) + 1;
+    neighbours(state, [&](const StateId neighbour) {
+      search.improve(neighbour, next_distance, state);
+    });
+  }
+  return NO_STATE;
+}
+
+// Shortest paths where every step costs 0 or 1: steps of 0 go to the front
+// of the queue, steps of 1 to the back
+template <typename Distance, typename Neighbours, typename IsTarget = NoTarget>
+StateId zero_one_breadth_first_search(SearchState<Distance> &search,
+                                      const std::span<const StateId> sources,
+                                      const Neighbours &neighbours,
+                                      const IsTarget &is_target = {}) {
+  search.reset();
+  std::deque<std::pair<Distance, StateId>> queue;
+  for (const StateId source : sources) {
+    if (search.improve(source, 0, NO_STATE)) {
+      queue.emplace_back(0, source);
+    }
+  }
+  while (!queue.empty()) {
+    const auto [distance, state] = queue.front();
+    queue.pop_front();
+    if (distance > search.distance(state)) {
+      // Already settled at a shorter distance
+      continue;
+    }
+    if (is_target(state)) {
+      return state;
+    }
+    neighbours(state, [&](const StateId neighbour, const Distance weight) {
+      if (weight > 1) {
+        throw std::runtime_error("0-1 BFS needs weights of 0 or 1!");
+      }
+      if (!search.improve(neighbour, distance + weight, state)) {
+        return;
+      }
+      if (weight == 0) {
+        queue.emplace_front(distance, neighbour);
+      } else {
+        queue.emplace_back(distance + 1, neighbour);
+      }
+    });
+  }
+  return NO_STATE;
+}
+
+// Shortest paths with non-negative weights, in order of distance, off a
+// RadixHeap. heuristic gives a lower bound on the distance left from a state
+// to the nearest target, turning this into A*. It has to be consistent (never
+// dropping by more than the weight of a step), or the keys would not be
+// monotone.
+template <typename Distance, typename Neighbours, typename Heuristic,
+          typename IsTarget>
+StateId a_star_search(SearchState<Distance> &search,
+                      const std::span<const StateId> sources,
+                      const Neighbours &neighbours, const Heuristic &heuristic,
+                      const IsTarget &is_target) {
+  search.reset();
+  RadixHeap<StateId> queue;
+  for (const StateId source : sources) {
+    if (search.improve(source, 0, NO_STATE)) {
+      queue.push(heuristic(source), source);
+    }
+  }
+  while (!queue.empty()) {
+    const auto [estimate, state] = queue.pop();
+    if (estimate > search.distance(state) + heuristic(state)) {
+      // Already settled at a shorter distance
+      continue;
+    }
+    if (is_target(state)) {
+      return state;
+    }
+    const Distance distance = search.distance(state);
+    neighbours(state, [&](const StateId neighbour, const Distance weight) {
+      if (search.improve(neighbour, distance + weight, state)) {
+        queue.push(uint64_t(distance + weight) + heuristic(neighbour),
+                   neighbour);
+      }
+    });
+  }
+  return NO_STATE;
+}
+
+// Dijkstra's algorithm: A* without a heuristic
+template <typename Distance, typename Neighbours, typename IsTarget = NoTarget>
+StateId dijkstra_search(SearchState<Distance> &search,
+                        const std::span<const StateId> sources,
+                        const Neighbours &neighbours,
+                        const IsTarget &is_target = {}) {
+  return a_star_search(
+      search, sources, neighbours, [](const StateId) { return uint64_t(0); },
+      is_target);
+}
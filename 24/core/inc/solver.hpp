@@ -0,0 +1,79 @@
+#pragma once
+
+#include <concepts>       // for same_as
+#include <input_view.hpp> // for InputView
+#include <instrument.hpp> // for AOC_SCOPE
+#include <string>         // for string
+#include <utility>        // for pair
+
+// A day split into parsing and solving, so that both parts can share one parse
+// of the input. Each day provides a Solution type with:
+//
+//   using Input = ...;
+//   static Input parse(const InputView &);
+//   static std::string solve_part_1(const Input &);
+//   static std::string solve_part_2(const Input &);
+//
+// Input may hold views into the InputView it was parsed from, so the InputView
+// has to outlive it.
+template <typename Solution>
+concept Solver = requires(const InputView &view,
+                          const typename Solution::Input &input) {
+  { Solution::parse(view) } -> std::same_as<typename Solution::Input>;
+  { Solution::solve_part_1(input) } -> std::same_as<std::string>;
+  { Solution::solve_part_2(input) } -> std::same_as<std::string>;
+};
+
+// A day whose part can also be solved straight off the file, a record at a
+// time, without parsing the whole input first. Only days that fold over
+// independent records provide these, as
+//
+//   static std::string stream_part_1(const std::string &filepath);
+//
+// and they have to give the same answer as parse and solve_part_1.
+template <typename Solution>
+concept StreamingPart1 = requires(const std::string &filepath) {
+  { Solution::stream_part_1(filepath) } -> std::same_as<std::string>;
+};
+
+template <typename Solution>
+concept StreamingPart2 = requires(const std::string &filepath) {
+  { Solution::stream_part_2(filepath) } -> std::same_as<std::string>;
+};
+
+// A day that streams both parts in one pass over the file, as
+//
+//   static std::pair<std::string, std::string>
+//   stream_both_parts(const std::string &filepath);
+//
+// which is used instead of streaming each part when both are asked for.
+template <typename Solution>
+concept StreamingBothParts = requires(const std::string &filepath) {
+  {
+    Solution::stream_both_parts(filepath)
+  } -> std::same_as<std::pair<std::string, std::string>>;
+};
+
+// Load, parse and solve a single part. Backs the old part_1/part_2 entry points
+// that only take a filepath.
+template <Solver Solution>
+std::string solve_part_1_from_file(const std::string &filepath) {
+  AOC_SCOPE("part_1");
+  const InputView view(filepath);
+  const auto parsed = [&]() {
+    AOC_SCOPE("parse");
+    return Solution::parse(view);
+  }();
+  return Solution::solve_part_1(parsed);
+}
+
+template <Solver Solution>
+std::string solve_part_2_from_file(const std::string &filepath) {
+  AOC_SCOPE("part_2");
+  const InputView view(filepath);
+  const auto parsed = [&]() {
+    AOC_SCOPE("parse");
+    return Solution::parse(view);
+  }();
+  return Solution::solve_part_2(parsed);
+}
@@ -0,0 +1,220 @@
+#include <allocation_counter.hpp> // for AllocationCounter, AllocationStats
+#include <cstdint>                // for uint64_t, int64_t
+#include <iomanip>                // for operator<<, setprecision
+#include <ios>                    // for fixed
+#include <sstream>                // for basic_ostream, operator<<, stringstream
+#include <string>                 // for string
+#include <sys/resource.h>         // for getrusage, rusage, RUSAGE_SELF
+
+#ifdef AOC_COUNT_ALLOCATIONS
+#include <algorithm> // for max
+#include <cstddef>   // for size_t, max_align_t
+#include <cstdlib>   // for malloc, free, aligned_alloc
+#include <new>       // for align_val_t, bad_alloc, nothrow_t
+#endif
+
+// Plain integers only, so that they are set up before the first allocation of
+// any thread without any allocation of their own
+struct ThreadCounts {
+  uint64_t m_allocations;
+  uint64_t m_bytes;
+  int64_t m_live_bytes;
+  int64_t m_peak_live_bytes;
+};
+
+static thread_local ThreadCounts thread_counts{};
+
+#ifdef AOC_COUNT_ALLOCATIONS
+
+// Every block carries its size and the offset back to the start of what was
+// allocated in the two words right before the pointer handed out. The header
+// is a whole multiple of the alignment so that the pointer stays aligned.
+constexpr size_t MIN_HEADER_SIZE = alignof(std::max_align_t);
+static_assert(MIN_HEADER_SIZE >= 2 * sizeof(size_t));
+
+static void *counted_allocate(const size_t size, const size_t alignment) {
+  const size_t header_size = std::max(MIN_HEADER_SIZE, alignment);
+  void *block = nullptr;
+  if (alignment > MIN_HEADER_SIZE) {
+    // aligned_alloc wants the size to be a multiple of the alignment
+    const size_t total = (header_size + size + alignment - 1) / alignment *
+                         alignment;
+    block = std::aligned_alloc(alignment, total);
+  } else {
+    block = std::malloc(header_size + size);
+  }
+  if (block == nullptr) {
+    return nullptr;
+  }
+
+  char *pointer = static_cast<char *>(block) + header_size;
+  reinterpret_cast<size_t *>(pointer)[-1] = size;
+  reinterpret_cast<size_t *>(pointer)[-2] = header_size;
+
+  auto &counts = thread_counts;
+  ++counts.m_allocations;
+  counts.m_bytes += size;
+  counts.m_live_bytes += int64_t(size);
+  counts.m_peak_live_bytes =
+      std::max(counts.m_peak_live_bytes, counts.m_live_bytes);
+  return pointer;
+}
+
+static void counted_free(void *pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  const size_t size = static_cast<size_t *>(pointer)[-1];
+  const size_t header_size = static_cast<size_t *>(pointer)[-2];
+  thread_counts.m_live_bytes -= int64_t(size);
+  std::free(static_cast<char *>(pointer) - header_size);
+}
+
+static void *counted_allocate_or_throw(const size_t size,
+                                       const size_t alignment) {
+  void *pointer = counted_allocate(size, alignment);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+// Every replaceable form of operator new and delete, so that none of them can
+// reach the default versions and mix up blocks with and without a header
+
+void *operator new(size_t size) {
+  return counted_allocate_or_throw(size, MIN_HEADER_SIZE);
+}
+
+void *operator new[](size_t size) {
+  return counted_allocate_or_throw(size, MIN_HEADER_SIZE);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+  return counted_allocate_or_throw(size, size_t(alignment));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+  return counted_allocate_or_throw(size, size_t(alignment));
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return counted_allocate(size, MIN_HEADER_SIZE);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return counted_allocate(size, MIN_HEADER_SIZE);
+}
+
+void *operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  return counted_allocate(size, size_t(alignment));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  return counted_allocate(size, size_t(alignment));
+}
+
+void operator delete(void *pointer) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  counted_free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  counted_free(pointer);
+}
+
+#endif
+
+AllocationCounter::AllocationCounter()
+    : m_start_allocations(thread_counts.m_allocations)
+    , m_start_bytes(thread_counts.m_bytes)
+    , m_start_live_bytes(thread_counts.m_live_bytes)
+    , m_outer_peak_live_bytes(thread_counts.m_peak_live_bytes) {
+  thread_counts.m_peak_live_bytes = thread_counts.m_live_bytes;
+}
+
+AllocationStats AllocationCounter::stop() {
+  auto &counts = thread_counts;
+  AllocationStats stats;
+  stats.m_allocations = counts.m_allocations - m_start_allocations;
+  stats.m_bytes = counts.m_bytes - m_start_bytes;
+  stats.m_peak_live_bytes =
+      uint64_t(counts.m_peak_live_bytes - m_start_live_bytes);
+  if (m_outer_peak_live_bytes > counts.m_peak_live_bytes) {
+    counts.m_peak_live_bytes = m_outer_peak_live_bytes;
+  }
+  return stats;
+}
+
+std::string format_bytes(const uint64_t bytes) {
+  std::stringstream output;
+  output << std::fixed << std::setprecision(1);
+  if (bytes < 1024) {
+    output << bytes << " B";
+  } else if (bytes < 1024 * 1024) {
+    output << double(bytes) / 1024 << " KiB";
+  } else {
+    output << double(bytes) / (1024 * 1024) << " MiB";
+  }
+  return output.str();
+}
+
+std::string AllocationStats::summary() const {
+  return std::to_string(m_allocations) + " allocations, " +
+         format_bytes(m_bytes) + " allocated, " +
+         format_bytes(m_peak_live_bytes) + " peak live";
+}
+
+uint64_t peak_rss_bytes() {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  // Already in bytes on macOS, where Linux counts in KiB
+  return uint64_t(usage.ru_maxrss);
+#else
+  return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+}
@@ -0,0 +1,121 @@
+#include <algorithm>        // for min
+#include <answer_cache.hpp> // for AnswerCache, AnswerKey, hash_bytes
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint64_t
+#include <cstdlib>          // for getenv
+#include <cstring>          // for memcpy
+#include <filesystem>       // for path, operator/, create_directories, rename
+#include <fstream>          // for basic_ofstream, basic_ifstream, ifstream
+#include <functional>       // for hash
+#include <iomanip>          // for operator<<, setfill, setw
+#include <ios>              // for hex
+#include <iterator>         // for istreambuf_iterator
+#include <optional>         // for optional, nullopt
+#include <sstream>          // for basic_ostringstream, ostringstream
+#include <string>           // for string, to_string, operator+
+#include <string_view>      // for string_view
+#include <system_error>     // for error_code
+#include <thread>           // for get_id, thread
+#include <unistd.h>         // for getpid
+#include <utility>          // for move
+
+constexpr uint64_t HASH_MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t mix(uint64_t value) {
+  value ^= value >> 32;
+  value *= HASH_MULTIPLIER;
+  value ^= value >> 29;
+  return value;
+}
+
+uint64_t hash_bytes(const std::string_view bytes) {
+  // Eight bytes at a time, each word mixed into its own lane of four so that
+  // the multiplies do not wait on one another
+  uint64_t lanes[4] = {HASH_MULTIPLIER, ~HASH_MULTIPLIER, HASH_MULTIPLIER << 1,
+                       HASH_MULTIPLIER >> 1};
+  const char *data = bytes.data();
+  size_t remaining = bytes.size();
+  while (remaining >= sizeof(lanes)) {
+    for (uint64_t &lane : lanes) {
+      uint64_t word;
+      std::memcpy(&word, data, sizeof(word));
+      lane = mix(lane ^ word);
+      data += sizeof(word);
+    }
+    remaining -= sizeof(lanes);
+  }
+  uint64_t hash = mix(bytes.size());
+  for (const uint64_t lane : lanes) {
+    hash = mix(hash ^ lane);
+  }
+  while (remaining > 0) {
+    uint64_t word{};
+    const size_t num_bytes = std::min(remaining, sizeof(word));
+    std::memcpy(&word, data, num_bytes);
+    hash = mix(hash ^ word);
+    data += num_bytes;
+    remaining -= num_bytes;
+  }
+  return hash;
+}
+
+static std::string to_hex(const uint64_t value) {
+  std::ostringstream out;
+  out << std::hex << std::setfill('0') << std::setw(16) << value;
+  return out.str();
+}
+
+AnswerCache::AnswerCache(std::filesystem::path directory)
+    : m_directory(std::move(directory)) {}
+
+std::optional<AnswerCache> AnswerCache::from_environment() {
+  const char *directory = std::getenv("AOC_CACHE_DIR");
+  if (directory == nullptr || *directory == '\0') {
+    return std::nullopt;
+  }
+  return AnswerCache(directory);
+}
+
+std::filesystem::path AnswerCache::path_of(const AnswerKey &key,
+                                           const int part) const {
+  return m_directory / key.day_id / key.build_id /
+         (to_hex(key.input_hash) + ".part" + std::to_string(part));
+}
+
+std::optional<std::string> AnswerCache::find(const AnswerKey &key,
+                                             const int part) const {
+  std::ifstream in_stream(path_of(key, part), std::ios::binary);
+  if (!in_stream) {
+    return std::nullopt;
+  }
+  return std::string(std::istreambuf_iterator<char>(in_stream),
+                     std::istreambuf_iterator<char>());
+}
+
+void AnswerCache::store(const AnswerKey &key, const int part,
+                        const std::string &answer) const {
+  const auto path = path_of(key, part);
+  std::error_code error;
+  std::filesystem::create_directories(path.parent_path(), error);
+  if (error) {
+    return;
+  }
+  // Unique to this thread of this process
+  auto temporary_path = path;
+  temporary_path += ".tmp." + std::to_string(::getpid()) + "." +
+                    std::to_string(std::hash<std::thread::id>{}(
+                        std::this_thread::get_id()));
+  {
+    std::ofstream out_stream(temporary_path, std::ios::binary);
+    out_stream << answer;
+    if (!out_stream.flush()) {
+      out_stream.close();
+      std::filesystem::remove(temporary_path, error);
+      return;
+    }
+  }
+  std::filesystem::rename(temporary_path, path, error);
+  if (error) {
+    std::filesystem::remove(temporary_path, error);
+  }
+}
@@ -0,0 +1,65 @@
+#include <arena.hpp>       // for Arena
+#include <cstddef>         // for size_t, byte
+#include <memory_resource> // for new_delete_resource
+#include <new>             // for bad_alloc
+#include <sys/mman.h>      // for mmap, munmap, madvise, MAP_FAILED
+
+constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+static size_t round_up(const size_t value, const size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+static size_t backing_size(const size_t capacity,
+                           const Arena::Backing backing) {
+  if (backing == Arena::Backing::HugePages) {
+    return round_up(capacity, HUGE_PAGE_SIZE);
+  }
+  return capacity;
+}
+
+static std::byte *map_huge_pages(const size_t size) {
+  void *mapping = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  // Only works if huge pages have been reserved up front, so it is just the
+  // first thing to try
+  mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+  if (mapping == MAP_FAILED) {
+    mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    // Ask for transparent huge pages instead, a hint that may be ignored
+    ::madvise(mapping, size, MADV_HUGEPAGE);
+#endif
+  }
+  return static_cast<std::byte *>(mapping);
+}
+
+static std::byte *allocate_buffer(const size_t size,
+                                  const Arena::Backing backing) {
+  if (backing == Arena::Backing::HugePages) {
+    return map_huge_pages(size);
+  }
+  return new std::byte[size];
+}
+
+Arena::Arena(const size_t capacity, const Backing backing)
+    : m_capacity(backing_size(capacity, backing))
+    , m_backing(backing)
+    , m_buffer(allocate_buffer(m_capacity, backing))
+    , m_resource(m_buffer, m_capacity, std::pmr::new_delete_resource()) {}
+
+Arena::~Arena() {
+  // Hand back anything that overflowed onto the heap before the buffer goes
+  m_resource.release();
+  if (m_backing == Backing::HugePages) {
+    ::munmap(m_buffer, m_capacity);
+  } else {
+    delete[] m_buffer;
+  }
+}
@@ -0,0 +1,147 @@
+#include <algorithm>    // for fill, copy, copy_backward
+#include <bit>          // for popcount
+#include <bit_grid.hpp> // for BitGrid
+#include <core_lib.hpp> // for FlatOffset
+#include <cstddef>      // for size_t
+#include <stdexcept>    // for runtime_error
+#include <vector>       // for vector
+
+BitGrid::BitGrid(const size_t height, const size_t width)
+    : m_height(height)
+    , m_width(width)
+    , m_words_per_row((width + WORD_BITS - 1) / WORD_BITS)
+    , m_words(height * m_words_per_row, 0) {}
+
+size_t BitGrid::count() const {
+  size_t total{};
+  for (const Word word : m_words) {
+    total += size_t(std::popcount(word));
+  }
+  return total;
+}
+
+bool BitGrid::none() const {
+  for (const Word word : m_words) {
+    if (word != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BitGrid::clear() {
+  std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+static void check_same_size(const BitGrid &left, const BitGrid &right) {
+  if (left.height() != right.height() || left.width() != right.width()) {
+    throw std::runtime_error("BitGrids have to be the same size!");
+  }
+}
+
+BitGrid &BitGrid::operator|=(const BitGrid &other) {
+  check_same_size(*this, other);
+  for (size_t index = 0; index < m_words.size(); ++index) {
+    m_words[index] |= other.m_words[index];
+  }
+  return *this;
+}
+
+BitGrid &BitGrid::operator&=(const BitGrid &other) {
+  check_same_size(*this, other);
+  for (size_t index = 0; index < m_words.size(); ++index) {
+    m_words[index] &= other.m_words[index];
+  }
+  return *this;
+}
+
+void BitGrid::or_row(const size_t row, const BitGrid &other,
+                     const size_t other_row) {
+  if (m_width != other.m_width) {
+    throw std::runtime_error("BitGrid rows have to be the same width!");
+  }
+  Word *row_words = m_words.data() + row * m_words_per_row;
+  const Word *other_words = other.m_words.data() + other_row * m_words_per_row;
+  for (size_t index = 0; index < m_words_per_row; ++index) {
+    row_words[index] |= other_words[index];
+  }
+}
+
+void BitGrid::and_row(const size_t row, const BitGrid &other,
+                      const size_t other_row) {
+  if (m_width != other.m_width) {
+    throw std::runtime_error("BitGrid rows have to be the same width!");
+  }
+  Word *row_words = m_words.data() + row * m_words_per_row;
+  const Word *other_words = other.m_words.data() + other_row * m_words_per_row;
+  for (size_t index = 0; index < m_words_per_row; ++index) {
+    row_words[index] &= other_words[index];
+  }
+}
+
+BitGrid::Word BitGrid::last_word_mask() const {
+  const size_t used_bits = m_width % WORD_BITS;
+  return used_bits == 0 ? ~Word(0) : (Word(1) << used_bits) - 1;
+}
+
+void BitGrid::shift_columns(const FlatOffset offset) {
+  const size_t distance = size_t(offset < 0 ? -offset : offset);
+  if (distance == 0) {
+    return;
+  }
+  if (distance >= m_width) {
+    clear();
+    return;
+  }
+  const size_t word_shift = distance / WORD_BITS;
+  const size_t bit_shift = distance % WORD_BITS;
+
+  for (size_t row = 0; row < m_height; ++row) {
+    Word *row_words = m_words.data() + row * m_words_per_row;
+    // The word that ends up at index is built from the word word_shift before
+    // or after it, and the bits carried over from its neighbour
+    const auto source = [&](const size_t index) -> Word {
+      return index < m_words_per_row ? row_words[index] : 0;
+    };
+    if (offset > 0) {
+      for (size_t index = m_words_per_row; index-- > 0;) {
+        const size_t from = index - word_shift;
+        Word shifted{};
+        if (index >= word_shift) {
+          shifted = source(from) << bit_shift;
+          if (bit_shift != 0 && from > 0) {
+            shifted |= source(from - 1) >> (WORD_BITS - bit_shift);
+          }
+        }
+        row_words[index] = shifted;
+      }
+    } else {
+      for (size_t index = 0; index < m_words_per_row; ++index) {
+        const size_t from = index + word_shift;
+        Word shifted = source(from) >> bit_shift;
+        if (bit_shift != 0) {
+          shifted |= source(from + 1) << (WORD_BITS - bit_shift);
+        }
+        row_words[index] = shifted;
+      }
+    }
+    row_words[m_words_per_row - 1] &= last_word_mask();
+  }
+}
+
+void BitGrid::shift_rows(const FlatOffset offset) {
+  const size_t distance = size_t(offset < 0 ? -offset : offset);
+  if (distance >= m_height) {
+    clear();
+    return;
+  }
+  const size_t word_distance = distance * m_words_per_row;
+  if (offset > 0) {
+    std::copy_backward(m_words.begin(), m_words.end() - word_distance,
+                       m_words.end());
+    std::fill(m_words.begin(), m_words.begin() + word_distance, 0);
+  } else {
+    std::copy(m_words.begin() + word_distance, m_words.end(), m_words.begin());
+    std::fill(m_words.end() - word_distance, m_words.end(), 0);
+  }
+}
@@ -1,7 +1,8 @@
+#include <algorithm> // for max, copy, fill_n
 #include <core_lib.hpp>
-#include <fstream>   // for basic_ostream, endl, operator<<, basic_istream
-#include <iostream>  // for cout
-#include <stdexcept> // for runtime_error
+#include <input_view.hpp> // for InputView, Lines
+#include <iostream>       // for basic_ostream, endl, operator<<, cout
+#include <stdexcept>      // for runtime_error
 
 void greet_day(const char *day_number) {
   std::cout << "==============================================================="
@@ -14,17 +15,100 @@ void greet_day(const char *day_number) {
             << std::endl;
 }
 
+Grid get_lines(const InputView &input) {
+  const auto &lines = input.lines();
+
+  return Grid(lines.begin(), lines.end());
+}
+
 Grid get_lines_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+  const InputView input(filepath);
 
-  Grid output;
+  return get_lines(input);
+}
+
+FlatGrid::FlatGrid(const Coordinate height, const Coordinate width,
+                   const Tile fill, const Tile border)
+    : m_height(height)
+    , m_width(width)
+    , m_stride(width + 2)
+    , m_border(border)
+    , m_neighbour_offsets{-m_stride, 1, m_stride, -1}
+    , m_tiles((height + 2) * m_stride, border) {
+  for (Coordinate row{}; row < m_height; ++row) {
+    std::fill_n(m_tiles.begin() + to_index(row, 0), m_width, fill);
+  }
+}
+
+template <typename LinesType>
+static Coordinate get_longest_line(const LinesType &lines) {
+  size_t longest_line{};
+  for (const auto &line : lines) {
+    longest_line = std::max(longest_line, line.size());
+  }
+  return Coordinate(longest_line);
+}
+
+FlatGrid::FlatGrid(const Grid &grid, const Tile border)
+    : FlatGrid(Coordinate(grid.size()), get_longest_line(grid), border,
+               border) {
+  // Ragged rows are left padded out with the border tile
+  for (Coordinate row{}; row < m_height; ++row) {
+    std::copy(grid[row].begin(), grid[row].end(),
+              m_tiles.begin() + to_index(row, 0));
+  }
+}
 
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
-    output.push_back(line);
+FlatGrid::FlatGrid(const Lines &lines, const Tile border)
+    : FlatGrid(Coordinate(lines.size()), get_longest_line(lines), border,
+               border) {
+  for (Coordinate row{}; row < m_height; ++row) {
+    std::copy(lines[row].begin(), lines[row].end(),
+              m_tiles.begin() + to_index(row, 0));
+  }
+}
+
+FlatIndex FlatGrid::find(const Tile tile) const {
+  for (Coordinate row{}; row < m_height; ++row) {
+    for (FlatIndex index = to_index(row, 0); index < to_index(row, m_width);
+         ++index) {
+      if (m_tiles[index] == tile) {
+        return index;
+      }
+    }
+  }
+  throw std::runtime_error(std::string("Expected to find tile: ") + tile);
+}
+
+std::vector<FlatIndex> FlatGrid::interior_indices() const {
+  std::vector<FlatIndex> output;
+  output.reserve(m_height * m_width);
+  for (Coordinate row{}; row < m_height; ++row) {
+    for (FlatIndex index = to_index(row, 0); index < to_index(row, m_width);
+         ++index) {
+      output.push_back(index);
+    }
+  }
+  return output;
+}
+
+Grid FlatGrid::to_grid() const {
+  Grid output;
+  output.reserve(m_height);
+  for (Coordinate row{}; row < m_height; ++row) {
+    output.emplace_back(m_tiles.begin() + to_index(row, 0),
+                        m_tiles.begin() + to_index(row, m_width));
   }
   return output;
 }
 
+FlatGrid get_flat_grid_from_file(const std::string &filepath,
+                                 const Tile border) {
+  const InputView input(filepath);
+
+  return FlatGrid(input.lines(), border);
+}
+
 void print_lines(const Grid &lines) {
 
   for (const auto &line : lines) {
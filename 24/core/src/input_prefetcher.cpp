@@ -0,0 +1,456 @@
+#include <algorithm>            // for min, max
+#include <cerrno>               // for errno, EINTR, EINVAL
+#include <cstdlib>              // for getenv
+#include <cstring>              // for strerror
+#include <exception>            // for exception
+#include <fcntl.h>              // for open, O_CLOEXEC, O_RDONLY
+#include <input_prefetcher.hpp> // for InputPrefetcher
+#include <memory>               // for unique_ptr, make_unique
+#include <mutex>                // for lock_guard, unique_lock, mutex
+#include <optional>             // for optional, nullopt
+#include <stdexcept>            // for runtime_error
+#include <string>               // for string, operator+, operator!=
+#include <sys/stat.h>           // for fstat, stat
+#include <sys/types.h>          // for off_t, ssize_t
+#include <unistd.h>             // for close, pread
+#include <utility>              // for move
+#include <vector>               // for vector
+
+#ifdef __linux__
+#include <atomic>           // for atomic_ref, memory_order_acquire, memo...
+#include <cstdint>          // for uint64_t, uintptr_t
+#include <linux/io_uring.h> // for io_uring_sqe, io_uring_cqe, io_uring_p...
+#include <sys/mman.h>       // for mmap, munmap, MAP_FAILED, MAP_POPULATE
+#include <sys/syscall.h>    // for SYS_io_uring_enter, SYS_io_uring_setup
+#endif
+
+// Reads are split into pieces no bigger than this, which fits both the 32 bit
+// length of an io_uring read and what Linux will pread in one go
+constexpr size_t MAX_READ_BYTES = size_t(1) << 30;
+
+// Past this many threads blocked in pread, more only queue up in the kernel
+constexpr size_t MAX_PREAD_THREADS = 16;
+
+// Opens filepath, filling in its size
+static int open_for_reading(const std::string &filepath, size_t &size) {
+  const int file_descriptor = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_descriptor < 0) {
+    throw std::runtime_error("Unable to open file: " + filepath);
+  }
+  struct stat file_stat {};
+  if (::fstat(file_descriptor, &file_stat) != 0) {
+    ::close(file_descriptor);
+    throw std::runtime_error("Unable to stat file: " + filepath);
+  }
+  size = size_t(file_stat.st_size);
+  return file_descriptor;
+}
+
+static std::string read_error(const std::string &filepath, const int error) {
+  return "Unable to read file: " + filepath + ": " + std::strerror(error);
+}
+
+// Reads the file from offset up to size into buffer, returning where it got
+// to, which is short of size only if the file shrank since it was opened
+static size_t pread_rest(const int file_descriptor, char *buffer,
+                         const size_t size, size_t offset,
+                         const std::string &filepath) {
+  while (offset < size) {
+    const ssize_t num_read =
+        ::pread(file_descriptor, buffer + offset,
+                std::min(size - offset, MAX_READ_BYTES), off_t(offset));
+    if (num_read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(read_error(filepath, errno));
+    }
+    if (num_read == 0) {
+      break;
+    }
+    offset += size_t(num_read);
+  }
+  return offset;
+}
+
+static InputView pread_file(const std::string &filepath) {
+  size_t size{};
+  const int file_descriptor = open_for_reading(filepath, size);
+  // Left uninitialized, every byte kept is read over
+  std::unique_ptr<char[]> buffer(new char[size]);
+  try {
+    size = pread_rest(file_descriptor, buffer.get(), size, 0, filepath);
+  } catch (...) {
+    ::close(file_descriptor);
+    throw;
+  }
+  ::close(file_descriptor);
+  return InputView(std::move(buffer), size);
+}
+
+#ifdef __linux__
+
+static bool io_uring_enabled() {
+  const char *setting = std::getenv("AOC_IO_URING");
+  return setting == nullptr || std::string(setting) != "0";
+}
+
+// Just enough of io_uring to queue reads and collect their results, straight
+// on the rings shared with the kernel. Only ever used from one thread.
+class InputPrefetcher::IoUring {
+public:
+  // Throws if the kernel will not set up a ring
+  explicit IoUring(const unsigned entries) {
+    io_uring_params params{};
+    m_ring_fd = int(::syscall(SYS_io_uring_setup, entries, &params));
+    if (m_ring_fd < 0) {
+      throw std::runtime_error(std::string("io_uring unavailable: ") +
+                               std::strerror(errno));
+    }
+
+    m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cq_ring_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    // Since 5.4 both rings come from the one mapping
+    const bool single_mapping = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mapping) {
+      m_sq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+      m_cq_ring_size = m_sq_ring_size;
+    }
+    m_sq_ring = map(m_sq_ring_size, IORING_OFF_SQ_RING);
+    m_cq_ring =
+        single_mapping ? m_sq_ring : map(m_cq_ring_size, IORING_OFF_CQ_RING);
+    m_sqes = static_cast<io_uring_sqe *>(map(m_sqes_size, IORING_OFF_SQES));
+    if (m_sq_ring == nullptr || m_cq_ring == nullptr || m_sqes == nullptr) {
+      release();
+      throw std::runtime_error("Unable to map io_uring rings!");
+    }
+
+    char *sq_ring = static_cast<char *>(m_sq_ring);
+    m_sq_head = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.head);
+    m_sq_tail = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.tail);
+    m_sq_mask =
+        *reinterpret_cast<unsigned *>(sq_ring + params.sq_off.ring_mask);
+    m_sq_array = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.array);
+    m_sq_entries = params.sq_entries;
+
+    char *cq_ring = static_cast<char *>(m_cq_ring);
+    m_cq_head = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.head);
+    m_cq_tail = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.tail);
+    m_cq_mask =
+        *reinterpret_cast<unsigned *>(cq_ring + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe *>(cq_ring + params.cq_off.cqes);
+  }
+
+  IoUring(const IoUring &) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+
+  ~IoUring() {
+    release();
+  }
+
+  // Queues a read of length bytes of the file at offset into buffer, whose
+  // result comes back with tag. Nothing is sent to the kernel until the next
+  // submit_and_wait.
+  void queue_read(const int file_descriptor, char *buffer,
+                  const unsigned length, const uint64_t offset,
+                  const uint64_t tag) {
+    // Only this side moves the tail, the kernel moves the head
+    const unsigned tail = *m_sq_tail;
+    const unsigned head =
+        std::atomic_ref<unsigned>(*m_sq_head).load(std::memory_order_acquire);
+    if (tail - head >= m_sq_entries) {
+      throw std::runtime_error("io_uring submission queue is full!");
+    }
+    const unsigned slot = tail & m_sq_mask;
+    io_uring_sqe &entry = m_sqes[slot];
+    entry = io_uring_sqe{};
+    entry.opcode = IORING_OP_READ;
+    entry.fd = file_descriptor;
+    entry.addr = uint64_t(reinterpret_cast<uintptr_t>(buffer));
+    entry.len = length;
+    entry.off = offset;
+    entry.user_data = tag;
+    m_sq_array[slot] = slot;
+    std::atomic_ref<unsigned>(*m_sq_tail)
+        .store(tail + 1, std::memory_order_release);
+    ++m_num_queued;
+  }
+
+  // Sends the kernel everything queued and waits for at least one result
+  void submit_and_wait() {
+    while (true) {
+      const int num_submitted =
+          int(::syscall(SYS_io_uring_enter, m_ring_fd, m_num_queued, 1,
+                        IORING_ENTER_GETEVENTS, nullptr, 0));
+      if (num_submitted >= 0) {
+        m_num_queued -= unsigned(num_submitted);
+        return;
+      }
+      if (errno != EINTR) {
+        throw std::runtime_error(std::string("io_uring_enter failed: ") +
+                                 std::strerror(errno));
+      }
+    }
+  }
+
+  // The oldest result not yet taken, returning false if there is none: the
+  // tag of the read, and the number of bytes read or minus the errno
+  bool pop_completion(uint64_t &tag, int &result) {
+    // Only this side moves the head, the kernel moves the tail
+    const unsigned head = *m_cq_head;
+    const unsigned tail =
+        std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire);
+    if (head == tail) {
+      return false;
+    }
+    const io_uring_cqe &entry = m_cqes[head & m_cq_mask];
+    tag = entry.user_data;
+    result = entry.res;
+    std::atomic_ref<unsigned>(*m_cq_head)
+        .store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  void *map(const size_t size, const off_t offset) {
+    void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, m_ring_fd, offset);
+    return mapping == MAP_FAILED ? nullptr : mapping;
+  }
+
+  void release() {
+    if (m_sqes != nullptr) {
+      ::munmap(m_sqes, m_sqes_size);
+    }
+    if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring) {
+      ::munmap(m_cq_ring, m_cq_ring_size);
+    }
+    if (m_sq_ring != nullptr) {
+      ::munmap(m_sq_ring, m_sq_ring_size);
+    }
+    ::close(m_ring_fd);
+  }
+
+  int m_ring_fd = -1;
+  void *m_sq_ring{};
+  void *m_cq_ring{};
+  io_uring_sqe *m_sqes{};
+  size_t m_sq_ring_size{};
+  size_t m_cq_ring_size{};
+  size_t m_sqes_size{};
+
+  unsigned *m_sq_head{};
+  unsigned *m_sq_tail{};
+  unsigned *m_sq_array{};
+  unsigned m_sq_mask{};
+  unsigned m_sq_entries{};
+  unsigned m_num_queued{};
+
+  unsigned *m_cq_head{};
+  unsigned *m_cq_tail{};
+  unsigned m_cq_mask{};
+  io_uring_cqe *m_cqes{};
+};
+
+// A file with a read on the ring
+struct PendingRead {
+  int file_descriptor = -1;
+  std::unique_ptr<char[]> buffer;
+  size_t size{};
+  size_t num_read{};
+};
+
+void InputPrefetcher::load_with_io_uring(IoUring &ring) {
+  std::vector<PendingRead> pending(m_filepaths.size());
+  size_t next_file{};
+  size_t num_in_flight{};
+
+  const auto queue_next_piece = [&](const size_t index) {
+    PendingRead &read = pending[index];
+    ring.queue_read(read.file_descriptor, read.buffer.get() + read.num_read,
+                    unsigned(std::min(read.size - read.num_read,
+                                      MAX_READ_BYTES)),
+                    read.num_read, index);
+  };
+
+  const auto complete = [&](const size_t index, const std::string &error) {
+    PendingRead &read = pending[index];
+    ::close(read.file_descriptor);
+    Loaded loaded{index, m_filepaths[index], std::nullopt, error};
+    if (error.empty()) {
+      loaded.input.emplace(std::move(read.buffer), read.num_read);
+    }
+    finish(std::move(loaded));
+    read = PendingRead{};
+    --num_in_flight;
+  };
+
+  while (true) {
+    // Starts as many more files as there is room for, only waiting for room
+    // when there is no read in flight to wait on instead
+    while (next_file < m_filepaths.size() && reserve(num_in_flight == 0)) {
+      const size_t index = next_file++;
+      PendingRead &read = pending[index];
+      try {
+        read.file_descriptor = open_for_reading(m_filepaths[index], read.size);
+      } catch (const std::exception &error) {
+        finish({index, m_filepaths[index], std::nullopt, error.what()});
+        continue;
+      }
+      ++num_in_flight;
+      if (read.size == 0) {
+        complete(index, {});
+        continue;
+      }
+      read.buffer.reset(new char[read.size]);
+      queue_next_piece(index);
+    }
+    // Either every file has been read or the prefetcher is going away
+    if (num_in_flight == 0) {
+      return;
+    }
+
+    ring.submit_and_wait();
+    uint64_t tag{};
+    int result{};
+    while (ring.pop_completion(tag, result)) {
+      const size_t index = size_t(tag);
+      PendingRead &read = pending[index];
+      if (result == -EINVAL) {
+        // Kernels before 5.6 have io_uring but cannot read a file on it
+        try {
+          read.num_read = pread_rest(read.file_descriptor, read.buffer.get(),
+                                     read.size, read.num_read,
+                                     m_filepaths[index]);
+        } catch (const std::exception &error) {
+          complete(index, error.what());
+          continue;
+        }
+      } else if (result < 0) {
+        complete(index, read_error(m_filepaths[index], -result));
+        continue;
+      } else if (result > 0) {
+        read.num_read += size_t(result);
+        if (read.num_read < read.size) {
+          queue_next_piece(index);
+          continue;
+        }
+      }
+      // Nothing read means the file shrank since it was opened, so it ends
+      // where the read got to
+      complete(index, {});
+    }
+  }
+}
+
+#endif
+
+InputPrefetcher::InputPrefetcher(std::vector<std::string> filepaths,
+                                 const size_t max_in_flight)
+    : m_filepaths(std::move(filepaths))
+    , m_max_in_flight(std::max(size_t(1), max_in_flight))
+    , m_backend("pread") {
+  if (m_filepaths.empty()) {
+    return;
+  }
+
+#ifdef __linux__
+  if (io_uring_enabled()) {
+    try {
+      // Every file in flight has at most one read queued, so a ring as big as
+      // max_in_flight never fills up
+      auto ring = std::make_unique<IoUring>(unsigned(m_max_in_flight));
+      m_backend = "io_uring";
+      m_threads.emplace_back(
+          [this, ring = std::move(ring)]() { load_with_io_uring(*ring); });
+      return;
+    } catch (const std::runtime_error &) {
+      // Fall back to pread
+    }
+  }
+#endif
+
+  const size_t num_threads =
+      std::min({m_filepaths.size(), m_max_in_flight, MAX_PREAD_THREADS});
+  for (size_t index = 0; index < num_threads; ++index) {
+    m_threads.emplace_back([this]() { load_with_pread(); });
+  }
+}
+
+InputPrefetcher::~InputPrefetcher() {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_room_changed.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+std::optional<InputPrefetcher::Loaded> InputPrefetcher::next() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_ready_changed.wait(lock, [&]() {
+    return !m_ready.empty() || m_num_handed_out == m_filepaths.size();
+  });
+  if (m_ready.empty()) {
+    return std::nullopt;
+  }
+  Loaded loaded = std::move(m_ready.front());
+  m_ready.pop_front();
+  --m_num_outstanding;
+  ++m_num_handed_out;
+  if (m_num_handed_out == m_filepaths.size()) {
+    // Anyone else waiting has nothing left to wait for
+    m_ready_changed.notify_all();
+  }
+  m_room_changed.notify_one();
+  return loaded;
+}
+
+void InputPrefetcher::load_with_pread() {
+  while (true) {
+    size_t index{};
+    {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_next_file == m_filepaths.size()) {
+        return;
+      }
+      index = m_next_file++;
+    }
+    if (!reserve(true)) {
+      return;
+    }
+    Loaded loaded{index, m_filepaths[index], std::nullopt, {}};
+    try {
+      loaded.input.emplace(pread_file(loaded.filepath));
+    } catch (const std::exception &error) {
+      loaded.error = error.what();
+    }
+    finish(std::move(loaded));
+  }
+}
+
+bool InputPrefetcher::reserve(const bool wait) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (wait) {
+    m_room_changed.wait(lock, [&]() {
+      return m_stopping || m_num_outstanding < m_max_in_flight;
+    });
+  }
+  if (m_stopping || m_num_outstanding >= m_max_in_flight) {
+    return false;
+  }
+  ++m_num_outstanding;
+  return true;
+}
+
+void InputPrefetcher::finish(Loaded loaded) {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_ready.push_back(std::move(loaded));
+  }
+  m_ready_changed.notify_one();
+}
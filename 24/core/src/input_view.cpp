@@ -0,0 +1,97 @@
+#include <algorithm>      // for count
+#include <fcntl.h>        // for open, O_RDONLY
+#include <input_view.hpp> // for InputView, Lines
+#include <memory>         // for unique_ptr
+#include <stdexcept>      // for runtime_error
+#include <sys/mman.h>     // for mmap, munmap, posix_madvise, MAP_FAILED
+#include <sys/stat.h>     // for fstat, stat
+#include <unistd.h>       // for close
+#include <utility>        // for exchange, move
+
+InputView::InputView(const std::string &filepath) {
+  const int file_descriptor = ::open(filepath.c_str(), O_RDONLY);
+  if (file_descriptor < 0) {
+    throw std::runtime_error("Unable to open file: " + filepath);
+  }
+
+  struct stat file_stat {};
+  if (::fstat(file_descriptor, &file_stat) != 0) {
+    ::close(file_descriptor);
+    throw std::runtime_error("Unable to stat file: " + filepath);
+  }
+  m_size = size_t(file_stat.st_size);
+
+  // Mapping zero bytes is an error, an empty file is just an empty view
+  if (m_size > 0) {
+    void *mapping =
+        ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(file_descriptor);
+      throw std::runtime_error("Unable to map file: " + filepath);
+    }
+    ::posix_madvise(mapping, m_size, POSIX_MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(mapping);
+  }
+
+  // The mapping keeps its own reference to the file
+  ::close(file_descriptor);
+}
+
+InputView::InputView(std::unique_ptr<char[]> buffer, const size_t size)
+    : m_data(buffer.get()), m_size(size), m_buffer(std::move(buffer)) {}
+
+InputView::InputView(InputView &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_buffer(std::move(other.m_buffer))
+    , m_lines(std::move(other.m_lines))
+    , m_has_lines(std::exchange(other.m_has_lines, false)) {}
+
+InputView &InputView::operator=(InputView &&other) noexcept {
+  if (this != &other) {
+    release();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_buffer = std::move(other.m_buffer);
+    m_lines = std::move(other.m_lines);
+    m_has_lines = std::exchange(other.m_has_lines, false);
+  }
+  return *this;
+}
+
+InputView::~InputView() {
+  release();
+}
+
+void InputView::release() {
+  if (m_buffer) {
+    m_buffer.reset();
+  } else if (m_data != nullptr) {
+    ::munmap(const_cast<char *>(m_data), m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_lines.clear();
+  m_has_lines = false;
+}
+
+const Lines &InputView::lines() const {
+  if (m_has_lines) {
+    return m_lines;
+  }
+
+  const std::string_view buffer = data();
+  m_lines.reserve(std::count(buffer.begin(), buffer.end(), '\n') + 1);
+  size_t pos{};
+  while (pos < buffer.size()) {
+    size_t newline = buffer.find('\n', pos);
+    if (newline == std::string_view::npos) {
+      newline = buffer.size();
+    }
+    m_lines.push_back(buffer.substr(pos, newline - pos));
+    pos = newline + 1;
+  }
+  m_has_lines = true;
+
+  return m_lines;
+}
@@ -0,0 +1,132 @@
+#ifdef AOC_INSTRUMENT
+
+#include <chrono>         // for duration, steady_clock
+#include <cstring>        // for strcmp
+#include <instrument.hpp> // for Node, enter, leave, count
+#include <iomanip>        // for operator<<, setw, setprecision
+#include <ios>            // for fixed, left, right
+#include <iostream>       // for basic_ostream, operator<<, endl, cerr
+#include <memory>         // for unique_ptr, make_unique
+#include <mutex>          // for mutex, lock_guard
+#include <string>         // for string
+#include <vector>         // for vector
+
+namespace instrument {
+
+struct Node {
+  const char *name{};
+  Node *parent{};
+  std::size_t calls{};
+  double total_ns{};
+  std::size_t count{};
+  // Held by pointer so that the Node pointers handed out stay valid as
+  // children are added. Searched linearly, since scopes only have a handful
+  // of children and this keeps entering a scope cheap.
+  std::vector<std::unique_ptr<Node>> children;
+
+  Node *child(const char *child_name) {
+    for (const auto &existing : children) {
+      if (existing->name == child_name ||
+          std::strcmp(existing->name, child_name) == 0) {
+        return existing.get();
+      }
+    }
+    children.push_back(std::make_unique<Node>());
+    children.back()->name = child_name;
+    children.back()->parent = this;
+    return children.back().get();
+  }
+
+  void merge(const Node &other) {
+    calls += other.calls;
+    total_ns += other.total_ns;
+    count += other.count;
+    for (const auto &other_child : other.children) {
+      child(other_child->name)->merge(*other_child);
+    }
+  }
+};
+
+void print(const Node &node, const size_t depth) {
+  const std::string label = std::string(2 * depth, ' ') + node.name;
+  std::cerr << std::left << std::setw(40) << label << std::right;
+  if (node.calls > 0) {
+    std::cerr << std::setw(12) << node.calls << " calls" << std::setw(12)
+              << node.total_ns / 1e6 << " ms";
+  }
+  if (node.count > 0) {
+    std::cerr << std::setw(14) << node.count << " counted";
+  }
+  std::cerr << std::endl;
+  for (const auto &child : node.children) {
+    print(*child, depth + 1);
+  }
+}
+
+// What every thread has handed over on exit, printed once all of them have
+class Report {
+public:
+  void merge(const Node &thread_root) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_root.merge(thread_root);
+  }
+
+  ~Report() {
+    if (m_root.children.empty()) {
+      return;
+    }
+    std::cerr << std::fixed << std::setprecision(3);
+    std::cerr << "Instrumentation report" << std::endl;
+    for (const auto &child : m_root.children) {
+      print(*child, 0);
+    }
+  }
+
+private:
+  std::mutex m_mutex;
+  Node m_root{"root"};
+};
+
+Report &report() {
+  static Report instance;
+  return instance;
+}
+
+struct ThreadTree {
+  // Constructing the report first makes sure it is destroyed, and so printed,
+  // only after every thread has merged into it
+  ThreadTree() : current(&root) {
+    report();
+  }
+
+  ~ThreadTree() {
+    report().merge(root);
+  }
+
+  Node root{"root"};
+  Node *current;
+};
+
+thread_local ThreadTree thread_tree;
+
+Node *enter(const char *name) {
+  Node *node = thread_tree.current->child(name);
+  thread_tree.current = node;
+  return node;
+}
+
+void leave(Node *node, const std::chrono::steady_clock::time_point start) {
+  node->total_ns += std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+  ++node->calls;
+  thread_tree.current = node->parent;
+}
+
+void count(const char *name, const std::size_t amount) {
+  thread_tree.current->child(name)->count += amount;
+}
+
+} // namespace instrument
+
+#endif
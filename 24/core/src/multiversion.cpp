@@ -0,0 +1,16 @@
+#include <multiversion.hpp> // for multiversion_level, AOC_MULTIVERSIONED
+
+const char *multiversion_level() {
+#ifdef AOC_MULTIVERSIONED
+  // Checked in the same order as the loader picks clones in
+  if (__builtin_cpu_supports("x86-64-v4")) {
+    return "x86-64-v4";
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return "avx2";
+  }
+  return "default";
+#else
+  return "single build";
+#endif
+}
@@ -0,0 +1,207 @@
+#include <cstdint>           // for uint64_t
+#include <iomanip>           // for operator<<, setprecision
+#include <ios>               // for fixed
+#include <optional>          // for optional, nullopt
+#include <perf_counters.hpp> // for PerfCounters
+#include <sstream>           // for basic_ostream, operator<<, stringstream
+#include <string>            // for string, operator+
+
+#ifdef __linux__
+#include <cerrno>             // for errno
+#include <cstring>            // for strerror, memset
+#include <linux/perf_event.h> // for perf_event_attr, PERF_TYPE_HARDWARE, ...
+#include <sys/ioctl.h>        // for ioctl
+#include <sys/syscall.h>      // for SYS_perf_event_open
+#include <unistd.h>           // for syscall, close, read
+#endif
+
+#ifdef __linux__
+
+// In the order of PerfCounters::Event, as are the configs below
+constexpr const char *EVENT_NAMES[PerfCounters::NUM_EVENTS] = {
+    "cycles",
+    "instructions",
+    "L1D misses",
+    "LLC misses",
+    "branches",
+    "branch misses",
+};
+
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr uint64_t cache_read_misses(const uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr EventConfig EVENT_CONFIGS[PerfCounters::NUM_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_read_misses(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cache_read_misses(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+static int open_event(const EventConfig &event, const int group_leader) {
+  perf_event_attr attributes;
+  std::memset(&attributes, 0, sizeof(attributes));
+  attributes.size = sizeof(attributes);
+  attributes.type = event.type;
+  attributes.config = event.config;
+  // Only the leader starts disabled, the rest follow it
+  attributes.disabled = group_leader < 0 ? 1 : 0;
+  // User space only, which is also all an unprivileged process may count
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return int(::syscall(SYS_perf_event_open, &attributes, 0, -1, group_leader,
+                       0));
+}
+
+PerfCounters::PerfCounters() {
+  m_file_descriptors.fill(-1);
+
+  m_file_descriptors[CYCLES] = open_event(EVENT_CONFIGS[CYCLES], -1);
+  if (m_file_descriptors[CYCLES] < 0) {
+    m_status = std::string("counters unavailable: ") + std::strerror(errno);
+    return;
+  }
+
+  for (size_t event = CYCLES + 1; event < NUM_EVENTS; ++event) {
+    m_file_descriptors[event] =
+        open_event(EVENT_CONFIGS[event], m_file_descriptors[CYCLES]);
+    if (m_file_descriptors[event] < 0) {
+      m_status += std::string(m_status.empty() ? "not counting " : ", ") +
+                  EVENT_NAMES[event];
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (const int file_descriptor : m_file_descriptors) {
+    if (file_descriptor >= 0) {
+      ::close(file_descriptor);
+    }
+  }
+}
+
+void PerfCounters::start() {
+  if (!is_available()) {
+    return;
+  }
+  ::ioctl(m_file_descriptors[CYCLES], PERF_EVENT_IOC_RESET,
+          PERF_IOC_FLAG_GROUP);
+  ::ioctl(m_file_descriptors[CYCLES], PERF_EVENT_IOC_ENABLE,
+          PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::Readings PerfCounters::stop() {
+  Readings readings;
+  if (!is_available()) {
+    return readings;
+  }
+  ::ioctl(m_file_descriptors[CYCLES], PERF_EVENT_IOC_DISABLE,
+          PERF_IOC_FLAG_GROUP);
+
+  // Number of values, time enabled, time running, then one value per counter
+  // in the group, in the order they were opened
+  uint64_t buffer[3 + NUM_EVENTS]{};
+  if (::read(m_file_descriptors[CYCLES], buffer, sizeof(buffer)) <= 0) {
+    return readings;
+  }
+  const uint64_t time_enabled = buffer[1];
+  const uint64_t time_running = buffer[2];
+  if (time_running == 0) {
+    // Never got scheduled onto the PMU, so there is nothing to scale
+    return readings;
+  }
+  readings.m_running_fraction = double(time_running) / double(time_enabled);
+
+  size_t value_index = 3;
+  for (size_t event = 0; event < NUM_EVENTS; ++event) {
+    if (m_file_descriptors[event] < 0) {
+      continue;
+    }
+    readings.m_values[event] =
+        uint64_t(double(buffer[value_index]) / readings.m_running_fraction);
+    readings.m_has_value[event] = true;
+    ++value_index;
+  }
+  return readings;
+}
+
+#else
+
+PerfCounters::PerfCounters() : m_status("counters unavailable: not Linux") {
+  m_file_descriptors.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+PerfCounters::Readings PerfCounters::stop() {
+  return {};
+}
+
+#endif
+
+std::optional<double> PerfCounters::Readings::instructions_per_cycle() const {
+  if (!m_has_value[CYCLES] || !m_has_value[INSTRUCTIONS] ||
+      m_values[CYCLES] == 0) {
+    return std::nullopt;
+  }
+  return double(m_values[INSTRUCTIONS]) / double(m_values[CYCLES]);
+}
+
+std::optional<double>
+PerfCounters::Readings::misses_per_kilo_instruction(const Event misses) const {
+  if (!m_has_value[misses] || !m_has_value[INSTRUCTIONS] ||
+      m_values[INSTRUCTIONS] == 0) {
+    return std::nullopt;
+  }
+  return 1000.0 * double(m_values[misses]) / double(m_values[INSTRUCTIONS]);
+}
+
+std::optional<double> PerfCounters::Readings::branch_miss_percent() const {
+  if (!m_has_value[BRANCH_MISSES] || !m_has_value[BRANCHES] ||
+      m_values[BRANCHES] == 0) {
+    return std::nullopt;
+  }
+  return 100.0 * double(m_values[BRANCH_MISSES]) / double(m_values[BRANCHES]);
+}
+
+std::string PerfCounters::Readings::summary() const {
+  if (!m_has_value[CYCLES]) {
+    return "no counts";
+  }
+
+  std::stringstream output;
+  output << std::fixed << std::setprecision(2);
+  output << "cycles " << m_values[CYCLES];
+  if (m_has_value[INSTRUCTIONS]) {
+    output << ", instructions " << m_values[INSTRUCTIONS];
+  }
+  if (const auto ipc = instructions_per_cycle()) {
+    output << ", IPC " << *ipc;
+  }
+  if (const auto mpki = misses_per_kilo_instruction(L1D_MISSES)) {
+    output << ", L1D MPKI " << *mpki;
+  }
+  if (const auto mpki = misses_per_kilo_instruction(LLC_MISSES)) {
+    output << ", LLC MPKI " << *mpki;
+  }
+  if (const auto percent = branch_miss_percent()) {
+    output << ", branch misses " << *percent << "%";
+  }
+  if (m_running_fraction < 1.0) {
+    output << " (scaled from " << 100.0 * m_running_fraction
+           << "% of the time)";
+  }
+  return output.str();
+}
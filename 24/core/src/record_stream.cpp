@@ -0,0 +1,128 @@
+#include <algorithm>         // for max
+#include <cstring>           // for memmove
+#include <fcntl.h>           // for open, posix_fadvise, O_RDONLY, POSIX_FA...
+#include <generator.hpp>     // for Generator
+#include <record_stream.hpp> // for stream_record_text
+#include <stdexcept>         // for runtime_error
+#include <string>            // for string, operator+
+#include <string_view>       // for string_view
+#include <sys/types.h>       // for off_t, ssize_t
+#include <unistd.h>          // for close, read
+#include <utility>           // for exchange, move
+#include <vector>            // for vector
+
+// Owns an open file, so that it is closed along with the coroutine frame
+// however far the records were read
+class FileDescriptor {
+public:
+  explicit FileDescriptor(const int file_descriptor)
+      : m_file_descriptor(file_descriptor) {}
+
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+  FileDescriptor(FileDescriptor &&other) noexcept
+      : m_file_descriptor(std::exchange(other.m_file_descriptor, -1)) {}
+
+  ~FileDescriptor() {
+    if (m_file_descriptor >= 0) {
+      ::close(m_file_descriptor);
+    }
+  }
+
+  int get() const {
+    return m_file_descriptor;
+  }
+
+private:
+  int m_file_descriptor;
+};
+
+// Fills buffer from offset onwards, as far as the file goes. Returns how many
+// bytes were read, which is short only at the end of the file.
+static size_t read_fully(const FileDescriptor &file, std::vector<char> &buffer,
+                         const size_t offset) {
+  size_t total{};
+  while (offset + total < buffer.size()) {
+    const ssize_t num_read = ::read(file.get(), buffer.data() + offset + total,
+                                    buffer.size() - offset - total);
+    if (num_read < 0) {
+      throw std::runtime_error("Unable to read input file");
+    }
+    if (num_read == 0) {
+      break;
+    }
+    total += size_t(num_read);
+  }
+  return total;
+}
+
+static Generator<std::string_view> read_records(FileDescriptor file,
+                                                const std::string separator,
+                                                const size_t chunk_size) {
+  // Whatever is left over of the last chunk is moved to the front of the
+  // buffer, and the next chunk read in after it
+  std::vector<char> buffer(chunk_size);
+  size_t num_buffered{};
+  // Only read for the read ahead hint, where there is one
+  [[maybe_unused]] off_t file_offset{};
+  bool at_end_of_file = false;
+
+  while (!at_end_of_file) {
+    if (num_buffered == buffer.size()) {
+      // A record longer than everything buffered so far
+      buffer.resize(buffer.size() * 2);
+    }
+    const size_t num_read = read_fully(file, buffer, num_buffered);
+    at_end_of_file = num_buffered + num_read < buffer.size();
+    file_offset += off_t(num_read);
+#ifdef POSIX_FADV_WILLNEED
+    if (!at_end_of_file) {
+      // Have the kernel start on the next chunk while this one is split up
+      ::posix_fadvise(file.get(), file_offset, off_t(chunk_size),
+                      POSIX_FADV_WILLNEED);
+    }
+#endif
+    num_buffered += num_read;
+
+    const std::string_view text(buffer.data(), num_buffered);
+    size_t start{};
+    while (true) {
+      const size_t end = text.find(separator, start);
+      if (end == std::string_view::npos) {
+        break;
+      }
+      co_yield text.substr(start, end - start);
+      start = end + separator.size();
+    }
+
+    if (at_end_of_file) {
+      if (start < text.size()) {
+        co_yield text.substr(start);
+      }
+      break;
+    }
+
+    std::memmove(buffer.data(), buffer.data() + start, num_buffered - start);
+    num_buffered -= start;
+  }
+}
+
+Generator<std::string_view> stream_record_text(const std::string &filepath,
+                                               const std::string_view separator,
+                                               const size_t chunk_size) {
+  if (separator.empty()) {
+    throw std::runtime_error("Record separator cannot be empty");
+  }
+  FileDescriptor file(::open(filepath.c_str(), O_RDONLY));
+  if (file.get() < 0) {
+    throw std::runtime_error("Unable to open file: " + filepath);
+  }
+#ifdef POSIX_FADV_SEQUENTIAL
+  // Read front to back once, so the kernel can read ahead further and drop
+  // pages behind. Both hints are missing on macOS, which reads ahead anyway.
+  ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  return read_records(std::move(file), std::string(separator),
+                      std::max(chunk_size, separator.size()));
+}
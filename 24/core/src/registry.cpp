@@ -0,0 +1,43 @@
+#include <algorithm>    // for lower_bound
+#include <registry.hpp> // for RegisteredDay, DayRegistrar, RunDay, Solv...
+#include <stdexcept>    // for runtime_error
+#include <string>       // for string, operator+, operator<, operator==
+#include <vector>       // for vector
+
+// A function local static, so that it is built before the first registrar
+// uses it whatever order the registration objects are initialized in
+static std::vector<RegisteredDay> &mutable_registered_days() {
+  static std::vector<RegisteredDay> days;
+  return days;
+}
+
+static std::vector<RegisteredDay>::const_iterator
+lower_bound_of(const std::vector<RegisteredDay> &days, const std::string &id) {
+  return std::lower_bound(days.begin(), days.end(), id,
+                          [](const RegisteredDay &day, const std::string &id) {
+                            return day.id < id;
+                          });
+}
+
+const std::vector<RegisteredDay> &registered_days() {
+  return mutable_registered_days();
+}
+
+const RegisteredDay *find_registered_day(const std::string &id) {
+  const auto &days = registered_days();
+  const auto found = lower_bound_of(days, id);
+  if (found == days.end() || found->id != id) {
+    return nullptr;
+  }
+  return &*found;
+}
+
+DayRegistrar::DayRegistrar(const std::string &id, const std::string &build_id,
+                           const RunDay run, const SolveDay solve) {
+  auto &days = mutable_registered_days();
+  const auto position = lower_bound_of(days, id);
+  if (position != days.end() && position->id == id) {
+    throw std::runtime_error("Day registered twice: " + id);
+  }
+  days.insert(position, RegisteredDay{id, build_id, run, solve});
+}
@@ -1,74 +1,697 @@
-#include <_stdlib.h> // for abs
-#include <algorithm> // for sort
-#include <cmath>     // for abs
-#include <cstdlib>   // for size_t
+#include <algorithm>  // for max, min, max_element, clamp, lower_bound
+#include <array>      // for array
+#include <bit>        // for bit_width
+#include <cerrno>     // for errno, EINTR
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint64_t, uint32_t, int64_t, UINT32_MAX
+#include <cstdlib>    // for getenv, mkstemp, abs
+#include <cstring>    // for strerror
 #include <d01.hpp>
-#include <fstream>       // for basic_istream, basic_ifstream, ifstream
-#include <unordered_map> // for unordered_map
-#include <utility>       // for make_pair, pair
-#include <vector>        // for vector
+#include <functional>        // for greater
+#include <input_view.hpp>    // for InputView
+#include <multiversion.hpp>  // for AOC_TARGET_CLONES
+#include <optional>          // for optional, nullopt
+#include <queue>             // for priority_queue
+#include <record_stream.hpp> // for stream_records
+#include <scanner.hpp>       // for Scanner
+#include <solver.hpp>        // for solve_part_1_from_file, solve_part_2_fro...
+#include <span>              // for span
+#include <stdexcept>         // for runtime_error
+#include <string>            // for string, to_string, stoul, operator+
+#include <string_view>       // for string_view
+#include <sys/types.h>       // for off_t, ssize_t
+#include <thread>            // for thread
+#include <unistd.h>          // for close, pread, unlink, write
+#include <utility>           // for pair, make_pair
+#include <vector>            // for vector
 
 namespace d01 {
 
-std::pair<std::vector<int>, std::vector<int>>
-get_two_lists_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+constexpr size_t RADIX_BITS = 11;
+constexpr size_t RADIX_SIZE = size_t(1) << RADIX_BITS;
+constexpr LocationId RADIX_MASK = LocationId(RADIX_SIZE - 1);
 
-  std::vector<int> list_0;
-  std::vector<int> list_1;
+// Past this, counting every id in a flat array costs more memory than it saves
+constexpr LocationId MAX_COUNTED_ID = LocationId(1) << 24;
 
-  int x0 = 0;
-  int x1 = 0;
+// Lists are only split over threads in slices of at least this many pairs, so
+// puzzle sized inputs stay on the calling thread
+constexpr size_t MIN_PAIRS_PER_THREAD = size_t(1) << 18;
+constexpr size_t MAX_THREADS = 32;
 
-  while (in_stream >> x0 >> x1) {
-    list_0.push_back(x0);
-    list_1.push_back(x1);
+// Streamed lists are sorted and spilled this many pairs at a time, and each
+// spilled run is read back this many ids at a time while merging
+constexpr size_t SPILLED_RUN_PAIRS = size_t(1) << 22;
+constexpr size_t MERGE_READ_IDS = size_t(1) << 14;
+
+LocationId to_location_id(const int64_t value) {
+  if (value < 0 || value > int64_t(UINT32_MAX)) {
+    throw std::runtime_error("Location id out of range: " +
+                             std::to_string(value));
+  }
+  return LocationId(value);
+}
+
+Lists get_two_lists(const InputView &input) {
+  Scanner scanner(input.data());
+
+  std::vector<LocationId> list_0;
+  std::vector<LocationId> list_1;
+
+  while (scanner.skip_to_int()) {
+    list_0.push_back(to_location_id(scanner.next_int()));
+    scanner.skip_any(" ");
+    list_1.push_back(to_location_id(scanner.next_int()));
+  }
+  return {list_0, list_1};
+}
+
+// How many threads to spread lists of num_pairs over: one per core, or
+// AOC_THREADS, but never so many that one has less than MIN_PAIRS_PER_THREAD
+size_t num_threads_for(const size_t num_pairs) {
+  size_t num_threads = std::thread::hardware_concurrency();
+  if (const char *setting = std::getenv("AOC_THREADS")) {
+    num_threads = std::stoul(setting);
+  }
+  num_threads = std::min(num_threads, num_pairs / MIN_PAIRS_PER_THREAD);
+  return std::clamp(num_threads, size_t(1), MAX_THREADS);
+}
+
+// Runs function(chunk, begin, end) over num_chunks even slices of [0, size),
+// each on a thread of its own but the last, which runs on the calling thread
+template <typename Function>
+void for_each_chunk(const size_t size, const size_t num_chunks,
+                    const Function &function) {
+  std::vector<std::thread> threads;
+  for (size_t chunk = 0; chunk + 1 < num_chunks; ++chunk) {
+    threads.emplace_back([&, chunk]() {
+      function(chunk, size * chunk / num_chunks,
+               size * (chunk + 1) / num_chunks);
+    });
+  }
+  function(num_chunks - 1, size * (num_chunks - 1) / num_chunks, size);
+  for (auto &thread : threads) {
+    thread.join();
   }
-  return std::make_pair(list_0, list_1);
 }
 
-int get_total_distance(const std::vector<int> &list_0,
-                       const std::vector<int> &list_1) {
-  int accumulator = 0;
-  for (size_t index = 0; index < list_0.size(); ++index) {
-    accumulator += std::abs(list_0[index] - list_1[index]);
+// LSD radix sort, RADIX_BITS of the ids at a time from the lowest, over only as
+// many digits as the largest id has. Location ids have five decimal digits, so
+// that is two passes over the list whatever its length.
+//
+// Each pass is split over num_threads: every thread counts the digits in its
+// slice of the list, and then moves its slice to where those counts say, after
+// the same digits from the slices before it, which keeps the sort stable.
+void radix_sort(std::vector<LocationId> &ids, const size_t num_threads) {
+  if (ids.size() < 2) {
+    return;
+  }
+  const size_t num_chunks = std::min(num_threads, ids.size());
+
+  std::vector<LocationId> chunk_max_ids(num_chunks);
+  for_each_chunk(
+      ids.size(), num_chunks,
+      [&](const size_t chunk, const size_t begin, const size_t end) {
+        chunk_max_ids[chunk] =
+            *std::max_element(ids.begin() + begin, ids.begin() + end);
+      });
+  const LocationId max_id =
+      *std::max_element(chunk_max_ids.begin(), chunk_max_ids.end());
+  const size_t num_passes =
+      (size_t(std::bit_width(max_id)) + RADIX_BITS - 1) / RADIX_BITS;
+
+  // Counts of each digit per chunk, turned into where the chunk puts the next
+  // id with that digit
+  std::vector<std::array<size_t, RADIX_SIZE>> offsets(num_chunks);
+  std::vector<LocationId> scratch(ids.size());
+  for (size_t pass = 0; pass < num_passes; ++pass) {
+    const size_t shift = pass * RADIX_BITS;
+    for_each_chunk(
+        ids.size(), num_chunks,
+        [&](const size_t chunk, const size_t begin, const size_t end) {
+          auto &counts = offsets[chunk];
+          counts.fill(0);
+          for (size_t index = begin; index < end; ++index) {
+            ++counts[(ids[index] >> shift) & RADIX_MASK];
+          }
+        });
+
+    const LocationId first_digit = (ids[0] >> shift) & RADIX_MASK;
+    size_t num_with_first_digit{};
+    for (const auto &counts : offsets) {
+      num_with_first_digit += counts[first_digit];
+    }
+    if (num_with_first_digit == ids.size()) {
+      // Every id has the same digit here, so the order stays as it is
+      continue;
+    }
+
+    size_t offset{};
+    for (size_t digit = 0; digit < RADIX_SIZE; ++digit) {
+      for (auto &counts : offsets) {
+        const size_t num_with_digit = counts[digit];
+        counts[digit] = offset;
+        offset += num_with_digit;
+      }
+    }
+
+    for_each_chunk(
+        ids.size(), num_chunks,
+        [&](const size_t chunk, const size_t begin, const size_t end) {
+          auto &next = offsets[chunk];
+          for (size_t index = begin; index < end; ++index) {
+            scratch[next[(ids[index] >> shift) & RADIX_MASK]++] = ids[index];
+          }
+        });
+    ids.swap(scratch);
+  }
+}
+
+// Branch free and over unsigned ids, so that the loop runs a vector of pairs
+// at a time
+AOC_TARGET_CLONES
+uint64_t get_total_distance(const LocationId *list_0,
+                            const LocationId *list_1, const size_t size) {
+  uint64_t accumulator{};
+  for (size_t index = 0; index < size; ++index) {
+    accumulator += std::max(list_0[index], list_1[index]) -
+                   std::min(list_0[index], list_1[index]);
   }
   return accumulator;
 }
 
-int get_similarity_score(const std::vector<int> &list_0,
-                         const std::vector<int> &list_1) {
-  std::unordered_map<int, size_t> list_1_counts;
-  for (const auto elem : list_1) {
-    list_1_counts[elem] += 1;
+// Both lists sorted, walked side by side: each run of an id on the left is
+// scored against the run of the same id on the right
+uint64_t get_sorted_similarity_score(const std::span<const LocationId> list_0,
+                                     const std::span<const LocationId> list_1) {
+  uint64_t accumulator{};
+  size_t index_0{};
+  size_t index_1{};
+  while (index_0 < list_0.size()) {
+    const LocationId id = list_0[index_0];
+    uint64_t num_left{};
+    for (; index_0 < list_0.size() && list_0[index_0] == id; ++index_0) {
+      ++num_left;
+    }
+    while (index_1 < list_1.size() && list_1[index_1] < id) {
+      ++index_1;
+    }
+    uint64_t num_right{};
+    for (; index_1 < list_1.size() && list_1[index_1] == id; ++index_1) {
+      ++num_right;
+    }
+    accumulator += id * num_left * num_right;
   }
+  return accumulator;
+}
 
-  int accumulator = 0;
-  for (const auto elem : list_0) {
-    accumulator += (elem * list_1_counts[elem]);
+uint64_t get_similarity_score(const std::vector<LocationId> &list_0,
+                              const std::vector<LocationId> &list_1) {
+  if (list_1.empty()) {
+    return 0;
+  }
+  const LocationId max_id = *std::max_element(list_1.begin(), list_1.end());
+  if (max_id > MAX_COUNTED_ID) {
+    return get_sorted_similarity_score(list_0, list_1);
+  }
+
+  // How often each id appears on the right, indexed by id
+  std::vector<uint32_t> list_1_counts(size_t(max_id) + 1);
+  for (const LocationId id : list_1) {
+    ++list_1_counts[id];
+  }
+
+  uint64_t accumulator{};
+  for (const LocationId id : list_0) {
+    if (id <= max_id) {
+      accumulator += uint64_t(id) * list_1_counts[id];
+    }
   }
   return accumulator;
 }
 
-std::string part_1(const std::string &filepath) {
-  auto [list_0, list_1] = get_two_lists_from_file(filepath);
+// How many ids of the merge of both sorted lists up to diagonal come from
+// list_0, the rest coming from list_1
+size_t merge_path_split(const std::vector<LocationId> &list_0,
+                        const std::vector<LocationId> &list_1,
+                        const size_t diagonal) {
+  size_t low = diagonal > list_1.size() ? diagonal - list_1.size() : 0;
+  size_t high = std::min(diagonal, list_0.size());
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (list_0[middle] <= list_1[diagonal - middle - 1]) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
 
-  std::sort(list_0.begin(), list_0.end());
-  std::sort(list_1.begin(), list_1.end());
+// Both answers in one pass over the sorted lists, split over num_threads.
+// The distance splits evenly by pair. The similarity splits the merge of both
+// lists evenly by merge path, each split then moved back to the start of the
+// run of the id it falls in, so that every id is scored by one thread alone.
+JoinTotals join_sorted_lists(const Lists &lists, const size_t num_threads) {
+  const auto &list_0 = lists.m_list_0;
+  const auto &list_1 = lists.m_list_1;
 
-  int accumulator = get_total_distance(list_0, list_1);
-  return std::to_string(accumulator);
+  std::vector<size_t> splits_0(num_threads + 1, list_0.size());
+  std::vector<size_t> splits_1(num_threads + 1, list_1.size());
+  splits_0[0] = 0;
+  splits_1[0] = 0;
+  const size_t merged_size = list_0.size() + list_1.size();
+  for (size_t chunk = 1; chunk < num_threads; ++chunk) {
+    const size_t diagonal = merged_size * chunk / num_threads;
+    const size_t split_0 = merge_path_split(list_0, list_1, diagonal);
+    const size_t split_1 = diagonal - split_0;
+    LocationId id = UINT32_MAX;
+    if (split_0 < list_0.size()) {
+      id = list_0[split_0];
+    }
+    if (split_1 < list_1.size()) {
+      id = std::min(id, list_1[split_1]);
+    }
+    splits_0[chunk] = size_t(
+        std::lower_bound(list_0.begin(), list_0.end(), id) - list_0.begin());
+    splits_1[chunk] = size_t(
+        std::lower_bound(list_1.begin(), list_1.end(), id) - list_1.begin());
+  }
+
+  std::vector<JoinTotals> chunk_totals(num_threads);
+  for_each_chunk(
+      list_0.size(), num_threads,
+      [&](const size_t chunk, const size_t begin, const size_t end) {
+        chunk_totals[chunk].total_distance = get_total_distance(
+            list_0.data() + begin, list_1.data() + begin, end - begin);
+        chunk_totals[chunk].similarity_score = get_sorted_similarity_score(
+            std::span(list_0).subspan(splits_0[chunk],
+                                      splits_0[chunk + 1] - splits_0[chunk]),
+            std::span(list_1).subspan(splits_1[chunk],
+                                      splits_1[chunk + 1] - splits_1[chunk]));
+      });
+
+  JoinTotals totals;
+  for (const auto &chunk : chunk_totals) {
+    totals.total_distance += chunk.total_distance;
+    totals.similarity_score += chunk.similarity_score;
+  }
+  return totals;
 }
 
-std::string part_2(const std::string &filepath) {
-  auto [list_0, list_1] = get_two_lists_from_file(filepath);
+std::optional<std::pair<LocationId, LocationId>>
+parse_pair(const std::string_view line) {
+  Scanner scanner(line);
+  if (!scanner.skip_to_int()) {
+    return std::nullopt;
+  }
+  const LocationId id_0 = to_location_id(scanner.next_int());
+  scanner.skip_any(" ");
+  return std::make_pair(id_0, to_location_id(scanner.next_int()));
+}
+
+// An unnamed file in TMPDIR, or /tmp, that is gone as soon as it is closed
+int open_temporary_file() {
+  const char *directory = std::getenv("TMPDIR");
+  std::string path =
+      std::string(directory != nullptr ? directory : "/tmp") + "/d01-XXXXXX";
+  const int file_descriptor = ::mkstemp(path.data());
+  if (file_descriptor < 0) {
+    throw std::runtime_error("Unable to create a temporary file: " + path);
+  }
+  ::unlink(path.c_str());
+  return file_descriptor;
+}
 
-  std::sort(list_0.begin(), list_0.end());
-  std::sort(list_1.begin(), list_1.end());
+// One column of ids, spilled to a temporary file a sorted run at a time
+class SpilledColumn {
+public:
+  // In ids from the start of the file
+  struct Run {
+    size_t begin;
+    size_t end;
+  };
+
+  SpilledColumn() : m_file_descriptor(open_temporary_file()) {}
+
+  SpilledColumn(const SpilledColumn &) = delete;
+  SpilledColumn &operator=(const SpilledColumn &) = delete;
+
+  ~SpilledColumn() {
+    ::close(m_file_descriptor);
+  }
 
-  int accumulator = get_similarity_score(list_0, list_1);
+  int file_descriptor() const {
+    return m_file_descriptor;
+  }
+
+  const std::vector<Run> &runs() const {
+    return m_runs;
+  }
+
+  void spill_run(const std::vector<LocationId> &sorted_ids) {
+    const char *bytes = reinterpret_cast<const char *>(sorted_ids.data());
+    size_t num_bytes = sorted_ids.size() * sizeof(LocationId);
+    while (num_bytes > 0) {
+      const ssize_t num_written = ::write(m_file_descriptor, bytes, num_bytes);
+      if (num_written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::runtime_error("Unable to spill a run: " +
+                                 std::string(std::strerror(errno)));
+      }
+      bytes += num_written;
+      num_bytes -= size_t(num_written);
+    }
+    m_runs.push_back({m_num_ids, m_num_ids + sorted_ids.size()});
+    m_num_ids += sorted_ids.size();
+  }
+
+private:
+  int m_file_descriptor;
+  std::vector<Run> m_runs;
+  size_t m_num_ids{};
+};
+
+// Every id of a SpilledColumn in order, by a k-way merge of its runs. Only
+// MERGE_READ_IDS of each run are held at a time.
+class MergedColumn {
+public:
+  explicit MergedColumn(const SpilledColumn &column)
+      : m_file_descriptor(column.file_descriptor()) {
+    for (const auto &run : column.runs()) {
+      m_cursors.push_back({run.begin, run.end, {}, 0});
+    }
+    for (size_t run = 0; run < m_cursors.size(); ++run) {
+      push_next(run);
+    }
+  }
+
+  // The next id in order, returning false once every run is used up
+  bool next(LocationId &id) {
+    if (m_heads.empty()) {
+      return false;
+    }
+    const size_t run = m_heads.top().second;
+    id = m_heads.top().first;
+    m_heads.pop();
+    push_next(run);
+    return true;
+  }
+
+private:
+  struct Cursor {
+    // The part of the run not yet read from the file
+    size_t next;
+    size_t end;
+    std::vector<LocationId> buffer;
+    size_t position;
+  };
+
+  // Puts the next id of the run, if there is one, on the heap
+  void push_next(const size_t run) {
+    Cursor &cursor = m_cursors[run];
+    if (cursor.position == cursor.buffer.size()) {
+      if (cursor.next == cursor.end) {
+        return;
+      }
+      cursor.buffer.resize(std::min(cursor.end - cursor.next, MERGE_READ_IDS));
+      read_ids(cursor.next, cursor.buffer);
+      cursor.next += cursor.buffer.size();
+      cursor.position = 0;
+    }
+    m_heads.emplace(cursor.buffer[cursor.position++], run);
+  }
+
+  void read_ids(const size_t offset, std::vector<LocationId> &ids) const {
+    char *bytes = reinterpret_cast<char *>(ids.data());
+    size_t num_bytes = ids.size() * sizeof(LocationId);
+    off_t position = off_t(offset * sizeof(LocationId));
+    while (num_bytes > 0) {
+      const ssize_t num_read =
+          ::pread(m_file_descriptor, bytes, num_bytes, position);
+      if (num_read < 0 && errno == EINTR) {
+        continue;
+      }
+      if (num_read <= 0) {
+        throw std::runtime_error("Unable to read back a spilled run!");
+      }
+      bytes += num_read;
+      num_bytes -= size_t(num_read);
+      position += num_read;
+    }
+  }
+
+  int m_file_descriptor;
+  std::vector<Cursor> m_cursors;
+  // The smallest id not yet handed out from each run, with its run
+  std::priority_queue<std::pair<LocationId, size_t>,
+                      std::vector<std::pair<LocationId, size_t>>,
+                      std::greater<>>
+      m_heads;
+};
+
+// Sorts the pairs of the file in runs of SPILLED_RUN_PAIRS, spilling each
+// column of each run to its SpilledColumn
+void spill_sorted_runs(const std::string &filepath, SpilledColumn &column_0,
+                       SpilledColumn &column_1) {
+  std::vector<LocationId> run_0;
+  std::vector<LocationId> run_1;
+  const auto spill = [&]() {
+    const size_t num_threads = num_threads_for(run_0.size());
+    radix_sort(run_0, num_threads);
+    radix_sort(run_1, num_threads);
+    column_0.spill_run(run_0);
+    column_1.spill_run(run_1);
+    run_0.clear();
+    run_1.clear();
+  };
+
+  for (const auto &pair : stream_records(filepath, parse_pair)) {
+    if (!pair) {
+      continue;
+    }
+    run_0.push_back(pair->first);
+    run_1.push_back(pair->second);
+    if (run_0.size() == SPILLED_RUN_PAIRS) {
+      spill();
+    }
+  }
+  if (!run_0.empty()) {
+    spill();
+  }
+}
+
+// Both answers in one merge of the two columns by id. Each id is scored for
+// similarity as it goes by. The distance is the area between the two lists'
+// counting functions: from one id to the next, the sorted lists are |balance|
+// apart per step, balance being how many more ids of list 0 than of list 1
+// have gone by. So nothing is held but the runs being merged.
+JoinTotals stream_join(const std::string &filepath) {
+  SpilledColumn column_0;
+  SpilledColumn column_1;
+  spill_sorted_runs(filepath, column_0, column_1);
+  MergedColumn ids_0(column_0);
+  MergedColumn ids_1(column_1);
+
+  JoinTotals totals;
+  LocationId id_0{};
+  LocationId id_1{};
+  bool has_id_0 = ids_0.next(id_0);
+  bool has_id_1 = ids_1.next(id_1);
+  const auto lowest_id = [&]() {
+    return !has_id_1 ? id_0 : !has_id_0 ? id_1 : std::min(id_0, id_1);
+  };
+  int64_t balance{};
+  while (has_id_0 || has_id_1) {
+    const LocationId id = lowest_id();
+    uint64_t num_left{};
+    for (; has_id_0 && id_0 == id; has_id_0 = ids_0.next(id_0)) {
+      ++num_left;
+    }
+    uint64_t num_right{};
+    for (; has_id_1 && id_1 == id; has_id_1 = ids_1.next(id_1)) {
+      ++num_right;
+    }
+    totals.similarity_score += id * num_left * num_right;
+    balance += int64_t(num_left) - int64_t(num_right);
+    if (has_id_0 || has_id_1) {
+      totals.total_distance += uint64_t(std::abs(balance)) * (lowest_id() - id);
+    }
+  }
+  if (balance != 0) {
+    throw std::runtime_error("Lists must be the same length!");
+  }
+  return totals;
+}
+
+Lists Solution::parse(const InputView &input) {
+  auto lists = get_two_lists(input);
+  if (lists.m_list_0.size() != lists.m_list_1.size()) {
+    throw std::runtime_error("Lists must be the same length!");
+  }
+
+  const size_t num_threads = num_threads_for(lists.m_list_0.size());
+  radix_sort(lists.m_list_0, num_threads);
+  radix_sort(lists.m_list_1, num_threads);
+  if (num_threads > 1) {
+    lists.m_totals = join_sorted_lists(lists, num_threads);
+  }
+
+  return lists;
+}
+
+std::string Solution::solve_part_1(const Lists &lists) {
+  if (lists.m_totals) {
+    return std::to_string(lists.m_totals->total_distance);
+  }
+  const uint64_t accumulator =
+      get_total_distance(lists.m_list_0.data(), lists.m_list_1.data(),
+                         lists.m_list_0.size());
+  return std::to_string(accumulator);
+}
+
+std::string Solution::solve_part_2(const Lists &lists) {
+  if (lists.m_totals) {
+    return std::to_string(lists.m_totals->similarity_score);
+  }
+  const uint64_t accumulator =
+      get_similarity_score(lists.m_list_0, lists.m_list_1);
 
   return std::to_string(accumulator);
 }
 
+std::string Solution::stream_part_1(const std::string &filepath) {
+  return std::to_string(stream_join(filepath).total_distance);
+}
+
+std::string Solution::stream_part_2(const std::string &filepath) {
+  return std::to_string(stream_join(filepath).similarity_score);
+}
+
+std::pair<std::string, std::string>
+Solution::stream_both_parts(const std::string &filepath) {
+  const JoinTotals totals = stream_join(filepath);
+  return std::make_pair(std::to_string(totals.total_distance),
+                        std::to_string(totals.similarity_score));
+}
+
+OnlineLists::OnlineLists(const size_t num_ids)
+    : m_num_ids(num_ids)
+    , m_counts_0(num_ids)
+    , m_counts_1(num_ids)
+    , m_balances(4 * std::max(num_ids, size_t(1))) {}
+
+void OnlineLists::check_id(const LocationId id) const {
+  if (id >= m_num_ids) {
+    throw std::runtime_error("Location id out of range: " +
+                             std::to_string(id));
+  }
+}
+
+void OnlineLists::insert(const LocationId id_0, const LocationId id_1) {
+  check_id(id_0);
+  check_id(id_1);
+  // Each new id scores against however many of it the other list has
+  m_similarity_score += uint64_t(id_0) * m_counts_1[id_0];
+  ++m_counts_0[id_0];
+  m_similarity_score += uint64_t(id_1) * m_counts_0[id_1];
+  ++m_counts_1[id_1];
+
+  if (id_0 < id_1) {
+    add_balance(id_0, id_1, 1);
+  } else if (id_1 < id_0) {
+    add_balance(id_1, id_0, -1);
+  }
+  ++m_size;
+}
+
+void OnlineLists::erase(const LocationId id_0, const LocationId id_1) {
+  check_id(id_0);
+  check_id(id_1);
+  if (m_counts_0[id_0] == 0 || m_counts_1[id_1] == 0) {
+    throw std::runtime_error("No such pair to erase!");
+  }
+  --m_counts_0[id_0];
+  m_similarity_score -= uint64_t(id_0) * m_counts_1[id_0];
+  --m_counts_1[id_1];
+  m_similarity_score -= uint64_t(id_1) * m_counts_0[id_1];
+
+  if (id_0 < id_1) {
+    add_balance(id_0, id_1, -1);
+  } else if (id_1 < id_0) {
+    add_balance(id_1, id_0, 1);
+  }
+  --m_size;
+}
+
+void OnlineLists::add_balance(const size_t begin, const size_t end,
+                              const int32_t delta) {
+  add_balance(1, 0, m_num_ids, begin, end, delta);
+}
+
+void OnlineLists::add_balance(const size_t node, const size_t node_begin,
+                              const size_t node_end, const size_t begin,
+                              const size_t end, const int32_t delta) {
+  if (end <= node_begin || node_end <= begin) {
+    return;
+  }
+  if (begin <= node_begin && node_end <= end &&
+      add_to_node(node, node_end - node_begin, delta)) {
+    return;
+  }
+  if (node_end - node_begin == 1) {
+    Node &leaf = m_balances[node];
+    leaf.min += delta;
+    leaf.max += delta;
+    leaf.sum_abs = uint64_t(std::abs(int64_t(leaf.min)));
+    return;
+  }
+
+  // The balances in here are on both sides of zero, or some are about to
+  // cross it, so split it up
+  const size_t middle = node_begin + (node_end - node_begin) / 2;
+  Node &parent = m_balances[node];
+  if (parent.pending != 0) {
+    add_to_node(2 * node, middle - node_begin, parent.pending);
+    add_to_node(2 * node + 1, node_end - middle, parent.pending);
+    parent.pending = 0;
+  }
+  add_balance(2 * node, node_begin, middle, begin, end, delta);
+  add_balance(2 * node + 1, middle, node_end, begin, end, delta);
+
+  const Node &left = m_balances[2 * node];
+  const Node &right = m_balances[2 * node + 1];
+  parent.min = std::min(left.min, right.min);
+  parent.max = std::max(left.max, right.max);
+  parent.sum_abs = left.sum_abs + right.sum_abs;
+}
+
+bool OnlineLists::add_to_node(const size_t node, const size_t length,
+                              const int32_t delta) {
+  // Zero counts as positive, so that no balance can change sign over a run of
+  // changes that are pending together
+  Node &entry = m_balances[node];
+  if (entry.min >= 0 && entry.min + delta >= 0) {
+    entry.sum_abs += delta * int64_t(length);
+  } else if (entry.max < 0 && entry.max + delta < 0) {
+    entry.sum_abs -= delta * int64_t(length);
+  } else {
+    return false;
+  }
+  entry.min += delta;
+  entry.max += delta;
+  entry.pending += delta;
+  return true;
+}
+
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d01
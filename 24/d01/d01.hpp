@@ -1,9 +1,109 @@
 #pragma once
 
-#include <string> // for string
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint32_t, int32_t, uint64_t
+#include <input_view.hpp> // for InputView
+#include <optional>       // for optional
+#include <string>         // for string
+#include <utility>        // for pair
+#include <vector>         // for vector
 
 namespace d01 {
 
+using LocationId = uint32_t;
+
+// Both answers, out of one pass over both sorted lists
+struct JoinTotals {
+  uint64_t total_distance{};
+  uint64_t similarity_score{};
+};
+
+// Both location lists, each sorted
+struct Lists {
+  std::vector<LocationId> m_list_0;
+  std::vector<LocationId> m_list_1;
+  // Joined once in parse for lists big enough to split over threads, so that
+  // the parts do not each join them again
+  std::optional<JoinTotals> m_totals;
+};
+
+struct Solution {
+  using Input = Lists;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &lists);
+
+  static std::string solve_part_2(const Input &lists);
+
+  // Solved off the file without holding the lists: sorted in runs that are
+  // spilled to temporary files, then merged back, in memory that only grows
+  // with the number of runs
+  static std::string stream_part_1(const std::string &filepath);
+
+  static std::string stream_part_2(const std::string &filepath);
+
+  // Both out of the one merge
+  static std::pair<std::string, std::string>
+  stream_both_parts(const std::string &filepath);
+};
+
+// Both answers kept up to date as pairs come and go, for ids below num_ids.
+// The similarity score moves in constant time. The total distance takes up to
+// O(num_ids) an update when the lists keep crossing each other.
+class OnlineLists {
+public:
+  explicit OnlineLists(const size_t num_ids);
+
+  void insert(const LocationId id_0, const LocationId id_1);
+
+  // Throws if either id is not in its list
+  void erase(const LocationId id_0, const LocationId id_1);
+
+  size_t size() const {
+    return m_size;
+  }
+
+  uint64_t total_distance() const {
+    return m_balances[1].sum_abs;
+  }
+
+  uint64_t similarity_score() const {
+    return m_similarity_score;
+  }
+
+private:
+  struct Node {
+    int32_t min;
+    int32_t max;
+    // Still to be added to both children
+    int32_t pending;
+    uint64_t sum_abs;
+  };
+
+  void check_id(const LocationId id) const;
+
+  // Adds delta, 1 or -1, to the balance of every id in [begin, end)
+  void add_balance(const size_t begin, const size_t end, const int32_t delta);
+
+  void add_balance(const size_t node, const size_t node_begin,
+                   const size_t node_end, const size_t begin, const size_t end,
+                   const int32_t delta);
+
+  // Adds delta to the whole of a node if that keeps the sign of every balance
+  // in it, returning false without changing anything if it would not
+  bool add_to_node(const size_t node, const size_t length,
+                   const int32_t delta);
+
+  size_t m_num_ids;
+  std::vector<uint32_t> m_counts_0;
+  std::vector<uint32_t> m_counts_1;
+  // A segment tree over the ids, from the root at 1
+  std::vector<Node> m_balances;
+  size_t m_size{};
+  uint64_t m_similarity_score{};
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
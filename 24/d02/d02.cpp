@@ -2,25 +2,31 @@
 #include <cmath>     // IWYU pragma: keep
 #include <cstdlib>   // for size_t
 #include <d02.hpp>
-#include <fstream> // for basic_istream, basic_ifstream, getline, ifstream
-#include <string>  // for char_traits, string, stoi, to_string
-#include <vector>  // for vector
+#include <input_view.hpp>    // for InputView
+#include <optional>          // for optional
+#include <record_stream.hpp> // for stream_records
+#include <scanner.hpp>       // for Scanner
+#include <solver.hpp>        // for solve_part_1_from_file, solve_part_2_from...
+#include <span>              // for span
+#include <string>            // for string, to_string
+#include <string_view>       // for string_view
+#include <vector>            // for vector
 
 namespace d02 {
-std::vector<std::vector<int>> get_lists_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
-
-  std::vector<std::vector<int>> output;
-
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
-    std::vector<int> line_vec;
-    size_t pos = 0;
-    while (line.size() > 0) {
-      int value{std::stoi(line, &pos)};
-      line_vec.push_back(value);
-      line.erase(0, pos);
-    }
-    output.push_back(line_vec);
+std::vector<int> parse_report(const std::string_view line) {
+  Scanner scanner(line);
+  std::vector<int> line_vec;
+  while (scanner.skip_to_int()) {
+    line_vec.push_back(int(scanner.next_int()));
+  }
+  return line_vec;
+}
+
+Reports get_lists(const InputView &input) {
+  Reports output;
+
+  for (const auto line : input.lines()) {
+    output.push_back(parse_report(line));
   }
   return output;
 }
@@ -54,48 +60,124 @@ bool is_safe(const std::vector<int> &list) {
   return all_increasing || all_decreasing;
 }
 
-bool is_safe_with_dampener(const std::vector<int> &list) {
-  if (is_safe(list)) {
-    return SAFE;
+DampenedChecker::DampenedChecker(const size_t max_removals)
+    : m_max_removals(max_removals)
+    , m_num_removed(max_removals + 1)
+    , m_first_removed(max_removals + 1) {}
+
+std::optional<DampenedChecker::Dampening>
+DampenedChecker::check(const std::span<const int> report) {
+  const auto increasing = check(report, 1);
+  const auto decreasing = check(report, -1);
+  if (!increasing ||
+      (decreasing && decreasing->num_removed < increasing->num_removed)) {
+    return decreasing;
   }
+  return increasing;
+}
 
-  std::vector<int> list_copy;
-  list_copy.reserve(list.size());
+std::optional<DampenedChecker::Dampening>
+DampenedChecker::check(const std::span<const int> report, const int direction) {
+  const size_t size = report.size();
+  const size_t window = m_max_removals + 1;
+  // Stand for more removals than allowed, and for no level removed yet
+  const size_t too_many = window;
+  const size_t none = size;
 
-  for (size_t index_to_remove = 0; index_to_remove < list.size();
-       ++index_to_remove) {
-    for (size_t index = 0; index < list.size(); ++index) {
-      if (index == index_to_remove) {
+  std::optional<Dampening> best;
+  for (size_t index = 0; index < size; ++index) {
+    // Keeping this level with every one before it gone...
+    size_t num_removed = index <= m_max_removals ? index : too_many;
+    size_t first_removed = index > 0 ? 0 : none;
+    // ...or right after an earlier level that is kept, dropping those between
+    for (size_t skipped = 0; skipped < window && skipped < index; ++skipped) {
+      const size_t previous = index - 1 - skipped;
+      const size_t slot = previous % window;
+      const size_t candidate = m_num_removed[slot] + skipped;
+      if (candidate >= num_removed || candidate > m_max_removals) {
+        continue;
+      }
+      const int step = direction * (report[index] - report[previous]);
+      if (step < 1 || step > 3) {
         continue;
       }
-      list_copy.push_back(list[index]);
+      num_removed = candidate;
+      first_removed = m_first_removed[slot] != none ? m_first_removed[slot]
+                      : skipped > 0                 ? previous + 1
+                                                    : none;
     }
-    if (is_safe(list_copy)) {
-      return SAFE;
+    // Only read again for levels within window of this one, which the loop
+    // above has finished with
+    m_num_removed[index % window] = num_removed;
+    m_first_removed[index % window] = first_removed;
+
+    // Ending the report here, with every level after this one gone
+    const size_t trailing = size - 1 - index;
+    if (num_removed + trailing > m_max_removals ||
+        (best && best->num_removed <= num_removed + trailing)) {
+      continue;
+    }
+    if (first_removed == none && trailing > 0) {
+      first_removed = index + 1;
     }
-    list_copy.clear();
+    best = Dampening{num_removed + trailing, first_removed};
   }
-  return UNSAFE;
+  if (size == 0) {
+    best = Dampening{0, 0};
+  }
+  return best;
 }
 
-std::string part_1(const std::string &filepath) {
-  auto lists = get_lists_from_file(filepath);
+Reports Solution::parse(const InputView &input) {
+  return get_lists(input);
+}
 
+// Over either the parsed reports or a stream of them
+template <typename ReportRange, typename IsSafe>
+int count_safe(ReportRange &&lists, IsSafe is_report_safe) {
   int accumulator = 0;
   for (const auto &list : lists) {
-    accumulator += int(is_safe(list));
+    accumulator += int(is_report_safe(list));
   }
+  return accumulator;
+}
+
+std::string Solution::solve_part_1(const Reports &lists) {
+  int accumulator = count_safe(lists, is_safe);
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-  auto lists = get_lists_from_file(filepath);
-  int accumulator = 0;
-  for (const auto &list : lists) {
-    accumulator += int(is_safe_with_dampener(list));
-  }
+// The Problem Dampener tolerates a single bad level
+auto is_safe_with_dampener() {
+  return [checker = DampenedChecker(1)](const std::vector<int> &list) mutable {
+    return checker.check(list).has_value();
+  };
+}
+
+std::string Solution::solve_part_2(const Reports &lists) {
+  int accumulator = count_safe(lists, is_safe_with_dampener());
+  return std::to_string(accumulator);
+}
+
+std::string Solution::stream_part_1(const std::string &filepath) {
+  int accumulator = count_safe(stream_records(filepath, parse_report), is_safe);
+
   return std::to_string(accumulator);
 }
 
+std::string Solution::stream_part_2(const std::string &filepath) {
+  int accumulator = count_safe(stream_records(filepath, parse_report),
+                               is_safe_with_dampener());
+  return std::to_string(accumulator);
+}
+
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d02
@@ -1,9 +1,63 @@
 #pragma once
 
-#include <string> // for string
+#include <cstddef>        // for size_t
+#include <input_view.hpp> // for InputView
+#include <optional>       // for optional
+#include <span>           // for span
+#include <string>         // for string
+#include <vector>         // for vector
 
 namespace d02 {
 
+using Reports = std::vector<std::vector<int>>;
+
+// Decides whether a report is safe once at most max_removals of its levels are
+// dropped, in one pass over it for each direction.
+//
+// For each level, the fewest removals that leave a safe run ending there are
+// worked out from the max_removals + 1 levels before it, since any more than
+// that would already be over the limit. Those counts sit in a ring of that
+// size that is kept between reports, so checking a report allocates nothing.
+class DampenedChecker {
+public:
+  struct Dampening {
+    // Fewest levels that have to go for the report to be safe
+    size_t num_removed;
+    // The first of them, or the size of the report when none have to
+    size_t first_removed;
+  };
+
+  explicit DampenedChecker(const size_t max_removals);
+
+  // nullopt if more than max_removals levels would have to go
+  std::optional<Dampening> check(const std::span<const int> report);
+
+private:
+  // As check, keeping only the levels that go up (direction 1) or down (-1)
+  std::optional<Dampening> check(const std::span<const int> report,
+                                 const int direction);
+
+  size_t m_max_removals;
+  // Of the last max_removals + 1 levels, by index modulo that
+  std::vector<size_t> m_num_removed;
+  std::vector<size_t> m_first_removed;
+};
+
+struct Solution {
+  using Input = Reports;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &lists);
+
+  static std::string solve_part_2(const Input &lists);
+
+  // Solved a report at a time off the file, in constant memory
+  static std::string stream_part_1(const std::string &filepath);
+
+  static std::string stream_part_2(const std::string &filepath);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
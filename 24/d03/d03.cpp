@@ -1,37 +1,34 @@
 #include <_ctype.h> // for isdigit
 #include <cctype>   // for isdigit
+#include <charconv> // for from_chars
 #include <cstddef>  // for size_t
 #include <d03.hpp>
-#include <fstream> // for basic_ifstream, basic_filebuf, basic_ostream
-#include <sstream> // for basic_stringstream, stringstream
-#include <string>  // for string, char_traits, allocator, stoi, to_string
+#include <input_view.hpp> // for InputView
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <string>         // for string, to_string
+#include <string_view>    // for string_view
 
 namespace d03 {
 
-std::stringstream get_content_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
-
-  std::stringstream output;
-
-  output << in_stream.rdbuf();
-
-  return output;
-}
-
-std::size_t get_next_valid_digit(const std::string &input, size_t pos) {
+std::size_t get_next_valid_digit(const std::string_view input, size_t pos) {
 
   size_t num_digits{};
 
-  std::string output_str;
-
-  while (num_digits < 3 && std::isdigit(input[pos + num_digits])) {
-    output_str.push_back(input[pos + num_digits]);
+  while (num_digits < 3 && pos + num_digits < input.size() &&
+         std::isdigit(input[pos + num_digits])) {
     ++num_digits;
   }
   return num_digits;
 }
 
-int calculate_muls(const std::string &input, bool enable_do = false) {
+int to_term(const std::string_view input, const size_t pos,
+            const size_t num_digits) {
+  int term{};
+  std::from_chars(input.data() + pos, input.data() + pos + num_digits, term);
+  return term;
+}
+
+int calculate_muls(const std::string_view input, bool enable_do = false) {
   size_t pos{};
 
   int output = 0;
@@ -43,17 +40,17 @@ int calculate_muls(const std::string &input, bool enable_do = false) {
 
     if (enable_do) {
       size_t next_do = input.find("do()", pos);
-      if (next_do == std::string::npos && !mult_enabled) {
+      if (next_do == std::string_view::npos && !mult_enabled) {
         return output;
       }
-      if (next_do == std::string::npos) {
+      if (next_do == std::string_view::npos) {
         next_do = input.size();
       }
       size_t next_dont = input.find("don't()", pos);
-      if (next_dont == std::string::npos && mult_enabled) {
+      if (next_dont == std::string_view::npos && mult_enabled) {
         enable_do = false;
       }
-      if (next_dont == std::string::npos) {
+      if (next_dont == std::string_view::npos) {
         next_dont = input.size();
       }
 
@@ -72,7 +69,7 @@ int calculate_muls(const std::string &input, bool enable_do = false) {
       }
     }
 
-    if (next_mul == std::string::npos) {
+    if (next_mul == std::string_view::npos) {
       return output;
     }
     pos = next_mul + 4;
@@ -81,10 +78,10 @@ int calculate_muls(const std::string &input, bool enable_do = false) {
     if (num_digits == 0) {
       continue;
     }
-    int first_term = std::stoi(input.substr(pos, num_digits));
+    int first_term = to_term(input, pos, num_digits);
     pos += num_digits;
 
-    if (input[pos] != ',') {
+    if (pos >= input.size() || input[pos] != ',') {
       continue;
     }
     ++pos;
@@ -93,10 +90,10 @@ int calculate_muls(const std::string &input, bool enable_do = false) {
     if (num_digits == 0) {
       continue;
     }
-    int second_term = std::stoi(input.substr(pos, num_digits));
+    int second_term = to_term(input, pos, num_digits);
     pos += num_digits;
 
-    if (input[pos] != ')') {
+    if (pos >= input.size() || input[pos] != ')') {
       continue;
     }
     ++pos;
@@ -108,21 +105,28 @@ int calculate_muls(const std::string &input, bool enable_do = false) {
   return output;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  auto file_stream = get_content_from_file(filepath);
+std::string_view Solution::parse(const InputView &input) {
+  return input.data();
+}
 
-  int accumulator = calculate_muls(file_stream.str());
+std::string Solution::solve_part_1(const std::string_view &program) {
+  int accumulator = calculate_muls(program);
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-  auto file_stream = get_content_from_file(filepath);
-
-  int accumulator = calculate_muls(file_stream.str(), true);
+std::string Solution::solve_part_2(const std::string_view &program) {
+  int accumulator = calculate_muls(program, true);
 
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d03
@@ -1,9 +1,22 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <string_view>    // for string_view
 
 namespace d03 {
 
+struct Solution {
+  // The corrupted program, straight out of the InputView
+  using Input = std::string_view;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &program);
+
+  static std::string solve_part_2(const Input &program);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
@@ -1,7 +1,8 @@
 #include <algorithm>    // for reverse
-#include <core_lib.hpp> // for Grid, get_lines_from_file
+#include <core_lib.hpp> // for Grid, get_lines
 #include <d04.hpp>
-#include <initializer_list> // for initializer_list
+#include <multiversion.hpp> // for AOC_TARGET_CLONES
+#include <solver.hpp>       // for solve_part_1_from_file, solve_part_2_from...
 #include <stddef.h>         // for size_t
 #include <string>           // for basic_string, string, to_string, swap
 #include <utility>          // for pair
@@ -9,24 +10,30 @@
 
 namespace d04 {
 
+// Every start of XMAS or SAMX in text. Neither word can overlap itself, so
+// this matches searching for each left to right. Branch free, so that the
+// loop runs a vector of starts at a time.
+AOC_TARGET_CLONES
+size_t count_xmas_samx(const char *text, const size_t size) {
+  size_t count{};
+  for (size_t index = 0; index + 4 <= size; ++index) {
+    const char first = text[index];
+    const char second = text[index + 1];
+    const char third = text[index + 2];
+    const char fourth = text[index + 3];
+    const bool xmas =
+        (first == 'X') & (second == 'M') & (third == 'A') & (fourth == 'S');
+    const bool samx =
+        (first == 'S') & (second == 'A') & (third == 'M') & (fourth == 'X');
+    count += size_t(xmas | samx);
+  }
+  return count;
+}
+
 int count_xmas_samx(const Grid &lines) {
   int accumulator = 0;
   for (const auto &line : lines) {
-    for (const auto &search_word : {"XMAS", "SAMX"}) {
-      size_t pos{};
-      while (pos + 4 <= line.size()) {
-        size_t search_pos = line.find(search_word, pos);
-        if (search_pos == std::string::npos) {
-          search_pos = line.size();
-        }
-        if (search_pos < line.size()) {
-          ++accumulator;
-          pos = search_pos + 4;
-        } else {
-          pos = line.size();
-        }
-      }
-    }
+    accumulator += int(count_xmas_samx(line.data(), line.size()));
   }
   return accumulator;
 }
@@ -173,20 +180,28 @@ int count_all_xmas_part_1(const Grid &lines) {
   return accumulator;
 }
 
-std::string part_1(const std::string &filepath) {
-  const auto lines = get_lines_from_file(filepath);
+Grid Solution::parse(const InputView &input) {
+  return get_lines(input);
+}
 
+std::string Solution::solve_part_1(const Grid &lines) {
   int accumulator = count_all_xmas_part_1(lines);
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-  const auto lines = get_lines_from_file(filepath);
-
+std::string Solution::solve_part_2(const Grid &lines) {
   int accumulator = count_x_shaped_mas(lines);
 
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d04
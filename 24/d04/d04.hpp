@@ -1,9 +1,21 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for Grid
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
 
 namespace d04 {
 
+struct Solution {
+  using Input = Grid;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &lines);
+
+  static std::string solve_part_2(const Input &lines);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
@@ -1,86 +1,56 @@
 #include <__hash_table> // for __hash_const_iterator
-#include <_ctype.h>     // for isdigit
-#include <cctype>       // for isdigit
 #include <d05.hpp>
-#include <fstream>       // for basic_istream, basic_ifstream, getline, bas...
-#include <iostream>      // for cout
-#include <stddef.h>      // for size_t
-#include <stdexcept>     // for runtime_error
-#include <string>        // for char_traits, string, stoi, to_string
-#include <unordered_map> // for operator==, __hash_map_const_iterator, __ha...
-#include <unordered_set> // for unordered_set
-#include <utility>       // for make_pair, pair
-#include <vector>        // for vector
+#include <input_view.hpp> // for InputView
+#include <iostream>       // for cout
+#include <scanner.hpp>    // for Scanner
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <string>         // for string, to_string
+#include <string_view>    // for string_view
+#include <unordered_map>  // for operator==, __hash_map_const_iterator, __ha...
+#include <unordered_set>  // for unordered_set
+#include <utility>        // for make_pair, pair
+#include <vector>         // for vector
 
 namespace d05 {
 
-// A RuleSet consists of all page numbers that may not come before the page in
-// question
-using RuleSet = std::unordered_set<int>;
-// AllRules maps page numbers to their RuleSets
-using AllRules = std::unordered_map<int, RuleSet>;
+std::pair<int, int> parse_rule(const std::string_view line) {
+  Scanner scanner(line);
 
-using PageOrder = std::vector<int>;
-using PageOrders = std::vector<PageOrder>;
+  const int first = int(scanner.next_uint());
+  scanner.expect("|");
+  const int second = int(scanner.next_uint());
 
-std::pair<int, int> parse_rule(const std::string &line) {
-
-  std::string first_str;
-  size_t pos{};
-  while (std::isdigit(line[pos])) {
-    first_str += line[pos];
-    ++pos;
-  }
-
-  if (line[pos] != '|') {
-    throw std::runtime_error("Unexpected!");
-  }
-  ++pos;
-
-  std::string second_str;
-  while (pos < line.size()) {
-    second_str += line[pos];
-    ++pos;
-  }
-
-  return std::make_pair(std::stoi(first_str), std::stoi(second_str));
+  return std::make_pair(first, second);
 }
 
-PageOrder parse_page_order(const std::string &line) {
+PageOrder parse_page_order(const std::string_view line) {
   PageOrder output;
 
-  size_t pos{};
-  while (pos < line.size()) {
-
-    std::string num_str;
-    while (std::isdigit(line[pos])) {
-      num_str += line[pos];
-      ++pos;
-    }
+  Scanner scanner(line);
+  while (!scanner.at_end()) {
+    output.push_back(int(scanner.next_uint()));
 
-    output.push_back(std::stoi(num_str));
-
-    if (pos == line.size()) {
+    if (scanner.at_end()) {
       break;
     }
 
-    if (line[pos] != ',') {
-      throw std::runtime_error("Unexpected!");
-    }
-    ++pos;
+    scanner.expect(",");
   }
 
   return output;
 }
 
-std::pair<AllRules, PageOrders>
-get_rules_and_pages_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+RulesAndPages get_rules_and_pages(const InputView &input) {
+  const auto &lines = input.lines();
+  size_t line_index = 0;
 
   AllRules all_rules;
   // Collect RuleSet first
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
+  for (; line_index < lines.size(); ++line_index) {
+    const auto line = lines[line_index];
     if (line.size() == 0) {
+      ++line_index;
       break;
     }
     const auto [first, second] = parse_rule(line);
@@ -95,11 +65,11 @@ get_rules_and_pages_from_file(const std::string &filepath) {
 
   PageOrders page_orders;
   // Collect PageOrders
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
-    page_orders.push_back(parse_page_order(line));
+  for (; line_index < lines.size(); ++line_index) {
+    page_orders.push_back(parse_page_order(lines[line_index]));
   }
 
-  return std::make_pair(all_rules, page_orders);
+  return {all_rules, page_orders};
 }
 
 void print_page_order(const PageOrder &page_order) {
@@ -201,9 +171,12 @@ int sum_middle_pages(const PageOrders &page_orders) {
   return accumulator;
 }
 
-std::string part_1(const std::string &filepath) {
+RulesAndPages Solution::parse(const InputView &input) {
+  return get_rules_and_pages(input);
+}
 
-  const auto [all_rules, page_orders] = get_rules_and_pages_from_file(filepath);
+std::string Solution::solve_part_1(const RulesAndPages &rules_and_pages) {
+  const auto &[all_rules, page_orders] = rules_and_pages;
 
   const auto [valid_page_orders, invalid_page_orders] =
       find_valid_and_invalid_page_orders(page_orders, all_rules);
@@ -213,9 +186,8 @@ std::string part_1(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const auto [all_rules, page_orders] = get_rules_and_pages_from_file(filepath);
+std::string Solution::solve_part_2(const RulesAndPages &rules_and_pages) {
+  const auto &[all_rules, page_orders] = rules_and_pages;
 
   const auto [valid_page_orders, invalid_page_orders] =
       find_valid_and_invalid_page_orders(page_orders, all_rules);
@@ -228,4 +200,12 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d05
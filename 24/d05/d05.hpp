@@ -1,9 +1,37 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <unordered_set>  // for unordered_set
+#include <vector>         // for vector
 
 namespace d05 {
 
+// A RuleSet consists of all page numbers that may not come before the page in
+// question
+using RuleSet = std::unordered_set<int>;
+// AllRules maps page numbers to their RuleSets
+using AllRules = std::unordered_map<int, RuleSet>;
+
+using PageOrder = std::vector<int>;
+using PageOrders = std::vector<PageOrder>;
+
+struct RulesAndPages {
+  AllRules m_all_rules;
+  PageOrders m_page_orders;
+};
+
+struct Solution {
+  using Input = RulesAndPages;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &rules_and_pages);
+
+  static std::string solve_part_2(const Input &rules_and_pages);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
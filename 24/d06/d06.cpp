@@ -1,37 +1,32 @@
 #include <array>        // for array
-#include <core_lib.hpp> // for Grid, Position, Tile, get_lines_from_file
+#include <bit_grid.hpp> // for BitGrid
+#include <core_lib.hpp> // for FlatGrid, FlatIndex, Tile, NUM_NEIGHBOURS
 #include <d06.hpp>
-#include <set>       // for set, __tree_const_iterator
-#include <stddef.h>  // for size_t
-#include <stdexcept> // for runtime_error
-#include <string>    // for basic_string, string, to_string
-#include <utility>   // for pair, make_pair, operator==
+#include <input_view.hpp> // for InputView
+#include <instrument.hpp> // for AOC_SCOPE, AOC_COUNT
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <stdexcept>      // for runtime_error
+#include <string>         // for basic_string, string, to_string
 
 namespace d06 {
 
-using PositionSet = std::set<Position>;
+constexpr size_t NUM_DIRECTIONS = NUM_NEIGHBOURS;
 
-using HeadingPositionSet = std::set<std::pair<int, Position>>;
-
-constexpr size_t NUM_DIRECTIONS = 4;
-
-// Listed in order of turning
+// Listed in order of turning, which matches the order of the FlatGrid
+// neighbour offsets
 constexpr std::array<Tile, NUM_DIRECTIONS> GUARD_TILES = {'^', '>', 'v', '<'};
 
-constexpr std::array<Position, NUM_DIRECTIONS> GUARD_MOVEMENTS = {
-    {{-1, 0}, {0, 1}, {1, 0}, {0, -1}}};
-
 constexpr Tile VISITED = 'X';
 constexpr Tile OBSTACLE = '#';
-
-Position find_guard(const Grid &grid) {
-  for (int row_index = 0; row_index < grid.size(); ++row_index) {
-    for (int col_index = 0; col_index < grid[row_index].size(); ++col_index) {
-      const Tile current_space = grid[row_index][col_index];
-      if (current_space == GUARD_TILES[0] || current_space == GUARD_TILES[1] ||
-          current_space == GUARD_TILES[2] || current_space == GUARD_TILES[3]) {
-        return std::make_pair(row_index, col_index);
-      }
+constexpr Tile OUT_OF_BOUNDS = ' ';
+
+FlatIndex find_guard(const FlatGrid &grid) {
+  for (const auto index : grid.interior_indices()) {
+    const Tile current_space = grid[index];
+    if (current_space == GUARD_TILES[0] || current_space == GUARD_TILES[1] ||
+        current_space == GUARD_TILES[2] || current_space == GUARD_TILES[3]) {
+      return index;
     }
   }
   throw std::runtime_error("Should have found the guard!");
@@ -50,91 +45,98 @@ int get_position_index(const Tile guard_tile) {
   throw std::runtime_error("Unknown guard tile!");
 }
 
-PositionSet
-from_heading_position_set(const HeadingPositionSet &heading_position_set) {
-  PositionSet output;
-  for (const auto &[_, position] : heading_position_set) {
-    output.insert(position);
+// One row per heading, one bit per tile of the FlatGrid
+BitGrid make_heading_position_set(const FlatGrid &grid) {
+  return BitGrid(NUM_DIRECTIONS, grid.size());
+}
+
+// A single row of every tile visited, whatever the heading
+BitGrid from_heading_position_set(const BitGrid &heading_position_set) {
+  BitGrid output(1, heading_position_set.width());
+  for (size_t heading = 0; heading < NUM_DIRECTIONS; ++heading) {
+    output.or_row(0, heading_position_set, heading);
   }
   return output;
 }
 
-std::pair<Tile, HeadingPositionSet>
-simulate_guard(const Grid &grid, const Position starting_position) {
-  auto [row, col] = starting_position;
-  HeadingPositionSet visited;
-  auto guard_tile = get_position_index(grid[row][col]);
-  while (is_in_bounds(grid, row, col)) {
-    const auto current_heading =
-        std::make_pair(guard_tile, std::make_pair(row, col));
-    if (visited.count(current_heading) > 0) {
-      return std::make_pair(OBSTACLE, visited);
+// Walks the guard until they leave the grid, returning VISITED, or loop,
+// returning OBSTACLE. visited has to start out empty.
+Tile simulate_guard(const FlatGrid &grid, const FlatIndex starting_position,
+                    BitGrid &visited) {
+  AOC_SCOPE("guard walk");
+  FlatIndex position = starting_position;
+  auto guard_tile = get_position_index(grid[position]);
+  const auto &movements = grid.neighbour_offsets();
+  while (true) {
+    if (visited.test(guard_tile, position)) {
+      return OBSTACLE;
     }
-    const auto [row_incr, col_incr] = GUARD_MOVEMENTS[guard_tile];
-    const auto next_row = row + row_incr;
-    const auto next_col = col + col_incr;
-    if (!is_in_bounds(grid, next_row, next_col)) {
-      visited.insert(std::make_pair(guard_tile, std::make_pair(row, col)));
-      return std::make_pair(VISITED, visited);
+    AOC_COUNT("steps", 1);
+    const FlatIndex next_position = position + movements[guard_tile];
+    const auto next_tile = grid[next_position];
+    if (next_tile == OUT_OF_BOUNDS) {
+      visited.set(guard_tile, position);
+      return VISITED;
     }
-    const auto next_tile = grid[next_row][next_col];
     if (next_tile == OBSTACLE) {
       guard_tile = (guard_tile + 1) % NUM_DIRECTIONS;
       continue;
     }
-    visited.insert(std::make_pair(guard_tile, std::make_pair(row, col)));
-    row = next_row;
-    col = next_col;
+    visited.set(guard_tile, position);
+    position = next_position;
   }
-  return std::make_pair(VISITED, visited);
 }
 
-PositionSet simulate_guard_get_visited_positions(const Grid &grid) {
-  const Position starting_position = find_guard(grid);
-  const auto [output_tile, heading_position_set] =
-      simulate_guard(grid, starting_position);
+BitGrid simulate_guard_get_visited_positions(const FlatGrid &grid) {
+  const FlatIndex starting_position = find_guard(grid);
+  BitGrid heading_position_set = make_heading_position_set(grid);
+  const auto output_tile =
+      simulate_guard(grid, starting_position, heading_position_set);
   if (output_tile != VISITED) {
     throw std::runtime_error("Expected not to have a cycle!");
   }
   return from_heading_position_set(heading_position_set);
 }
 
-size_t count_new_obstacle_candidates(const Grid &original_grid,
-                                     const PositionSet &visited_positions) {
+size_t count_new_obstacle_candidates(const FlatGrid &original_grid,
+                                     const BitGrid &visited_positions) {
   // I assume there is a more efficient way of doing this, but this seemed to
   // work quick enough
   size_t new_obstacle_candidates{};
-  Grid scratch_grid(original_grid);
-  const Position starting_position = find_guard(original_grid);
-  for (const auto &position : visited_positions) {
+  FlatGrid scratch_grid(original_grid);
+  const FlatIndex starting_position = find_guard(original_grid);
+  // Every walk starts from an empty set, so the one bitmap is cleared and
+  // reused rather than allocated again
+  BitGrid visited = make_heading_position_set(original_grid);
+  visited_positions.for_each_set([&](const size_t, const FlatIndex position) {
     if (starting_position == position) {
-      continue;
+      return;
     }
-    const auto [row, col] = position;
-    const auto old_value = scratch_grid[row][col];
-    scratch_grid[row][col] = OBSTACLE;
-    const auto [output_tile, _] =
-        simulate_guard(scratch_grid, starting_position);
+    const auto old_value = scratch_grid[position];
+    scratch_grid[position] = OBSTACLE;
+    visited.clear();
+    const Tile output_tile =
+        simulate_guard(scratch_grid, starting_position, visited);
     if (output_tile == OBSTACLE) {
       ++new_obstacle_candidates;
     }
-    scratch_grid[row][col] = old_value;
-  }
+    scratch_grid[position] = old_value;
+  });
   return new_obstacle_candidates;
 }
 
-std::string part_1(const std::string &filepath) {
-  const Grid grid = get_lines_from_file(filepath);
+FlatGrid Solution::parse(const InputView &input) {
+  return FlatGrid(input.lines(), OUT_OF_BOUNDS);
+}
 
+std::string Solution::solve_part_1(const FlatGrid &grid) {
   const auto visited_positions = simulate_guard_get_visited_positions(grid);
-  auto accumulator = visited_positions.size();
+  auto accumulator = visited_positions.count();
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-  const Grid grid = get_lines_from_file(filepath);
-
+std::string Solution::solve_part_2(const FlatGrid &grid) {
   const auto visited_positions = simulate_guard_get_visited_positions(grid);
 
   auto accumulator = count_new_obstacle_candidates(grid, visited_positions);
@@ -142,4 +144,12 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d06
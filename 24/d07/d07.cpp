@@ -1,54 +1,37 @@
 #include <cmath> // for floor, log10, pow
 #include <d07.hpp>
-#include <deque>    // for deque, __deque_iterator
-#include <fstream>  // for basic_ostream, operator<<, basic_istream, endl
-#include <iostream> // for cout
-#include <stddef.h> // for size_t
-#include <string>   // for char_traits, string, stoull, to_string
-#include <utility>  // for pair, make_pair
-#include <vector>   // for vector
+#include <deque>             // for deque, __deque_iterator
+#include <input_view.hpp>    // for InputView
+#include <iostream>          // for basic_ostream, operator<<, endl, cout
+#include <record_stream.hpp> // for stream_records
+#include <scanner.hpp>       // for Scanner
+#include <solver.hpp>        // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>          // for size_t
+#include <string>            // for string, to_string
+#include <string_view>       // for string_view
+#include <utility>           // for pair, make_pair
+#include <vector>            // for vector
 
 namespace d07 {
 
-using TestValue = unsigned long long;
+// 190: 10 19
+Equation parse_equation(const std::string_view line) {
+  Scanner scanner(line);
+  Operands operands{};
+  const TestValue result = scanner.next_uint();
+  scanner.expect(": ");
 
-using Operands = std::deque<TestValue>;
-
-using Equation = std::pair<TestValue, Operands>;
-
-using Equations = std::vector<Equation>;
-
-Equations get_equations_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+  while (!scanner.at_end()) {
+    operands.push_back(scanner.next_uint());
+    scanner.skip_any(" ");
+  }
+  return std::make_pair(result, operands);
+}
 
+Equations get_equations(const InputView &input) {
   Equations equations;
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
-    TestValue result{};
-    Operands operands{};
-    size_t index{};
-    std::string result_str;
-    while (line[index] != ':') {
-      result_str.push_back(line[index]);
-      ++index;
-    }
-    result = std::stoull(result_str);
-    // index points to colon
-    ++index;
-    // index points to space
-    ++index;
-    // index points to first character of operands
-
-    while (index < line.size()) {
-      std::string operand_str;
-      while (index < line.size() && line[index] != ' ') {
-        operand_str.push_back(line[index]);
-        ++index;
-      }
-      operands.push_back(std::stoull(operand_str));
-      // index points to space or end of string
-      ++index;
-    }
-    equations.push_back(std::make_pair(result, operands));
+  for (const auto line : input.lines()) {
+    equations.push_back(parse_equation(line));
   }
 
   return equations;
@@ -116,7 +99,9 @@ bool is_equation_possible(const Equation &equation,
   return false;
 }
 
-TestValue sum_valid_results(const Equations &equations, const bool is_part_2,
+// Over either the parsed equations or a stream of them
+template <typename EquationRange>
+TestValue sum_valid_results(EquationRange &&equations, const bool is_part_2,
                             const bool do_display = true) {
   TestValue accumulator{};
 
@@ -142,10 +127,11 @@ TestValue sum_valid_results(const Equations &equations, const bool is_part_2,
   return accumulator;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const auto equations = get_equations_from_file(filepath);
+Equations Solution::parse(const InputView &input) {
+  return get_equations(input);
+}
 
+std::string Solution::solve_part_1(const Equations &equations) {
   bool is_part_2 = false;
 
   TestValue accumulator = sum_valid_results(equations, is_part_2);
@@ -153,15 +139,38 @@ std::string part_1(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
+std::string Solution::solve_part_2(const Equations &equations) {
+  bool is_part_2 = true;
+
+  TestValue accumulator = sum_valid_results(equations, is_part_2);
 
-  const auto equations = get_equations_from_file(filepath);
+  return std::to_string(accumulator);
+}
+
+std::string Solution::stream_part_1(const std::string &filepath) {
+  bool is_part_2 = false;
+
+  TestValue accumulator =
+      sum_valid_results(stream_records(filepath, parse_equation), is_part_2);
+
+  return std::to_string(accumulator);
+}
 
+std::string Solution::stream_part_2(const std::string &filepath) {
   bool is_part_2 = true;
 
-  TestValue accumulator = sum_valid_results(equations, is_part_2);
+  TestValue accumulator =
+      sum_valid_results(stream_records(filepath, parse_equation), is_part_2);
 
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d07
@@ -1,9 +1,36 @@
 #pragma once
 
-#include <string> // for string
+#include <deque>          // for deque
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <utility>        // for pair
+#include <vector>         // for vector
 
 namespace d07 {
 
+using TestValue = unsigned long long;
+
+using Operands = std::deque<TestValue>;
+
+using Equation = std::pair<TestValue, Operands>;
+
+using Equations = std::vector<Equation>;
+
+struct Solution {
+  using Input = Equations;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &equations);
+
+  static std::string solve_part_2(const Input &equations);
+
+  // Solved a line at a time off the file, in constant memory
+  static std::string stream_part_1(const std::string &filepath);
+
+  static std::string stream_part_2(const std::string &filepath);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
@@ -1,18 +1,18 @@
 #include <_ctype.h>     // for isalnum
+#include <bit_grid.hpp> // for BitGrid
 #include <cctype>       // for isalnum
-#include <core_lib.hpp> // for Position, Coordinate, get_lines_from_file
+#include <core_lib.hpp> // for Position, Coordinate, get_lines
 #include <d08.hpp>
-#include <set>           // for set
-#include <stddef.h>      // for size_t
-#include <string>        // for string, to_string, basic_string
-#include <unordered_map> // for __hash_map_iterator, operator==, unordered_map
-#include <utility>       // for make_pair, pair
-#include <vector>        // for vector
+#include <input_view.hpp> // for InputView
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <string>         // for string, to_string, basic_string
+#include <unordered_map>  // for __hash_map_iterator, operator==, unordered_map
+#include <utility>        // for make_pair, pair
+#include <vector>         // for vector
 
 namespace d08 {
 
-using AntennaMap = Grid;
-
 using Antenna = Tile;
 
 using Positions = std::vector<Position>;
@@ -68,7 +68,8 @@ Position get_antinode_position(const Position &base, const Position &second) {
 
 int count_unique_antinode_positions(const AntennaMap &antenna_map,
                                     const bool is_part_2 = false) {
-  std::set<Position> unique_positions;
+  // Everything inserted is in bounds, so a bit per tile of the map will do
+  BitGrid unique_positions(antenna_map.size(), antenna_map.front().size());
   const AntennaPositions antenna_positions = get_antenna_positions(antenna_map);
 
   for (const auto &[_, positions] : antenna_positions) {
@@ -83,14 +84,14 @@ int count_unique_antinode_positions(const AntennaMap &antenna_map,
           const auto antinode_position = get_antinode_position(
               positions[base_index], positions[second_index]);
           if (is_in_bounds(antenna_map, antinode_position)) {
-            unique_positions.insert(antinode_position);
+            unique_positions.set(antinode_position);
           }
         } else {
           // Part 2
           // All pairs of antennae will have antinodes on the antennae positions
           // themselves
-          unique_positions.insert(positions[base_index]);
-          unique_positions.insert(positions[second_index]);
+          unique_positions.set(positions[base_index]);
+          unique_positions.set(positions[second_index]);
           const auto antinode_position_diff = get_antinode_position_diff(
               positions[base_index], positions[second_index]);
           auto [antinode_row_diff, antinode_col_diff] = antinode_position_diff;
@@ -99,7 +100,7 @@ int count_unique_antinode_positions(const AntennaMap &antenna_map,
           base_col += antinode_col_diff;
           auto antinode_position = std::make_pair(base_row, base_col);
           while (is_in_bounds(antenna_map, antinode_position)) {
-            unique_positions.insert(antinode_position);
+            unique_positions.set(antinode_position);
             base_row += antinode_row_diff;
             base_col += antinode_col_diff;
             antinode_position = std::make_pair(base_row, base_col);
@@ -109,13 +110,14 @@ int count_unique_antinode_positions(const AntennaMap &antenna_map,
     }
   }
 
-  return unique_positions.size();
+  return unique_positions.count();
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const AntennaMap antenna_map = get_lines_from_file(filepath);
+AntennaMap Solution::parse(const InputView &input) {
+  return get_lines(input);
+}
 
+std::string Solution::solve_part_1(const AntennaMap &antenna_map) {
   bool is_part_2 = false;
 
   int accumulator = count_unique_antinode_positions(antenna_map, is_part_2);
@@ -123,10 +125,7 @@ std::string part_1(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const AntennaMap antenna_map = get_lines_from_file(filepath);
-
+std::string Solution::solve_part_2(const AntennaMap &antenna_map) {
   bool is_part_2 = true;
 
   int accumulator = count_unique_antinode_positions(antenna_map, is_part_2);
@@ -134,4 +133,12 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d08
@@ -1,20 +1,17 @@
 #include <d09.hpp>
-#include <deque>    // for deque, __deque_iterator
-#include <fstream>  // for basic_istream, basic_ostream, endl, operator<<
-#include <iostream> // for cout
-#include <stddef.h> // for size_t
-#include <string>   // for char_traits, string, to_string
-#include <utility>  // for pair, make_pair, swap
-#include <vector>   // for vector
+#include <deque>          // for deque, __deque_iterator
+#include <input_view.hpp> // for InputView
+#include <iostream>       // for basic_ostream, endl, operator<<, cout
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <string>         // for char_traits, string, to_string
+#include <utility>        // for pair, make_pair, swap
+#include <vector>         // for vector
 
 namespace d09 {
 
-using NumBlocks = unsigned long long;
-
 using FileId = long long;
 
-using DefragMap = std::vector<NumBlocks>;
-
 using DiskLayout = std::vector<FileId>;
 
 using Index = long long;
@@ -24,17 +21,13 @@ using SpanPosition = std::pair<Index, Length>;
 
 using SpanPositions = std::deque<SpanPosition>;
 
-DefragMap get_defrag_map_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
-
-  std::string defrag_map_str;
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
-    defrag_map_str += line;
-  }
-
+DefragMap get_defrag_map(const InputView &input) {
   DefragMap defrag_map;
-  for (const auto character : defrag_map_str) {
-    defrag_map.push_back(character - '0');
+  defrag_map.reserve(input.size());
+  for (const auto line : input.lines()) {
+    for (const auto character : line) {
+      defrag_map.push_back(character - '0');
+    }
   }
 
   return defrag_map;
@@ -226,20 +219,28 @@ NumBlocks get_part_2_checksum(const DefragMap &defrag_map) {
   return checksum;
 }
 
-std::string part_1(const std::string &filepath) {
-  const auto defrag_map = get_defrag_map_from_file(filepath);
+DefragMap Solution::parse(const InputView &input) {
+  return get_defrag_map(input);
+}
 
+std::string Solution::solve_part_1(const DefragMap &defrag_map) {
   NumBlocks accumulator = get_part_1_checksum(defrag_map);
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-  const auto defrag_map = get_defrag_map_from_file(filepath);
-
+std::string Solution::solve_part_2(const DefragMap &defrag_map) {
   NumBlocks accumulator = get_part_2_checksum(defrag_map);
 
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d09
@@ -1,9 +1,25 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 namespace d09 {
 
+using NumBlocks = unsigned long long;
+
+using DefragMap = std::vector<NumBlocks>;
+
+struct Solution {
+  using Input = DefragMap;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &defrag_map);
+
+  static std::string solve_part_2(const Input &defrag_map);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
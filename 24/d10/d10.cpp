@@ -1,31 +1,28 @@
 #include <array>        // for array
-#include <core_lib.hpp> // for Position, Tile, get_lines_from_file, Coordinate
+#include <core_lib.hpp> // for FlatIndex, FlatGrid, Tile
 #include <d10.hpp>
-#include <deque>   // for deque
-#include <set>     // for set
-#include <string>  // for basic_string, string, to_string
-#include <utility> // for pair
-#include <vector>  // for vector
+#include <input_view.hpp> // for InputView
+#include <instrument.hpp> // for AOC_SCOPE, AOC_COUNT
+#include <search.hpp>     // for SearchState, StateId, breadth_first_search
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <string>         // for basic_string, string, to_string
+#include <vector>         // for vector
 
 namespace d10 {
 
-using ElevationMap = Grid;
-
-using Positions = std::vector<Position>;
+using Positions = std::vector<FlatIndex>;
 
 constexpr Tile TRAILHEAD = '0';
 constexpr Tile TRAILEND = '9';
 
-constexpr std::array<Position, 4> MOVE_DIRECTIONS = {
-    {{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+// Never one step up from any elevation
+constexpr Tile OFF_MAP = ' ';
 
 Positions get_trailhead_positions(const ElevationMap &elev_map) {
   Positions trailhead_positions;
-  for (Coordinate row{}; row < elev_map.size(); ++row) {
-    for (Coordinate col{}; col < elev_map[row].size(); ++col) {
-      if (elev_map[row][col] == TRAILHEAD) {
-        trailhead_positions.emplace_back(row, col);
-      }
+  for (const auto index : elev_map.interior_indices()) {
+    if (elev_map[index] == TRAILHEAD) {
+      trailhead_positions.push_back(index);
     }
   }
   return trailhead_positions;
@@ -35,39 +32,16 @@ bool is_elevation_gradually_increasing(const Tile start, const Tile end) {
   return (end - start) == 1;
 }
 
-Positions get_trailend_positions(const ElevationMap &elev_map,
-                                 const Position &trailhead) {
-
-  Positions trailends;
-
-  std::deque<Position> locations_to_check;
-
-  locations_to_check.push_back(trailhead);
-
-  while (!locations_to_check.empty()) {
-    const auto [start_row, start_col] = locations_to_check.front();
-    locations_to_check.pop_front();
-
-    if (elev_map[start_row][start_col] == TRAILEND) {
-      trailends.emplace_back(start_row, start_col);
-      continue;
-    }
-    for (const auto &[move_row, move_col] : MOVE_DIRECTIONS) {
-      const auto new_row = start_row + move_row;
-      const auto new_col = start_col + move_col;
-      if (!is_in_bounds(elev_map, new_row, new_col)) {
-        continue;
-      }
-      if (!is_elevation_gradually_increasing(elev_map[start_row][start_col],
-                                             elev_map[new_row][new_col])) {
-        continue;
-      }
-      // In bounds and we are gradually increasing
-      locations_to_check.emplace_back(new_row, new_col);
+// Every step of a trail goes one up in elevation
+void for_each_next_step(const ElevationMap &elev_map, const StateId state,
+                        const auto &visit) {
+  for (const auto move : elev_map.neighbour_offsets()) {
+    const FlatIndex next = state + move;
+    // The border is never gradually increasing, so no bounds check needed
+    if (is_elevation_gradually_increasing(elev_map[state], elev_map[next])) {
+      visit(StateId(next));
     }
   }
-
-  return trailends;
 }
 
 int count_unique_trailheads(const ElevationMap &elev_map) {
@@ -75,12 +49,20 @@ int count_unique_trailheads(const ElevationMap &elev_map) {
 
   const Positions trailhead_positions = get_trailhead_positions(elev_map);
 
-  for (const auto &trailhead_position : trailhead_positions) {
-    const auto trailend_positions =
-        get_trailend_positions(elev_map, trailhead_position);
-    const std::set<Position> unique_positions(trailend_positions.begin(),
-                                              trailend_positions.end());
-    accumulator += unique_positions.size();
+  // Shared by every trailhead, and only cleared where the last one reached
+  SearchState<> search(elev_map.size());
+  const auto next_steps = [&elev_map](const StateId state, const auto &visit) {
+    for_each_next_step(elev_map, state, visit);
+  };
+
+  AOC_SCOPE("trail search");
+  for (const auto trailhead_position : trailhead_positions) {
+    breadth_first_search(search, std::array{StateId(trailhead_position)},
+                         next_steps);
+    AOC_COUNT("locations checked", search.reached().size());
+    for (const auto position : search.reached()) {
+      accumulator += int(elev_map[position] == TRAILEND);
+    }
   }
 
   return accumulator;
@@ -90,31 +72,58 @@ int count_unique_trails(const ElevationMap &elev_map) {
   int accumulator = 0;
 
   const Positions trailhead_positions = get_trailhead_positions(elev_map);
-
-  for (const auto &trailhead_position : trailhead_positions) {
-    const auto trailend_positions =
-        get_trailend_positions(elev_map, trailhead_position);
-    accumulator += trailend_positions.size();
+  const std::vector<StateId> sources(trailhead_positions.begin(),
+                                     trailhead_positions.end());
+
+  SearchState<> search(elev_map.size());
+  const auto next_steps = [&elev_map](const StateId state, const auto &visit) {
+    for_each_next_step(elev_map, state, visit);
+  };
+
+  AOC_SCOPE("trail search");
+  // Searching from every trailhead at once reaches each tile at a distance of
+  // its elevation, so in order of elevation, after every tile one step below.
+  // Trails to a tile can then be added up from the tiles below in one pass.
+  breadth_first_search(search, sources, next_steps);
+  AOC_COUNT("locations checked", search.reached().size());
+  std::vector<int> num_trails_to(elev_map.size());
+  for (const auto trailhead_position : trailhead_positions) {
+    num_trails_to[trailhead_position] = 1;
+  }
+  for (const auto position : search.reached()) {
+    if (elev_map[position] == TRAILEND) {
+      accumulator += num_trails_to[position];
+      continue;
+    }
+    next_steps(position, [&](const StateId next) {
+      num_trails_to[next] += num_trails_to[position];
+    });
   }
 
   return accumulator;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const ElevationMap elev_map = get_lines_from_file(filepath);
+ElevationMap Solution::parse(const InputView &input) {
+  return FlatGrid(input.lines(), OFF_MAP);
+}
 
+std::string Solution::solve_part_1(const ElevationMap &elev_map) {
   int accumulator = count_unique_trailheads(elev_map);
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const ElevationMap elev_map = get_lines_from_file(filepath);
-
+std::string Solution::solve_part_2(const ElevationMap &elev_map) {
   int accumulator = count_unique_trails(elev_map);
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d10
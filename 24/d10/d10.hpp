@@ -1,9 +1,23 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for FlatGrid
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
 
 namespace d10 {
 
+using ElevationMap = FlatGrid;
+
+struct Solution {
+  using Input = ElevationMap;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &elev_map);
+
+  static std::string solve_part_2(const Input &elev_map);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
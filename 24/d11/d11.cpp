@@ -1,27 +1,24 @@
 #include <cmath> // for floor, log10, pow
 #include <d11.hpp>
-#include <fstream>  // for basic_istream, basic_ifstream, ifstream
-#include <map>      // for __map_const_iterator, map
-#include <stddef.h> // for size_t
-#include <string>   // for string, to_string
-#include <utility>  // for make_pair, pair
-#include <vector>   // for vector
+#include <input_view.hpp> // for InputView
+#include <map>            // for __map_const_iterator, map
+#include <scanner.hpp>    // for Scanner
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <string>         // for string, to_string
+#include <utility>        // for make_pair, pair
+#include <vector>         // for vector
 
 namespace d11 {
-using Stone = long long;
-using Stones = std::vector<Stone>;
-
 using UniqueStoneCounts = std::map<Stone, size_t>;
 
-Stones get_stones_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+Stones get_stones(const InputView &input) {
+  Scanner scanner(input.data());
 
   Stones stones;
 
-  Stone stone{};
-
-  while (in_stream >> stone) {
-    stones.push_back(stone);
+  while (scanner.skip_to_int()) {
+    stones.push_back(Stone(scanner.next_int()));
   }
 
   return stones;
@@ -79,10 +76,11 @@ UniqueStoneCounts create_counts(const Stones &stones) {
   return counts;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const auto stones = get_stones_from_file(filepath);
+Stones Solution::parse(const InputView &input) {
+  return get_stones(input);
+}
 
+std::string Solution::solve_part_1(const Stones &stones) {
   UniqueStoneCounts counts = create_counts(stones);
 
   counts = do_n_blinks(counts, 25);
@@ -90,10 +88,7 @@ std::string part_1(const std::string &filepath) {
   return std::to_string(get_total_count(counts));
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const auto stones = get_stones_from_file(filepath);
-
+std::string Solution::solve_part_2(const Stones &stones) {
   UniqueStoneCounts counts = create_counts(stones);
 
   counts = do_n_blinks(counts, 75);
@@ -101,4 +96,12 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(get_total_count(counts));
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d11
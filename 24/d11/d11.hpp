@@ -1,9 +1,24 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 namespace d11 {
 
+using Stone = long long;
+using Stones = std::vector<Stone>;
+
+struct Solution {
+  using Input = Stones;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &stones);
+
+  static std::string solve_part_2(const Input &stones);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
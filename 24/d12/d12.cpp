@@ -1,46 +1,45 @@
 #include <algorithm>    // for sort
-#include <array>        // for array
-#include <core_lib.hpp> // for Position, Coordinate, get_lines_from_file
+#include <arena.hpp>    // for Arena
+#include <bit_grid.hpp> // for BitGrid
+#include <core_lib.hpp> // for FlatIndex, FlatGrid, Coordinate, Tile
 #include <d12.hpp>
-#include <deque>    // for deque
-#include <map>      // for map, __map_iterator
-#include <set>      // for set, __tree_const_iterator
-#include <stddef.h> // for size_t
-#include <string>   // for basic_string, string, to_string
-#include <utility>  // for pair, make_pair
-#include <vector>   // for vector
+#include <deque>           // for deque
+#include <input_view.hpp>  // for InputView
+#include <map>             // for map, __map_iterator
+#include <memory_resource> // for memory_resource
+#include <solver.hpp>      // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>        // for size_t
+#include <string>          // for basic_string, string, to_string
+#include <utility>         // for pair, make_pair
+#include <vector>          // for vector
 
 namespace d12 {
 
-using Garden = Grid;
-
 using Unit = long long;
 
 using Heading = Coordinate;
 
 using HeadingCoordinatePair = std::pair<Heading, Coordinate>;
 
-using HeadingPositionPair = std::pair<Heading, Position>;
-
-constexpr Heading NORTH = 3;
-constexpr Heading EAST = 0;
-constexpr Heading SOUTH = 1;
-constexpr Heading WEST = 2;
+using HeadingPositionPair = std::pair<Heading, FlatIndex>;
 
-constexpr std::array<Position, 4> MOVEMENTS = {
-    {{0, 1}, {1, 0}, {0, -1}, {-1, 0}}};
+// Match the order of the FlatGrid neighbour offsets
+constexpr Heading NORTH = 0;
+constexpr Heading EAST = 1;
+constexpr Heading SOUTH = 2;
+constexpr Heading WEST = 3;
 
-constexpr Tile SEEN = '_';
+constexpr Tile OUTSIDE = ' ';
 
 bool is_same_area(const Garden &garden, const Tile region_type,
-                  const Position &position) {
-  const auto [row, col] = position;
-  return is_in_bounds(garden, position) && region_type == garden[row][col];
+                  const FlatIndex position) {
+  return region_type == garden[position];
 }
 
 Unit count_sides(
-    const Garden &garden, const Position &region,
-    const std::set<HeadingPositionPair> &sides_touching_perimeter) {
+    const Garden &garden, const FlatIndex region,
+    const std::pmr::vector<HeadingPositionPair> &sides_touching_perimeter,
+    std::pmr::memory_resource *memory) {
   Unit num_sides = 0;
 
   // Need to keep track of continuous sides
@@ -49,8 +48,8 @@ Unit count_sides(
 
   // merge those that touch into single sides until no more merging?
 
-  // index 0, 2 move columns
-  // index 1, 3 move rows
+  // index 1, 3 move columns
+  // index 0, 2 move rows
   // Map pair of (movement_index, coordinate not affected by movement (e.g. col
   // if moves columns)) to other coordinate
 
@@ -60,15 +59,17 @@ Unit count_sides(
   // need to check if the other coordinates found with this unique heading and
   // coordinate pair are contiguous
 
-  //   3
-  // 2-|-0
-  //   1
+  //   0
+  // 3-|-1
+  //   2
 
-  std::map<HeadingCoordinatePair, std::vector<Coordinate>> side_segments;
+  // The segment vectors pick up the arena from the map
+  std::pmr::map<HeadingCoordinatePair, std::pmr::vector<Coordinate>>
+      side_segments(memory);
 
   // Collect segments to detect if contiguous
   for (const auto &[movement_index, position] : sides_touching_perimeter) {
-    const auto [row, col] = position;
+    const auto [row, col] = garden.to_position(position);
     if (movement_index == EAST || movement_index == WEST) {
       const HeadingCoordinatePair unique_side =
           std::make_pair(movement_index, col);
@@ -94,97 +95,87 @@ Unit count_sides(
   return num_sides;
 }
 
-Unit get_region_price(Garden &garden, const Position region,
+// seen is shared by every region. Tiles of the same type that touch are always
+// the same region, so any tile seen before is either in this region or cannot
+// be reached from it.
+Unit get_region_price(const Garden &garden, const FlatIndex region,
+                      BitGrid &seen, std::pmr::memory_resource *memory,
                       const bool is_part_2 = false) {
-  auto [start_row, start_col] = region;
-
-  const Tile region_type = garden[start_row][start_col];
+  const Tile region_type = garden[region];
 
   Unit area = 0;
   Unit perimeter = 0;
-  std::deque<Position> attempts{{region}};
+  std::pmr::deque<FlatIndex> attempts({region}, memory);
 
-  std::set<Position> seen{};
+  // Each tile is only expanded once, so no side is ever added twice
+  std::pmr::vector<HeadingPositionPair> sides_touching_perimeter(memory);
 
-  std::set<HeadingPositionPair> sides_touching_perimeter;
+  const auto &movements = garden.neighbour_offsets();
 
   while (!attempts.empty()) {
-    auto attempt = attempts.front();
-    auto [row, col] = attempt;
+    const auto attempt = attempts.front();
     attempts.pop_front();
-    if (seen.count(attempt) > 0) {
+    if (seen.test_and_set(0, attempt)) {
       continue;
     }
-    seen.insert(attempt);
+    ++area;
 
-    for (Coordinate movement_index = 0; movement_index < MOVEMENTS.size();
+    for (Heading movement_index = 0; movement_index < movements.size();
          ++movement_index) {
-      const auto &movement = MOVEMENTS[movement_index];
-      const auto [row_incr, col_incr] = movement;
+      const FlatIndex new_pos = attempt + movements[movement_index];
 
-      const auto new_row = row + row_incr;
-      const auto new_col = col + col_incr;
-      const auto new_pos = std::make_pair(new_row, new_col);
-
-      if (!is_in_bounds(garden, new_pos)) {
-        sides_touching_perimeter.insert(
-            std::make_pair(movement_index, attempt));
-        continue;
-      }
-      if (garden[new_row][new_col] != region_type) {
-        sides_touching_perimeter.insert(
-            std::make_pair(movement_index, attempt));
+      // Stepping onto the border is always a different region
+      if (!is_same_area(garden, region_type, new_pos)) {
+        sides_touching_perimeter.emplace_back(movement_index, attempt);
         continue;
       }
-      if (seen.count(new_pos) > 0) {
+      if (seen.test(0, new_pos)) {
         continue;
       }
       attempts.push_back(new_pos);
     }
   }
 
-  area = seen.size();
-
   if (is_part_2) {
     if (area <= 2) {
       perimeter = 4;
     } else {
-      perimeter = count_sides(garden, region, sides_touching_perimeter);
+      perimeter =
+          count_sides(garden, region, sides_touching_perimeter, memory);
     }
   } else {
     perimeter = sides_touching_perimeter.size();
   }
 
-  for (const auto &position : seen) {
-    auto [row, col] = position;
-    garden[row][col] = SEEN;
-  }
-
   return area * perimeter;
 }
 
-Unit get_total_price(const Garden &input_garden, const bool is_part_2 = false) {
+Unit get_total_price(const Garden &garden, const bool is_part_2 = false) {
   Unit accumulator{};
 
-  Garden garden(input_garden);
+  // A bit per tile of the garden
+  BitGrid seen(1, garden.size());
 
-  for (Coordinate row{}; row < garden.size(); ++row) {
-    for (Coordinate col{}; col < garden[row].size(); ++col) {
-      if (garden[row][col] == SEEN) {
-        continue;
-      }
-      Position new_region = std::make_pair(row, col);
-      accumulator += get_region_price(garden, new_region, is_part_2);
+  // Nothing else survives from one region to the next, so each starts from an
+  // empty arena
+  Arena arena;
+  for (const auto index : garden.interior_indices()) {
+    if (seen.test(0, index)) {
+      continue;
     }
+    accumulator +=
+        get_region_price(garden, index, seen, arena.resource(), is_part_2);
+    arena.release();
   }
 
   return accumulator;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const Garden garden = get_lines_from_file(filepath);
+Garden Solution::parse(const InputView &input) {
+  return FlatGrid(input.lines(), OUTSIDE);
+}
 
+std::string Solution::solve_part_1(const Garden &garden) {
   bool is_part_2 = false;
 
   Unit accumulator = get_total_price(garden, is_part_2);
@@ -192,10 +183,7 @@ std::string part_1(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const Garden garden = get_lines_from_file(filepath);
-
+std::string Solution::solve_part_2(const Garden &garden) {
   bool is_part_2 = true;
 
   Unit accumulator = get_total_price(garden, is_part_2);
@@ -203,4 +191,12 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d12
@@ -1,9 +1,23 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for FlatGrid
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
 
 namespace d12 {
 
+using Garden = FlatGrid;
+
+struct Solution {
+  using Input = Garden;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &garden);
+
+  static std::string solve_part_2(const Input &garden);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
@@ -2,81 +2,82 @@
 #include <cmath>     // for llround
 #include <core_lib.hpp>
 #include <d13.hpp>
-#include <fstream>   // for basic_ostream, operator<<, endl, basic_istream
-#include <iostream>  // for cout, cerr
-#include <stddef.h>  // for size_t
-#include <stdexcept> // for runtime_error
-#include <string>    // for char_traits, stoll, string
-#include <utility>   // for make_pair, pair
-#include <vector>    // for vector
+#include <input_view.hpp>    // for InputView
+#include <iostream>          // for basic_ostream, operator<<, endl, cout, cerr
+#include <record_stream.hpp> // for stream_records
+#include <scanner.hpp>       // for Scanner
+#include <solver.hpp>        // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>          // for size_t
+#include <stdexcept>         // for runtime_error
+#include <string>            // for string
+#include <string_view>       // for string_view
+#include <utility>           // for make_pair, pair
+#include <vector>            // for vector
 
 namespace d13 {
 
-using Increment = Position;
-
 using Tokens = long long;
 
-struct Equation {
-  Increment m_ButtonA;
-  Increment m_ButtonB;
-  Position m_Prize;
-};
-
 constexpr Tokens BUTTON_A_COST = 3;
 constexpr Tokens BUTTON_B_COST = 1;
 
-using Equations = std::vector<Equation>;
-
-Increment parse_button(const std::string &line) {
-  size_t pos = line.find_first_of("X+");
-  if (pos == std::string::npos) {
-    throw std::runtime_error("Unexpected end of line!");
-  }
-  // Skip over "X+"
-  pos += 2;
-  size_t comma = line.find_first_of(",", pos);
-  if (comma == std::string::npos) {
+// Button A: X+94, Y+34
+Increment parse_button(const std::string_view line) {
+  Scanner scanner(line);
+  scanner.expect("Button ");
+  // Skip over the button name
+  if (!scanner.skip_to_int()) {
     throw std::runtime_error("Unexpected end of line!");
   }
-  Coordinate x_increment = std::stoll(line.substr(pos, comma - pos));
-  // length of ", Y+", laziness on my part
-  pos = comma + 4;
-  Coordinate y_increment = std::stoll(line.substr(pos, line.size() - pos));
+  const Coordinate x_increment = scanner.next_int();
+  scanner.expect(", Y");
+  const Coordinate y_increment = scanner.next_int();
   return std::make_pair(x_increment, y_increment);
 }
 
-Position parse_prize(const std::string &line) {
-  size_t pos = line.find_first_of("X=");
-  if (pos == std::string::npos) {
-    throw std::runtime_error("Unexpected end of line!");
-  }
-  // Skip over "X="
-  pos += 2;
-  size_t comma = line.find_first_of(",", pos);
-  if (comma == std::string::npos) {
-    throw std::runtime_error("Unexpected end of line!");
-  }
-  Coordinate x_coordinate = std::stoll(line.substr(pos, comma - pos));
-  // length of ", Y=", laziness on my part
-  pos = comma + 4;
-  Coordinate y_coordinate = std::stoll(line.substr(pos, line.size() - pos));
+// Prize: X=8400, Y=5400
+Position parse_prize(const std::string_view line) {
+  Scanner scanner(line);
+  scanner.expect("Prize: X=");
+  const Coordinate x_coordinate = scanner.next_int();
+  scanner.expect(", Y=");
+  const Coordinate y_coordinate = scanner.next_int();
   return std::make_pair(x_coordinate, y_coordinate);
 }
 
-Equations get_equations_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+// Both buttons, then the prize, one to a line
+Equation parse_equation(const std::string_view block) {
+  const size_t first_newline = block.find('\n');
+  const size_t second_newline = block.find('\n', first_newline + 1);
+  if (first_newline == std::string_view::npos ||
+      second_newline == std::string_view::npos) {
+    throw std::runtime_error("Unexpected end of file!");
+  }
+  Equation equation;
+  equation.m_ButtonA = parse_button(block.substr(0, first_newline));
+  equation.m_ButtonB = parse_button(
+      block.substr(first_newline + 1, second_newline - first_newline - 1));
+  equation.m_Prize = parse_prize(block.substr(second_newline + 1));
+  return equation;
+}
+
+Equations get_equations(const InputView &input) {
+  const auto &lines = input.lines();
 
   Equations equations;
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
-    if (line.size() == 0) {
+  for (size_t line_index = 0; line_index < lines.size(); ++line_index) {
+    if (lines[line_index].size() == 0) {
       continue;
     }
+    if (line_index + 2 >= lines.size()) {
+      throw std::runtime_error("Unexpected end of file!");
+    }
     Equation equation;
-    equation.m_ButtonA = parse_button(line);
-    std::getline(in_stream, line);
-    equation.m_ButtonB = parse_button(line);
-    std::getline(in_stream, line);
-    equation.m_Prize = parse_prize(line);
+    equation.m_ButtonA = parse_button(lines[line_index]);
+    ++line_index;
+    equation.m_ButtonB = parse_button(lines[line_index]);
+    ++line_index;
+    equation.m_Prize = parse_prize(lines[line_index]);
     equations.push_back(equation);
   }
 
@@ -193,7 +194,9 @@ Tokens get_minimized_cost(const Equation &equation) {
   return *std::min_element(total_costs.begin(), total_costs.end());
 }
 
-Tokens get_total_minimized_cost(const Equations &equations) {
+// Over either the parsed equations or a stream of them
+template <typename EquationRange>
+Tokens get_total_minimized_cost(EquationRange &&equations) {
   Tokens cost = 0;
   for (const auto &equation : equations) {
     cost += get_minimized_cost(equation);
@@ -201,27 +204,33 @@ Tokens get_total_minimized_cost(const Equations &equations) {
   return cost;
 }
 
+Equation convert_equation_part_2(const Equation &equation) {
+  Equation new_equation(equation);
+  new_equation.m_Prize.first += 10000000000000;
+  new_equation.m_Prize.second += 10000000000000;
+  return new_equation;
+}
+
 Equations convert_equations_part_2(const Equations &equations) {
-  Equations new_equations(equations);
-  for (auto &new_equation : new_equations) {
-    new_equation.m_Prize.first += 10000000000000;
-    new_equation.m_Prize.second += 10000000000000;
+  Equations new_equations;
+  new_equations.reserve(equations.size());
+  for (const auto &equation : equations) {
+    new_equations.push_back(convert_equation_part_2(equation));
   }
   return new_equations;
 }
 
-std::string part_1(const std::string &filepath) {
-  const auto equations = get_equations_from_file(filepath);
+Equations Solution::parse(const InputView &input) {
+  return get_equations(input);
+}
 
+std::string Solution::solve_part_1(const Equations &equations) {
   Tokens accumulator = get_total_minimized_cost(equations);
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const auto equations = get_equations_from_file(filepath);
-
+std::string Solution::solve_part_2(const Equations &equations) {
   const auto new_equations = convert_equations_part_2(equations);
 
   Tokens accumulator = get_total_minimized_cost(new_equations);
@@ -229,4 +238,30 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
+std::string Solution::stream_part_1(const std::string &filepath) {
+  Tokens accumulator = get_total_minimized_cost(
+      stream_records(filepath, parse_equation, "\n\n"));
+
+  return std::to_string(accumulator);
+}
+
+std::string Solution::stream_part_2(const std::string &filepath) {
+  const auto parse_equation_part_2 = [](const std::string_view block) {
+    return convert_equation_part_2(parse_equation(block));
+  };
+
+  Tokens accumulator = get_total_minimized_cost(
+      stream_records(filepath, parse_equation_part_2, "\n\n"));
+
+  return std::to_string(accumulator);
+}
+
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d13
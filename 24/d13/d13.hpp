@@ -1,9 +1,37 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for Position
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 namespace d13 {
 
+using Increment = Position;
+
+struct Equation {
+  Increment m_ButtonA;
+  Increment m_ButtonB;
+  Position m_Prize;
+};
+
+using Equations = std::vector<Equation>;
+
+struct Solution {
+  using Input = Equations;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &equations);
+
+  static std::string solve_part_2(const Input &equations);
+
+  // Solved a machine at a time off the file, in constant memory
+  static std::string stream_part_1(const std::string &filepath);
+
+  static std::string stream_part_2(const std::string &filepath);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
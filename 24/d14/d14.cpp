@@ -1,64 +1,42 @@
 #include <core_lib.hpp>
 #include <d14.hpp>
-#include <fstream>   // for basic_ostream, operator<<, endl, basic_istream
-#include <iostream>  // for cout, cerr
-#include <stddef.h>  // for size_t
-#include <stdexcept> // for runtime_error
-#include <string>    // for char_traits, stoll, string
-#include <utility>   // for make_pair, pair
-#include <vector>    // for vector
+#include <input_view.hpp>    // for InputView
+#include <instrument.hpp>    // for AOC_SCOPE
+#include <iostream>          // for basic_ostream, operator<<, endl, cout, cerr
+#include <record_stream.hpp> // for stream_records
+#include <scanner.hpp>       // for Scanner
+#include <solver.hpp>        // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>          // for size_t
+#include <stdexcept>         // for runtime_error
+#include <string>            // for string
+#include <string_view>       // for string_view
+#include <utility>           // for make_pair, pair
+#include <vector>            // for vector
 
 namespace d14 {
 
-using Velocity = Position;
-
-struct Robot {
-  Position m_Position;
-  Velocity m_Velocity;
-};
-
-using Robots = std::vector<Robot>;
-
 constexpr Coordinate GRID_HEIGHT = 103;
 constexpr Coordinate GRID_WIDTH = 101;
 
-void parse_robot(const std::string &line, Robot &robot) {
-  size_t pos = line.find_first_of("p=");
-  if (pos == std::string::npos) {
-    throw std::runtime_error("Unexpected end of line!");
-  }
-  // Skip over "p="
-  pos += 2;
-  size_t comma = line.find_first_of(",", pos);
-  if (comma == std::string::npos) {
-    throw std::runtime_error("Unexpected end of line!");
-  }
-  Coordinate x_coordinate = std::stoll(line.substr(pos, comma - pos));
-  pos = comma + 1;
-  size_t v_pos = line.find_first_of(" v=", pos);
-  if (v_pos == std::string::npos) {
-    throw std::runtime_error("Unexpected end of line!");
-  }
-  Coordinate y_coordinate = std::stoll(line.substr(pos, v_pos - pos));
+// p=0,4 v=3,-3
+void parse_robot(const std::string_view line, Robot &robot) {
+  Scanner scanner(line);
+  scanner.expect("p=");
+  const Coordinate x_coordinate = scanner.next_int();
+  scanner.expect(",");
+  const Coordinate y_coordinate = scanner.next_int();
   robot.m_Position = std::make_pair(x_coordinate, y_coordinate);
 
-  // Skip over " v="
-  pos = v_pos + 3;
-  comma = line.find_first_of(",", pos);
-  if (comma == std::string::npos) {
-    throw std::runtime_error("Unexpected end of line!");
-  }
-  Coordinate x_velocity = std::stoll(line.substr(pos, comma - pos));
-  pos = comma + 1;
-  Coordinate y_velocity = std::stoll(line.substr(pos, line.size() - pos));
+  scanner.expect(" v=");
+  const Coordinate x_velocity = scanner.next_int();
+  scanner.expect(",");
+  const Coordinate y_velocity = scanner.next_int();
   robot.m_Velocity = std::make_pair(x_velocity, y_velocity);
 }
 
-Robots get_robots_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
-
+Robots get_robots(const InputView &input) {
   Robots robots;
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
+  for (const auto line : input.lines()) {
     Robot robot;
     parse_robot(line, robot);
     robots.push_back(robot);
@@ -95,12 +73,14 @@ void simulate_one_robot_one_second(Robot &robot) {
 }
 
 void simulate_one_second(Robots &robots) {
+  AOC_SCOPE("simulate second");
   for (auto &robot : robots) {
     simulate_one_robot_one_second(robot);
   }
 }
 
-int calculate_safety(const Robots &robots) {
+// Over either the parsed robots or a stream of them
+template <typename RobotRange> int calculate_safety(RobotRange &&robots) {
   int safety_scores[4]{};
 
   for (const auto &robot : robots) {
@@ -155,6 +135,7 @@ int calculate_safety_after_n_seconds(int n_seconds,
 }
 
 bool search_grid(const Robots &robots) {
+  AOC_SCOPE("search grid");
   Grid grid(GRID_HEIGHT, std::string(GRID_WIDTH, ' '));
 
   for (const auto &robot : robots) {
@@ -192,21 +173,45 @@ int find_easter_egg(const Robots &input_robots) {
   return second;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const auto robots = get_robots_from_file(filepath);
+Robots Solution::parse(const InputView &input) {
+  return get_robots(input);
+}
 
+std::string Solution::solve_part_1(const Robots &robots) {
   int accumulator = calculate_safety_after_n_seconds(100, robots);
 
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-  const auto robots = get_robots_from_file(filepath);
-
+std::string Solution::solve_part_2(const Robots &robots) {
   int accumulator = find_easter_egg(robots);
 
   return std::to_string(accumulator);
 }
 
+std::string Solution::stream_part_1(const std::string &filepath) {
+  // Robots never interact, so each can be moved on all 100 seconds by itself
+  const auto parse_robot_after_100_seconds = [](const std::string_view line) {
+    Robot robot;
+    parse_robot(line, robot);
+    for (int second = 0; second < 100; ++second) {
+      simulate_one_robot_one_second(robot);
+    }
+    return robot;
+  };
+
+  int accumulator =
+      calculate_safety(stream_records(filepath, parse_robot_after_100_seconds));
+
+  return std::to_string(accumulator);
+}
+
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d14
@@ -1,9 +1,35 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for Position
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 namespace d14 {
 
+using Velocity = Position;
+
+struct Robot {
+  Position m_Position;
+  Velocity m_Velocity;
+};
+
+using Robots = std::vector<Robot>;
+
+struct Solution {
+  using Input = Robots;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &robots);
+
+  static std::string solve_part_2(const Input &robots);
+
+  // Solved a robot at a time off the file, in constant memory. Part 2 looks
+  // for a picture made by all the robots together, so cannot be streamed.
+  static std::string stream_part_1(const std::string &filepath);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
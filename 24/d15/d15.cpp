@@ -1,18 +1,18 @@
 #include <core_lib.hpp> // for Coordinate, Grid, Tile, Position
 #include <d15.hpp>
-#include <fstream>   // for basic_istream, basic_ifstream, getline, ifst...
-#include <map>       // for map
-#include <set>       // for set, __tree_const_iterator
-#include <stdexcept> // for runtime_error
-#include <string>    // for basic_string, char_traits, string, to_string
-#include <utility>   // for swap, pair, make_pair
+#include <input_view.hpp> // for InputView
+#include <instrument.hpp> // for AOC_SCOPE, AOC_COUNT
+#include <map>            // for map
+#include <set>            // for set, __tree_const_iterator
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stdexcept>      // for runtime_error
+#include <string>         // for basic_string, char_traits, string, to_string
+#include <utility>        // for swap, pair, make_pair
 
 namespace d15 {
 
 using Movement = Position;
 
-using Instructions = std::string;
-
 using Instruction = char;
 
 constexpr Instruction NORTH = '^';
@@ -30,25 +30,22 @@ constexpr Tile BOX = 'O';
 constexpr Tile BOX_LEFT = '[';
 constexpr Tile BOX_RIGHT = ']';
 
-std::pair<Grid, Instructions>
-get_grid_and_instructions_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
-
+Warehouse get_grid_and_instructions(const InputView &input) {
   Grid grid;
   Instructions instructions;
   bool finished_grid = false;
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
+  for (const auto line : input.lines()) {
     if (line.size() == 0) {
       finished_grid = true;
     }
     if (!finished_grid) {
-      grid.push_back(line);
+      grid.emplace_back(line);
     } else {
       instructions += line;
     }
   }
 
-  return std::make_pair(grid, instructions);
+  return {grid, instructions};
 }
 
 Position get_initial_robot_position(const Grid &grid) {
@@ -176,12 +173,14 @@ void simulate_robot(Grid &grid, const Instructions &instructions,
 
   auto [row, col] = initial_position;
 
+  AOC_SCOPE("robot moves");
   for (const auto instruction : instructions) {
     const auto [row_incr, col_incr] = INSTRUCTION_TO_MOVEMENT.at(instruction);
     if ((!is_wide && try_do_move(grid, row, col, row_incr, col_incr)) ||
         (is_wide && try_do_wide_move(grid, row, col, row_incr, col_incr))) {
       row += row_incr;
       col += col_incr;
+      AOC_COUNT("moves made", 1);
     }
   }
 }
@@ -238,10 +237,12 @@ Grid widen_grid(const Grid &input_grid) {
   return grid;
 }
 
-std::string part_1(const std::string &filepath) {
+Warehouse Solution::parse(const InputView &input) {
+  return get_grid_and_instructions(input);
+}
 
-  const auto [grid, instructions] =
-      get_grid_and_instructions_from_file(filepath);
+std::string Solution::solve_part_1(const Warehouse &warehouse) {
+  const auto &[grid, instructions] = warehouse;
 
   bool is_wide = false;
 
@@ -251,10 +252,8 @@ std::string part_1(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const auto [grid, instructions] =
-      get_grid_and_instructions_from_file(filepath);
+std::string Solution::solve_part_2(const Warehouse &warehouse) {
+  const auto &[grid, instructions] = warehouse;
 
   bool is_wide = true;
 
@@ -266,4 +265,12 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d15
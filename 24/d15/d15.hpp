@@ -1,9 +1,28 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for Grid
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
 
 namespace d15 {
 
+using Instructions = std::string;
+
+struct Warehouse {
+  Grid m_grid;
+  Instructions m_instructions;
+};
+
+struct Solution {
+  using Input = Warehouse;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &warehouse);
+
+  static std::string solve_part_2(const Input &warehouse);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
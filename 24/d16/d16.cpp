@@ -1,14 +1,17 @@
+#include <algorithm>    // for min
 #include <array>        // for array
-#include <core_lib.hpp> // for Coordinate, get_lines_from_file, Tile, Grid
+#include <bit_grid.hpp> // for BitGrid
+#include <core_lib.hpp> // for FlatGrid, FlatIndex, Coordinate, Tile, NUM...
+#include <cstdint>      // for uint32_t
 #include <d16.hpp>
-#include <deque>     // for deque
-#include <limits>    // for numeric_limits
-#include <set>       // for set, operator!=, __tree_const_iterator
-#include <stdexcept> // for runtime_error
-#include <string>    // for basic_string, string, to_string
-#include <tuple>     // for get, tuple, make_tuple, operator==
-#include <utility>   // for pair, make_pair
-#include <vector>    // for vector
+#include <input_view.hpp> // for InputView
+#include <instrument.hpp> // for AOC_SCOPE, AOC_COUNT
+#include <search.hpp>     // for StateId, SearchState, LayeredStates, dijk...
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <stdexcept>      // for runtime_error
+#include <string>         // for basic_string, string, to_string
+#include <vector>         // for vector
 
 namespace d16 {
 
@@ -16,160 +19,128 @@ constexpr Tile START = 'S';
 constexpr Tile WALL = '#';
 constexpr Tile END = 'E';
 
-using Score = long long;
+using Score = uint32_t;
 
 using Heading = Coordinate;
 
-using HeadingPosition = std::tuple<Heading, Coordinate, Coordinate>;
-
 // constexpr Heading NORTH = 0;
 constexpr Heading EAST = 1;
 // constexpr Heading SOUTH = 2;
 // constexpr Heading WEST = 3;
 
-using Movement = Position;
+constexpr Coordinate NUM_DIRECTIONS = NUM_NEIGHBOURS;
 
-constexpr Coordinate NUM_DIRECTIONS = 4;
+constexpr Score STEP_SCORE = 1;
+constexpr Score TURN_SCORE = 1000;
 
-constexpr std::array<Movement, NUM_DIRECTIONS> HEADING_TO_MOVEMENT = {
-    {{-1, 0}, {0, 1}, {1, 0}, {0, -1}}};
+// Every (heading, tile) pair is a state of its own
+LayeredStates make_states(const FlatGrid &grid) {
+  return LayeredStates(NUM_DIRECTIONS, grid.size());
+}
 
-HeadingPosition find_start_position(const Grid &grid) {
-  for (Coordinate row{}; row < grid.size(); ++row) {
-    for (Coordinate col{}; col < grid[row].size(); ++col) {
-      if (grid[row][col] == START) {
-        return std::make_tuple(EAST, row, col);
-      }
-    }
+StateId find_start_state(const FlatGrid &grid, const LayeredStates &states) {
+  return states.encode(EAST, grid.find(START));
+}
+
+// Turning either way on the spot, and stepping along the heading, forward
+// (step of +1) or backward (step of -1) through the maze
+void for_each_move(const FlatGrid &grid, const LayeredStates &states,
+                   const FlatOffset step, const StateId state,
+                   const auto &visit) {
+  const auto heading = states.layer(state);
+  const auto index = states.index(state);
+  const FlatIndex new_index = index + step * grid.neighbour_offsets()[heading];
+  if (grid[new_index] != WALL) {
+    visit(states.encode(heading, new_index), STEP_SCORE);
   }
-  throw std::runtime_error("Expected to find start position!");
+  visit(states.encode((heading + 1) % NUM_DIRECTIONS, index), TURN_SCORE);
+  visit(states.encode((NUM_DIRECTIONS + heading - 1) % NUM_DIRECTIONS, index),
+        TURN_SCORE);
 }
 
-std::pair<Score, Score> find_shortest_path(const Grid &grid) {
-  const auto starting_position = find_start_position(grid);
-
-  // At any time, we want to know where we just came from
-  using IntermediateResult =
-      std::tuple<Score, HeadingPosition, HeadingPosition>;
-
-  std::deque<IntermediateResult> attempts;
-  Score lowest_score = std::numeric_limits<Score>::max();
-  std::vector<std::vector<std::vector<Score>>> position_to_score(
-      NUM_DIRECTIONS,
-      std::vector<std::vector<Score>>(
-          grid.size(), std::vector<Score>(grid.back().size(), Score())));
-  std::vector<std::vector<std::vector<std::set<HeadingPosition>>>>
-      position_to_last_position(
-          NUM_DIRECTIONS,
-          std::vector<std::vector<std::set<HeadingPosition>>>(
-              grid.size(),
-              std::vector<std::set<HeadingPosition>>(
-                  grid.back().size(), std::set<HeadingPosition>{})));
-  std::set<HeadingPosition> end_positions;
-
-  attempts.emplace_back(0, starting_position, starting_position);
-  while (!attempts.empty()) {
-    const auto &attempt = attempts.front();
-    const auto [score_so_far, position, last_position] = attempt;
-    attempts.pop_front();
-    const auto [heading, row, col] = position;
-    if (grid[row][col] == END) {
-      // Found the end
-      if (score_so_far < lowest_score) {
-        lowest_score = score_so_far;
-        end_positions = std::set<HeadingPosition>{position};
-        position_to_last_position[std::get<0>(position)][std::get<1>(position)]
-                                 [std::get<2>(position)] =
-                                     std::set<HeadingPosition>{last_position};
-      } else if (score_so_far == lowest_score) {
-        end_positions.insert(position);
-        position_to_last_position[std::get<0>(position)][std::get<1>(position)]
-                                 [std::get<2>(position)]
-                                     .insert(last_position);
-      }
+Score find_lowest_score(const FlatGrid &grid) {
+  AOC_SCOPE("maze search");
+  const auto states = make_states(grid);
+  SearchState<Score> search(states.size());
+  const StateId end = dijkstra_search(
+      search, std::array{find_start_state(grid, states)},
+      [&](const StateId state, const auto &visit) {
+        AOC_COUNT("attempts", 1);
+        for_each_move(grid, states, 1, state, visit);
+      },
+      [&](const StateId state) { return grid[states.index(state)] == END; });
+  if (end == NO_STATE) {
+    throw std::runtime_error("Should have found the end!");
+  }
+  return search.distance(end);
+}
+
+size_t count_best_seats(const FlatGrid &grid) {
+  const auto states = make_states(grid);
+
+  AOC_SCOPE("maze search");
+  SearchState<Score> from_start(states.size());
+  dijkstra_search(from_start, std::array{find_start_state(grid, states)},
+                  [&](const StateId state, const auto &visit) {
+                    AOC_COUNT("attempts", 1);
+                    for_each_move(grid, states, 1, state, visit);
+                  });
+
+  // Backwards from the end, facing any way
+  const FlatIndex end_index = grid.find(END);
+  std::vector<StateId> end_states;
+  Score lowest_score = SearchState<Score>::UNREACHED;
+  for (Heading heading = 0; heading < NUM_DIRECTIONS; ++heading) {
+    end_states.push_back(states.encode(heading, end_index));
+    lowest_score =
+        std::min(lowest_score, from_start.distance(end_states.back()));
+  }
+  SearchState<Score> to_end(states.size());
+  dijkstra_search(to_end, end_states,
+                  [&](const StateId state, const auto &visit) {
+                    AOC_COUNT("attempts", 1);
+                    for_each_move(grid, states, -1, state, visit);
+                  });
+
+  // Nested under the search, which is still open
+  AOC_SCOPE("best seats walk");
+  // A seat is on a best path if it can be got to from the start and on to the
+  // end for the lowest score, facing some way
+  BitGrid best_seats(1, grid.size());
+  for (const StateId state : from_start.reached()) {
+    if (!to_end.is_reached(state)) {
       continue;
     }
-    const auto last_score =
-        position_to_score[std::get<0>(position)][std::get<1>(position)]
-                         [std::get<2>(position)];
-    if ((last_score != Score() && last_score < score_so_far) ||
-        score_so_far >= lowest_score) {
-      // visited and we've seen this score or better
-      // Or we've already gone past the best so far
-      continue;
+    if (from_start.distance(state) + to_end.distance(state) == lowest_score) {
+      best_seats.set(0, states.index(state));
     }
+  }
 
-    const auto [row_incr, col_incr] = HEADING_TO_MOVEMENT[heading];
-    const auto new_row = row + row_incr;
-    const auto new_col = col + col_incr;
+  return best_seats.count();
+}
 
-    // Can either take a step forward for cost of 1
-    if (grid[new_row][new_col] != WALL) {
-      attempts.emplace_back(score_so_far + 1,
-                            std::make_tuple(heading, new_row, new_col),
-                            position);
-    }
+FlatGrid Solution::parse(const InputView &input) {
+  return FlatGrid(input.lines(), WALL);
+}
 
-    // Or rotate for a cost of 1000
-    {
-      const auto new_heading = (heading + 1) % NUM_DIRECTIONS;
-      attempts.emplace_back(score_so_far + 1000,
-                            std::make_tuple(new_heading, row, col), position);
-    }
-    {
-      const auto new_heading = (NUM_DIRECTIONS + heading - 1) % NUM_DIRECTIONS;
-      attempts.emplace_back(score_so_far + 1000,
-                            std::make_tuple(new_heading, row, col), position);
-    }
+std::string Solution::solve_part_1(const FlatGrid &grid) {
+  const Score lowest_score = find_lowest_score(grid);
 
-    if (last_score == Score() || score_so_far < last_score) {
-      position_to_score[std::get<0>(position)][std::get<1>(position)]
-                       [std::get<2>(position)] = score_so_far;
-      position_to_last_position[std::get<0>(position)][std::get<1>(position)]
-                               [std::get<2>(position)] =
-                                   std::set<HeadingPosition>{last_position};
-    } else if (score_so_far == last_score) {
-      position_to_last_position[std::get<0>(position)][std::get<1>(position)]
-                               [std::get<2>(position)]
-                                   .insert(last_position);
-    }
-  }
+  return std::to_string(lowest_score);
+}
 
-  std::set<Position> best_seats;
-  std::deque<HeadingPosition> seats;
-  seats.insert(seats.end(), end_positions.begin(), end_positions.end());
-  while (!seats.empty()) {
-    const auto &seat = seats.front();
-    best_seats.insert(std::make_pair(std::get<1>(seat), std::get<2>(seat)));
-    for (const auto &last_seat : position_to_last_position[std::get<0>(
-             seat)][std::get<1>(seat)][std::get<2>(seat)]) {
-      if (last_seat != starting_position) {
-        seats.push_back(last_seat);
-      }
-    }
-    seats.pop_front();
-  }
-  best_seats.insert(std::make_pair(std::get<1>(starting_position),
-                                   std::get<2>(starting_position)));
+std::string Solution::solve_part_2(const FlatGrid &grid) {
+  const size_t num_best_seats = count_best_seats(grid);
 
-  return std::make_pair(lowest_score, best_seats.size());
+  return std::to_string(num_best_seats);
 }
 
 std::string part_1(const std::string &filepath) {
-
-  const auto grid = get_lines_from_file(filepath);
-
-  const auto [part_1, _] = find_shortest_path(grid);
-
-  return std::to_string(part_1);
+  return solve_part_1_from_file<Solution>(filepath);
 }
 
 std::string part_2(const std::string &filepath) {
-  const auto grid = get_lines_from_file(filepath);
-
-  const auto [_, part_2] = find_shortest_path(grid);
-
-  return std::to_string(part_2);
+  return solve_part_2_from_file<Solution>(filepath);
 }
 
 } // namespace d16
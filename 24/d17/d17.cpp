@@ -2,28 +2,21 @@
 #include <array>        // for array
 #include <core_lib.hpp> // for do_assert
 #include <d17.hpp>
-#include <deque>     // for deque
-#include <fstream>   // for basic_ostream, operator<<, endl, basic_istream
-#include <iostream>  // for cout
-#include <sstream>   // for basic_stringstream, stringstream
-#include <stddef.h>  // for size_t
-#include <stdexcept> // for runtime_error
-#include <stdint.h>  // for int64_t
-#include <string>    // for char_traits, string, allocator, to_string
-#include <vector>    // for vector
+#include <deque>          // for deque
+#include <input_view.hpp> // for InputView
+#include <iostream>       // for basic_ostream, operator<<, endl, cout
+#include <scanner.hpp>    // for Scanner
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <sstream>        // for basic_stringstream, stringstream
+#include <stddef.h>       // for size_t
+#include <stdexcept>      // for runtime_error
+#include <stdint.h>       // for int64_t
+#include <string>         // for char_traits, string, allocator, to_string
+#include <string_view>    // for string_view
+#include <vector>         // for vector
 
 namespace d17 {
 
-using Value = int64_t;
-
-using Register = Value;
-
-using Instruction = Value;
-
-using Instructions = std::vector<Instruction>;
-
-using Values = std::vector<Value>;
-
 constexpr Instruction ADV = 0;
 constexpr Instruction BXL = 1;
 constexpr Instruction BST = 2;
@@ -38,32 +31,6 @@ constexpr size_t NUM_INSTRUCTIONS = 8;
 constexpr std::array<const char *, NUM_INSTRUCTIONS> INSTRUCTION_NAMES = {
     "ADV", "BXL", "BST", "JNZ", "BXC", "OUT", "BDV", "CDV"};
 
-struct c_ProgramState {
-  Register m_A;
-  Register m_B;
-  Register m_C;
-
-  size_t m_ProgramCounter;
-
-  Instructions m_Instructions;
-
-  Values m_Output;
-
-  c_ProgramState()
-      : m_A{}
-      , m_B{}
-      , m_C{}
-      , m_ProgramCounter{}
-      , m_Instructions{}
-      , m_Output{} {}
-
-  Value combo_operand(const Value operand) const;
-
-  size_t simulate_instruction(const Instruction instruction,
-                              const Value operand);
-
-  void simulate();
-};
 
 void print_instructions(const Instructions &instructions) {
   for (size_t index{}; index < instructions.size() - 1; index += 2) {
@@ -183,66 +150,50 @@ void print_program_state(const c_ProgramState &program_state) {
   std::cout << std::endl;
 }
 
-Register parse_register(const std::string &line) {
-  size_t pos = line.find(":");
-  // skip over colon and space
-  pos += 2;
-
-  return std::stoll(line.substr(pos, line.size() - pos));
+// Register A: 729
+Register parse_register(const std::string_view line) {
+  Scanner scanner(line);
+  scanner.expect("Register ");
+  if (!scanner.skip_to_int()) {
+    throw std::runtime_error("Expected a register value!");
+  }
+  return scanner.next_int();
 }
 
-Instructions parse_instructions(const std::string &line) {
-  size_t pos = line.find(":");
-  // skip over colon and space
-  pos += 2;
+// Program: 0,1,5,4,3,0
+Instructions parse_instructions(const std::string_view line) {
+  Scanner scanner(line);
+  scanner.expect("Program: ");
 
   Instructions instructions;
-  while (pos < line.size()) {
-    size_t comma = line.find(",", pos);
-    if (comma == std::string::npos) {
-      comma = line.size();
+  while (!scanner.at_end()) {
+    instructions.push_back(scanner.next_int());
+    if (!scanner.at_end()) {
+      scanner.expect(",");
     }
-    Instruction instruction = std::stoll(line.substr(pos, comma - pos));
-    instructions.push_back(instruction);
-    pos = comma + 1;
   }
   return instructions;
 }
 
-c_ProgramState get_program_state_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+c_ProgramState get_program_state(const InputView &input) {
+  const auto &lines = input.lines();
 
-  c_ProgramState program_state;
-
-  std::string line;
-
-  if (!std::getline(in_stream, line)) {
+  // Three registers, a blank line and the instructions
+  if (lines.size() < 5) {
     throw std::runtime_error("Unexpected EOF!");
   }
-  program_state.m_A = parse_register(line);
 
-  if (!std::getline(in_stream, line)) {
-    throw std::runtime_error("Unexpected EOF!");
-  }
-  program_state.m_B = parse_register(line);
+  c_ProgramState program_state;
 
-  if (!std::getline(in_stream, line)) {
-    throw std::runtime_error("Unexpected EOF!");
-  }
-  program_state.m_C = parse_register(line);
+  program_state.m_A = parse_register(lines[0]);
+  program_state.m_B = parse_register(lines[1]);
+  program_state.m_C = parse_register(lines[2]);
 
-  // get blank line
-  if (!std::getline(in_stream, line)) {
-    throw std::runtime_error("Unexpected EOF!");
-  } else if (!line.empty()) {
+  if (!lines[3].empty()) {
     throw std::runtime_error("Expected blank line!!");
   }
 
-  // get instructions
-  if (!std::getline(in_stream, line)) {
-    throw std::runtime_error("Unexpected EOF!");
-  }
-  program_state.m_Instructions = parse_instructions(line);
+  program_state.m_Instructions = parse_instructions(lines[4]);
 
   return program_state;
 }
@@ -319,20 +270,28 @@ Value find_lowest_value_for_quine(const c_ProgramState &input_program_state) {
   return *std::min_element(output.begin(), output.end());
 }
 
-std::string part_1(const std::string &filepath) {
-  const auto program_state = get_program_state_from_file(filepath);
+c_ProgramState Solution::parse(const InputView &input) {
+  return get_program_state(input);
+}
 
+std::string Solution::solve_part_1(const c_ProgramState &program_state) {
   const auto output_program_state = simulate_program(program_state);
 
   return sequence_to_string(output_program_state.m_Output);
 }
 
-std::string part_2(const std::string &filepath) {
-  const auto program_state = get_program_state_from_file(filepath);
-
+std::string Solution::solve_part_2(const c_ProgramState &program_state) {
   Value accumulator = find_lowest_value_for_quine(program_state);
 
   return std::to_string(accumulator);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d17
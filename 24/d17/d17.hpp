@@ -1,9 +1,60 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <stddef.h>       // for size_t
+#include <stdint.h>       // for int64_t
+#include <string>         // for string
+#include <vector>         // for vector
 
 namespace d17 {
 
+using Value = int64_t;
+
+using Register = Value;
+
+using Instruction = Value;
+
+using Instructions = std::vector<Instruction>;
+
+using Values = std::vector<Value>;
+
+struct c_ProgramState {
+  Register m_A;
+  Register m_B;
+  Register m_C;
+
+  size_t m_ProgramCounter;
+
+  Instructions m_Instructions;
+
+  Values m_Output;
+
+  c_ProgramState()
+      : m_A{}
+      , m_B{}
+      , m_C{}
+      , m_ProgramCounter{}
+      , m_Instructions{}
+      , m_Output{} {}
+
+  Value combo_operand(const Value operand) const;
+
+  size_t simulate_instruction(const Instruction instruction,
+                              const Value operand);
+
+  void simulate();
+};
+
+struct Solution {
+  using Input = c_ProgramState;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &program_state);
+
+  static std::string solve_part_2(const Input &program_state);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
@@ -1,51 +1,43 @@
 #include <array>        // for array
-#include <core_lib.hpp> // for Position, Coordinate, Grid, Matrix2D, greet_day
+#include <bit_grid.hpp> // for BitGrid
+#include <core_lib.hpp> // for FlatGrid, FlatIndex, Position, Coordinate
+#include <cstdint>      // for uint64_t
 #include <d18.hpp>
-#include <deque>    // for deque
-#include <fstream>  // for basic_ostream, endl, operator<<, basic_istream
-#include <iostream> // for cout, cerr
-#include <limits>   // for numeric_limits
-#include <set>      // for set
-#include <stddef.h> // for size_t
-#include <string>   // for char_traits, basic_string, string
-#include <tuple>    // for tuple
-#include <utility>  // for pair, make_pair, operator==
-#include <vector>   // for vector
+#include <input_view.hpp> // for InputView
+#include <instrument.hpp> // for AOC_SCOPE, AOC_COUNT
+#include <iostream>       // for basic_ostream, endl, operator<<, cout, cerr
+#include <limits>         // for numeric_limits
+#include <scanner.hpp>    // for Scanner
+#include <search.hpp>     // for SearchState, StateId, a_star_search, NO_S...
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <string>         // for char_traits, basic_string, string
+#include <vector>         // for vector
 
 namespace d18 {
 
-using Positions = std::vector<Position>;
-
 constexpr Coordinate GRID_HEIGHT = 71;
 constexpr Coordinate GRID_WIDTH = 71;
 
 constexpr Tile OBSTACLE = '#';
+constexpr Tile EMPTY = '.';
 
 constexpr Position START = {0, 0};
 constexpr Position END = {GRID_HEIGHT - 1, GRID_WIDTH - 1};
 
-using Movement = Position;
-
-constexpr Coordinate NUM_DIRECTIONS = 4;
-
-constexpr std::array<Movement, NUM_DIRECTIONS> MOVEMENTS = {
-    {{-1, 0}, {0, 1}, {1, 0}, {0, -1}}};
-
 constexpr size_t ONE_KILOBYTE = 1024;
 
-using PathLocations = Matrix2D<Position>;
-using PathLengths = Matrix2D<size_t>;
+constexpr size_t NO_PATH = std::numeric_limits<size_t>::max();
 
-Positions get_positions_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+Positions get_positions(const InputView &input) {
+  Scanner scanner(input.data());
 
   Positions positions;
 
-  Coordinate row = 0;
-  Coordinate col = 0;
-  char comma;
-
-  while (in_stream >> row >> comma >> col) {
+  while (scanner.skip_to_int()) {
+    const Coordinate row = scanner.next_int();
+    scanner.expect(",");
+    const Coordinate col = scanner.next_int();
     positions.emplace_back(row, col);
   }
   return positions;
@@ -58,93 +50,63 @@ void print_positions(const Positions &positions) {
   std::cout << std::endl;
 }
 
-void simulate_n_more_bytes_falling(Grid &grid, const Positions &positions,
+void simulate_n_more_bytes_falling(FlatGrid &grid, const Positions &positions,
                                    const size_t bytes_so_far,
                                    const size_t n_bytes_more) {
   for (size_t byte_index = bytes_so_far;
        byte_index < bytes_so_far + n_bytes_more; ++byte_index) {
-    const auto &[row, col] = positions[byte_index];
-    grid[row][col] = OBSTACLE;
+    grid[grid.to_index(positions[byte_index])] = OBSTACLE;
   }
 }
 
-Grid simulate_n_bytes_falling(const Positions &positions,
-                              const size_t n_bytes) {
-  Grid grid(GRID_HEIGHT, std::string(GRID_WIDTH, '.'));
+FlatGrid simulate_n_bytes_falling(const Positions &positions,
+                                  const size_t n_bytes) {
+  // Walls all the way round, so we never have to check bounds
+  FlatGrid grid(GRID_HEIGHT, GRID_WIDTH, EMPTY, OBSTACLE);
 
   simulate_n_more_bytes_falling(grid, positions, 0, n_bytes);
 
   return grid;
 }
 
-std::pair<PathLocations, PathLengths> find_shortest_paths(const Grid &grid) {
-  using IntermediateResult = std::tuple<size_t, Position>;
-
-  std::deque<IntermediateResult> attempts;
-  attempts.emplace_back(0, START);
-
-  PathLengths shortest_so_far(
-      GRID_HEIGHT,
-      std::vector<size_t>(GRID_WIDTH, std::numeric_limits<size_t>::max()));
-
-  PathLocations last_position(
-      GRID_HEIGHT, std::vector<Position>(GRID_WIDTH, std::make_pair(-1, -1)));
-
-  while (!attempts.empty()) {
-    const auto [path_length, position] = attempts.front();
-    attempts.pop_front();
-    if (position == END) {
-      continue;
-    }
-    if (path_length > shortest_so_far[END.first][END.second]) {
-      continue;
-    }
-    const auto [row, col] = position;
-    for (const auto &[row_incr, col_incr] : MOVEMENTS) {
-      const auto new_row = row + row_incr;
-      const auto new_col = col + col_incr;
-      if (!is_in_bounds(grid, new_row, new_col)) {
-        continue;
-      }
-      if (grid[new_row][new_col] == OBSTACLE) {
-        continue;
-      }
-      if (path_length + 1 >= shortest_so_far[new_row][new_col]) {
-        continue;
-      }
-      shortest_so_far[new_row][new_col] = path_length + 1;
-      last_position[new_row][new_col] = position;
-      attempts.emplace_back(path_length + 1, std::make_pair(new_row, new_col));
-    }
-  }
-
-  return std::make_pair(last_position, shortest_so_far);
-}
-
-size_t find_length_shortest_path(const Grid &grid) {
-  const auto [_, shortest_paths] = find_shortest_paths(grid);
-  return shortest_paths[END.first][END.second];
-}
-
-size_t find_length_shortest_path(const PathLengths &shortest_paths) {
-  return shortest_paths[END.first][END.second];
+// Leaves the shortest path from START to END in search, returning its length
+// or NO_PATH
+size_t find_shortest_path(const FlatGrid &grid, SearchState<> &search) {
+  const FlatIndex end = grid.to_index(END);
+
+  AOC_SCOPE("shortest path search");
+  const StateId found = a_star_search(
+      search, std::array{StateId(grid.to_index(START))},
+      [&grid](const StateId position, const auto &visit) {
+        AOC_COUNT("attempts", 1);
+        for (const auto movement : grid.neighbour_offsets()) {
+          const FlatIndex new_position = position + movement;
+          if (grid[new_position] != OBSTACLE) {
+            visit(StateId(new_position), 1u);
+          }
+        }
+      },
+      // No path can be shorter than the Manhattan distance left
+      [&grid](const StateId position) {
+        const auto [row, col] = grid.to_position(position);
+        return uint64_t((END.first - row) + (END.second - col));
+      },
+      [end](const StateId position) { return position == end; });
+
+  return found == NO_STATE ? NO_PATH : search.distance(found);
 }
 
 size_t simulate_and_solve(const Positions &positions) {
   const auto grid = simulate_n_bytes_falling(positions, ONE_KILOBYTE);
-  return find_length_shortest_path(grid);
+  SearchState<> search(grid.size());
+  return find_shortest_path(grid, search);
 }
 
-std::set<Position> find_shortest_path(const PathLocations &last_position) {
-  std::set<Position> shortest_path;
-  shortest_path.insert(END);
-  shortest_path.insert(START);
-  auto position = END;
-  while (position != START) {
-    const auto [row, col] = position;
-    const auto next_position = last_position[row][col];
-    shortest_path.insert(position);
-    position = next_position;
+// A bit per tile of the grid
+BitGrid to_bit_grid(const FlatGrid &grid, const std::vector<StateId> &path) {
+  BitGrid shortest_path(1, grid.size());
+  for (const auto position : path) {
+    shortest_path.set(0, position);
   }
   return shortest_path;
 }
@@ -152,23 +114,21 @@ std::set<Position> find_shortest_path(const PathLocations &last_position) {
 size_t simulate_to_failure(const Positions &positions) {
   size_t bytes_so_far = ONE_KILOBYTE + 1;
   auto grid = simulate_n_bytes_falling(positions, bytes_so_far);
-  auto [last_position, shortest_paths] = find_shortest_paths(grid);
-  size_t shortest_path_length = find_length_shortest_path(shortest_paths);
+  // Shared by every search, and only cleared where the last one reached
+  SearchState<> search(grid.size());
+  size_t shortest_path_length = find_shortest_path(grid, search);
 
-  std::set<Position> shortest_path = find_shortest_path(last_position);
+  const StateId end = StateId(grid.to_index(END));
+  BitGrid shortest_path = to_bit_grid(grid, search.path_to(end));
 
-  while (bytes_so_far < positions.size() &&
-         shortest_path_length != std::numeric_limits<size_t>::max()) {
+  while (bytes_so_far < positions.size() && shortest_path_length != NO_PATH) {
     simulate_n_more_bytes_falling(grid, positions, bytes_so_far, 1);
     // Only do a new search when we have positions that fall on our current
     // shortest path
-    if (shortest_path.count(positions[bytes_so_far]) > 0) {
-      auto path_pair = find_shortest_paths(grid);
-      last_position = path_pair.first;
-      shortest_paths = path_pair.second;
-      shortest_path_length = find_length_shortest_path(shortest_paths);
-      if (shortest_path_length != std::numeric_limits<size_t>::max()) {
-        shortest_path = find_shortest_path(last_position);
+    if (shortest_path.test(0, grid.to_index(positions[bytes_so_far]))) {
+      shortest_path_length = find_shortest_path(grid, search);
+      if (shortest_path_length != NO_PATH) {
+        shortest_path = to_bit_grid(grid, search.path_to(end));
       }
     }
     ++bytes_so_far;
@@ -177,19 +137,17 @@ size_t simulate_to_failure(const Positions &positions) {
   return bytes_so_far;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const auto positions = get_positions_from_file(filepath);
+Positions Solution::parse(const InputView &input) {
+  return get_positions(input);
+}
 
+std::string Solution::solve_part_1(const Positions &positions) {
   size_t shortest_path = simulate_and_solve(positions);
 
   return std::to_string(shortest_path);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const auto positions = get_positions_from_file(filepath);
-
+std::string Solution::solve_part_2(const Positions &positions) {
   size_t number_to_fall = simulate_to_failure(positions);
 
   const auto &[row, col] = positions[number_to_fall - 1];
@@ -197,4 +155,12 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(row) + "," + std::to_string(col);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d18
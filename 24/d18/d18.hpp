@@ -1,9 +1,24 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for Position
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 namespace d18 {
 
+using Positions = std::vector<Position>;
+
+struct Solution {
+  using Input = Positions;
+
+  static Input parse(const InputView &input);
+
+  static std::string solve_part_1(const Input &positions);
+
+  static std::string solve_part_2(const Input &positions);
+};
+
 std::string part_1(const std::string &filepath);
 
 std::string part_2(const std::string &filepath);
@@ -1,22 +1,20 @@
 #include <algorithm> // for max_element
 #include <d19.hpp>
-#include <fstream>   // for basic_istream, getline, basic_ifstream, basic_ios
-#include <iostream>  // for cout
-#include <set>       // for set, operator!=, __tree_const_iterator
-#include <stddef.h>  // for size_t
-#include <stdexcept> // for runtime_error
-#include <string>    // for char_traits, string, to_string, basic_string
-#include <utility>   // for make_pair, pair
-#include <vector>    // for vector
+#include <functional>        // for less
+#include <input_view.hpp>    // for InputView
+#include <iostream>          // for cout
+#include <ranges>            // for subrange
+#include <record_stream.hpp> // for stream_record_text
+#include <set>               // for set, operator!=, __tree_const_iterator
+#include <solver.hpp>        // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>          // for size_t
+#include <stdexcept>         // for runtime_error
+#include <string>            // for char_traits, string, to_string, basic_string
+#include <string_view>       // for string_view
+#include <vector>            // for vector
 
 namespace d19 {
 
-using Towel = std::string;
-using TowelPattern = std::string;
-
-using Towels = std::vector<Towel>;
-using TowelPatterns = std::vector<TowelPattern>;
-
 TowelPatterns parse_towel_patterns(const std::string &line) {
   TowelPatterns towel_patterns;
   size_t pos{};
@@ -34,30 +32,22 @@ TowelPatterns parse_towel_patterns(const std::string &line) {
   return towel_patterns;
 }
 
-std::pair<TowelPatterns, Towels>
-get_towel_patterns_and_towels_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+TowelPatternsAndTowels get_towel_patterns_and_towels(const InputView &input) {
+  const auto &lines = input.lines();
 
-  std::string first_line;
-  if (!std::getline(in_stream, first_line)) {
+  // Patterns, then a blank line
+  if (lines.size() < 2) {
     throw std::runtime_error("Unexpected EOF!");
   }
-  const auto towel_patterns = parse_towel_patterns(first_line);
+  const auto towel_patterns = parse_towel_patterns(std::string(lines[0]));
 
-  // get blank line
-  std::string line;
-  if (!std::getline(in_stream, line)) {
-    throw std::runtime_error("Unexpected EOF!");
-  } else if (!line.empty()) {
+  if (!lines[1].empty()) {
     throw std::runtime_error("Expected blank line!!");
   }
 
-  Towels towels;
-  while (std::getline(in_stream, line)) {
-    towels.push_back(line);
-  }
+  Towels towels(lines.begin() + 2, lines.end());
 
-  return std::make_pair(towel_patterns, towels);
+  return {towel_patterns, towels};
 }
 
 template <typename Element> void print_vector(const std::vector<Element> &vec) {
@@ -67,9 +57,13 @@ template <typename Element> void print_vector(const std::vector<Element> &vec) {
   std::cout << std::endl;
 }
 
-size_t num_designs_possible(const std::set<TowelPattern> &unique_patterns,
+// Compares against string_views too, so that no substring has to be copied to
+// be looked up
+using UniquePatterns = std::set<TowelPattern, std::less<>>;
+
+size_t num_designs_possible(const UniquePatterns &unique_patterns,
                             const size_t max_length_pattern,
-                            const Towel &towel) {
+                            const std::string_view towel) {
   std::vector<size_t> counts(towel.size() + 1, 0);
   counts[0] = 1;
 
@@ -88,12 +82,13 @@ size_t num_designs_possible(const std::set<TowelPattern> &unique_patterns,
   return counts.back();
 }
 
+template <typename TowelRange>
 size_t get_number_possible_designs(const TowelPatterns &towel_patterns,
-                                   const Towels &towels) {
+                                   TowelRange &&towels) {
   size_t number_possible{};
 
-  const std::set<TowelPattern> unique_patterns(towel_patterns.begin(),
-                                               towel_patterns.end());
+  const UniquePatterns unique_patterns(towel_patterns.begin(),
+                                       towel_patterns.end());
   std::set<size_t> pattern_lengths;
   for (const auto &pattern : towel_patterns) {
     pattern_lengths.insert(pattern.size());
@@ -110,12 +105,13 @@ size_t get_number_possible_designs(const TowelPatterns &towel_patterns,
   return number_possible;
 }
 
+template <typename TowelRange>
 size_t get_total_number_possible_designs(const TowelPatterns &towel_patterns,
-                                         const Towels &towels) {
+                                         TowelRange &&towels) {
   size_t number_possible{};
 
-  const std::set<TowelPattern> unique_patterns(towel_patterns.begin(),
-                                               towel_patterns.end());
+  const UniquePatterns unique_patterns(towel_patterns.begin(),
+                                       towel_patterns.end());
   std::set<size_t> pattern_lengths;
   for (const auto &pattern : towel_patterns) {
     pattern_lengths.insert(pattern.size());
@@ -131,20 +127,22 @@ size_t get_total_number_possible_designs(const TowelPatterns &towel_patterns,
   return number_possible;
 }
 
-std::string part_1(const std::string &filepath) {
+TowelPatternsAndTowels Solution::parse(const InputView &input) {
+  return get_towel_patterns_and_towels(input);
+}
 
-  const auto [towel_patterns, towels] =
-      get_towel_patterns_and_towels_from_file(filepath);
+std::string
+Solution::solve_part_1(const TowelPatternsAndTowels &patterns_and_towels) {
+  const auto &[towel_patterns, towels] = patterns_and_towels;
 
   const auto num_possible = get_number_possible_designs(towel_patterns, towels);
 
   return std::to_string(num_possible);
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const auto [towel_patterns, towels] =
-      get_towel_patterns_and_towels_from_file(filepath);
+std::string
+Solution::solve_part_2(const TowelPatternsAndTowels &patterns_and_towels) {
+  const auto &[towel_patterns, towels] = patterns_and_towels;
 
   const auto num_possible =
       get_total_number_possible_designs(towel_patterns, towels);
@@ -152,4 +150,57 @@ std::string part_2(const std::string &filepath) {
   return std::to_string(num_possible);
 }
 
+// Reads the same layout as get_towel_patterns_and_towels, but hands the towels
+// to count_designs as a stream instead of parsing them all
+template <typename CountDesigns>
+size_t stream_towels(const std::string &filepath,
+                     const CountDesigns count_designs) {
+  auto lines = stream_record_text(filepath);
+  auto line = lines.begin();
+
+  // Patterns, then a blank line
+  if (line == lines.end()) {
+    throw std::runtime_error("Unexpected EOF!");
+  }
+  const auto towel_patterns = parse_towel_patterns(std::string(*line));
+
+  ++line;
+  if (line == lines.end()) {
+    throw std::runtime_error("Unexpected EOF!");
+  }
+  if (!line->empty()) {
+    throw std::runtime_error("Expected blank line!!");
+  }
+
+  ++line;
+  return count_designs(towel_patterns,
+                       std::ranges::subrange(line, lines.end()));
+}
+
+std::string Solution::stream_part_1(const std::string &filepath) {
+  const auto num_possible = stream_towels(
+      filepath, [](const TowelPatterns &towel_patterns, auto &&towels) {
+        return get_number_possible_designs(towel_patterns, towels);
+      });
+
+  return std::to_string(num_possible);
+}
+
+std::string Solution::stream_part_2(const std::string &filepath) {
+  const auto num_possible = stream_towels(
+      filepath, [](const TowelPatterns &towel_patterns, auto &&towels) {
+        return get_total_number_possible_designs(towel_patterns, towels);
+      });
+
+  return std::to_string(num_possible);
+}
+
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 } // namespace d19
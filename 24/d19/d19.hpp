@@ -1,10 +1,38 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 // clang-format off
 namespace d19 {
 
+  using Towel = std::string;
+  using TowelPattern = std::string;
+
+  using Towels = std::vector<Towel>;
+  using TowelPatterns = std::vector<TowelPattern>;
+
+  struct TowelPatternsAndTowels {
+    TowelPatterns m_towel_patterns;
+    Towels m_towels;
+  };
+
+  struct Solution {
+    using Input = TowelPatternsAndTowels;
+
+    static Input parse(const InputView &input);
+
+    static std::string solve_part_1(const Input &patterns_and_towels);
+
+    static std::string solve_part_2(const Input &patterns_and_towels);
+
+    // Solved a towel at a time off the file, in constant memory
+    static std::string stream_part_1(const std::string &filepath);
+
+    static std::string stream_part_2(const std::string &filepath);
+  };
+
   std::string part_1(const std::string &filepath);
 
   std::string part_2(const std::string &filepath);
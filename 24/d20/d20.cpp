@@ -1,18 +1,21 @@
-#include <algorithm>    // for reverse
+#include <arena.hpp>    // for Arena
 #include <array>        // for array
 #include <cmath>        // for abs
-#include <core_lib.hpp> // for Position, Coordinate, Grid, Matrix2D, Tile
+#include <core_lib.hpp> // for FlatGrid, FlatIndex, Position, Coordinate
 #include <d20.hpp>
-#include <deque>     // for deque
-#include <limits>    // for numeric_limits
-#include <map>       // for map, __map_iterator
-#include <stddef.h>  // for size_t
-#include <stdexcept> // for runtime_error
-#include <stdlib.h>  // for abs
-#include <string>    // for string, basic_string, to_string, operator+
-#include <tuple>     // for tuple
-#include <utility>   // for pair, make_pair, operator==
-#include <vector>    // for vector
+#include <input_view.hpp>  // for InputView
+#include <instrument.hpp>  // for AOC_SCOPE, AOC_COUNT
+#include <map>             // for map, __map_iterator
+#include <memory_resource> // for memory_resource
+#include <search.hpp>      // for SearchState, StateId, breadth_first_search
+#include <solver.hpp>      // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>        // for size_t
+#include <stdexcept>       // for runtime_error
+#include <stdlib.h>        // for abs
+#include <string>          // for string, basic_string, to_string, operator+
+#include <tuple>           // for tuple
+#include <utility>         // for make_pair, move
+#include <vector>          // for vector
 
 // clang-format off
 namespace d20 {
@@ -22,123 +25,58 @@ constexpr Tile START = 'S';
 constexpr Tile END = 'E';
 constexpr Tile WALL = '#';
 
-using Positions = std::vector<Position>;
-
-using Movement = Position;
-
-constexpr Coordinate NUM_DIRECTIONS = 4;
-
-constexpr std::array<Movement, NUM_DIRECTIONS> MOVEMENTS = {
-    {{-1, 0}, {0, 1}, {1, 0}, {0, -1}}};
-
-using PathLocations = Matrix2D<Position>;
-using PathLengths = Matrix2D<size_t>;
-
 // Where did the cheat begin, where did it end, how much savings?
-using Cheat = std::tuple<Position, Position, size_t>;
-
-Position find_tile(const Grid &grid, const Tile tile) {
-  // return first position where we find this tile
-  for (Coordinate row{}; row < grid.size(); ++row) {
-    for (Coordinate col{}; col < grid[row].size(); ++col) {
-      if (grid[row][col] == tile) {
-        return std::make_pair(row, col);
-      }
-    }
-  }
-  throw std::runtime_error(std::string("Expected to find tile: ") +
-                           std::to_string(tile));
-}
-
-std::pair<PathLocations, PathLengths> find_shortest_paths(const Grid &grid) {
-  using IntermediateResult = std::tuple<size_t, Position>;
-
-  const auto start = find_tile(grid, START);
-  const auto end = find_tile(grid, END);
-
-  std::deque<IntermediateResult> attempts;
-  attempts.emplace_back(0, start);
-
-  PathLengths shortest_so_far(
-      grid.size(), std::vector<size_t>(grid.back().size(),
-                                       std::numeric_limits<size_t>::max()));
-
-  PathLocations last_position(
-      grid.size(),
-      std::vector<Position>(grid.back().size(), std::make_pair(-1, -1)));
-
-  while (!attempts.empty()) {
-    const auto [path_length, position] = attempts.front();
-    attempts.pop_front();
-    if (position == end) {
-      continue;
-    }
-    if (path_length > shortest_so_far[end.first][end.second]) {
-      continue;
-    }
-    const auto [row, col] = position;
-    for (const auto &[row_incr, col_incr] : MOVEMENTS) {
-      const auto new_row = row + row_incr;
-      const auto new_col = col + col_incr;
-      if (!is_in_bounds(grid, new_row, new_col)) {
-        continue;
-      }
-      if (grid[new_row][new_col] == WALL) {
-        continue;
-      }
-      if (path_length + 1 >= shortest_so_far[new_row][new_col]) {
-        continue;
-      }
-      shortest_so_far[new_row][new_col] = path_length + 1;
-      last_position[new_row][new_col] = position;
-      attempts.emplace_back(path_length + 1, std::make_pair(new_row, new_col));
-    }
-  }
-
-  return std::make_pair(last_position, shortest_so_far);
-}
-
-Positions find_shortest_path(const Grid &grid,
-                             const PathLocations &last_position) {
-  Positions shortest_path;
-
-  const auto start = find_tile(grid, START);
-  const auto end = find_tile(grid, END);
-
-  auto position = end;
-  while (position != start) {
-    const auto [row, col] = position;
-    const auto next_position = last_position[row][col];
-    shortest_path.push_back(position);
-    position = next_position;
+using Cheat = std::tuple<FlatIndex, FlatIndex, size_t>;
+
+// Every tile after the start, up to and including the end
+Positions find_shortest_path(const FlatGrid &grid) {
+  const auto start = grid.find(START);
+  const auto end = grid.find(END);
+
+  SearchState<> search(grid.size());
+  AOC_SCOPE("shortest path search");
+  breadth_first_search(
+      search, std::array{StateId(start)},
+      [&grid](const StateId position, const auto &visit) {
+        AOC_COUNT("attempts", 1);
+        for (const auto movement : grid.neighbour_offsets()) {
+          const FlatIndex new_position = position + movement;
+          if (grid[new_position] != WALL) {
+            visit(StateId(new_position));
+          }
+        }
+      },
+      [end](const StateId position) { return position == end; });
+
+  const auto path = search.path_to(StateId(end));
+  if (path.empty()) {
+    throw std::runtime_error("Should have found the end!");
   }
-
-  std::reverse(shortest_path.begin(), shortest_path.end());
-  return shortest_path;
+  return Positions(path.begin() + 1, path.end());
 }
 
-std::vector<Cheat> find_all_cheats(const Grid &grid,
-                                   const Coordinate total_distance) {
-
-  std::vector<Cheat> cheats{};
+std::pmr::vector<Cheat> find_all_cheats(const RaceTrack &race_track,
+                                        const Coordinate total_distance,
+                                        std::pmr::memory_resource *memory) {
 
-  const auto start = find_tile(grid, START);
-  const auto end = find_tile(grid, END);
+  std::pmr::vector<Cheat> cheats(memory);
 
-  const auto [last_positions, shortest_so_far] = find_shortest_paths(grid);
+  const auto &[grid, shortest_path] = race_track;
 
-  const auto shortest_path = find_shortest_path(grid, last_positions);
+  const auto start = grid.find(START);
+  const auto end = grid.find(END);
 
-  std::map<Position, size_t> distance_so_far;
+  // Anything off the path is left at zero
+  std::pmr::vector<size_t> distance_so_far(grid.size(), 0, memory);
   distance_so_far[start] = 0;
   size_t distance = 1;
-  for (const auto &position : shortest_path) {
+  for (const auto position : shortest_path) {
     distance_so_far[position] = distance;
     ++distance;
   }
 
   // find all possible cheating positions
-  std::map<Position, Coordinate> cheating_increments;
+  std::pmr::map<Position, Coordinate> cheating_increments(memory);
   for (Coordinate row_incr = (-total_distance); row_incr <= total_distance;
        ++row_incr) {
     for (Coordinate col_incr = (-total_distance); col_incr <= total_distance;
@@ -154,19 +92,19 @@ std::vector<Cheat> find_all_cheats(const Grid &grid,
   // At each point on the path, try to cheat, but only if it brings us to a
   // point further away than we are now
   size_t position_index = 0;
-  Position position = start;
+  FlatIndex position = start;
 
   while (position != end) {
-    // Try cheat
-    const auto [row, col] = position;
+    // Try cheat, which can jump well past the one tile border
+    const auto [row, col] = grid.to_position(position);
     for (const auto &[incr, distance] : cheating_increments) {
       const auto [row_incr, col_incr] = incr;
       const auto new_row = row + row_incr;
       const auto new_col = col + col_incr;
-      if (!is_in_bounds(grid, new_row, new_col)) {
+      if (!grid.is_in_bounds(new_row, new_col)) {
         continue;
       }
-      Position cheat_end = std::make_pair(new_row, new_col);
+      const FlatIndex cheat_end = grid.to_index(new_row, new_col);
       if (distance_so_far[cheat_end] > (distance_so_far[position] + distance)) {
         cheats.emplace_back(position, cheat_end,
                             distance_so_far[cheat_end] -
@@ -180,16 +118,14 @@ std::vector<Cheat> find_all_cheats(const Grid &grid,
   return cheats;
 }
 
-size_t number_of_cheats_at_least_100_savings(const Grid &grid,
+size_t number_of_cheats_at_least_100_savings(const RaceTrack &race_track,
                                              const Coordinate total_distance) {
+  Arena arena;
 
-  const auto [last_position, shortest_so_far] = find_shortest_paths(grid);
-
-  const auto shortest_path = find_shortest_path(grid, last_position);
+  const auto cheats =
+      find_all_cheats(race_track, total_distance, arena.resource());
 
-  const auto cheats = find_all_cheats(grid, total_distance);
-
-  std::map<size_t, size_t> savings_counts;
+  std::pmr::map<size_t, size_t> savings_counts(arena.resource());
 
   for (const auto &[cheat_begin, cheat_end, savings] : cheats) {
     ++savings_counts[savings];
@@ -205,22 +141,34 @@ size_t number_of_cheats_at_least_100_savings(const Grid &grid,
   return at_least_100;
 }
 
-std::string part_1(const std::string &filepath) {
+RaceTrack Solution::parse(const InputView &input) {
+  FlatGrid grid(input.lines(), WALL);
+
+  auto shortest_path = find_shortest_path(grid);
 
-  const auto grid = get_lines_from_file(filepath);
+  return {std::move(grid), std::move(shortest_path)};
+}
 
-  const auto at_least_100 = number_of_cheats_at_least_100_savings(grid, 2);
+std::string Solution::solve_part_1(const RaceTrack &race_track) {
+  const auto at_least_100 =
+      number_of_cheats_at_least_100_savings(race_track, 2);
 
   return std::to_string(at_least_100);
 }
 
-std::string part_2(const std::string &filepath) {
+std::string Solution::solve_part_2(const RaceTrack &race_track) {
+  const auto at_least_100 =
+      number_of_cheats_at_least_100_savings(race_track, 20);
 
-  const auto grid = get_lines_from_file(filepath);
+  return std::to_string(at_least_100);
+}
 
-  const auto at_least_100 = number_of_cheats_at_least_100_savings(grid, 20);
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
 
-  return std::to_string(at_least_100);
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
 }
 
 // clang-format off
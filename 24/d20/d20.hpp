@@ -1,10 +1,31 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for FlatGrid, FlatIndex
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 // clang-format off
 namespace d20 {
 
+  using Positions = std::vector<FlatIndex>;
+
+  // The grid, plus the single path through it from start to end, start excluded
+  struct RaceTrack {
+    FlatGrid m_grid;
+    Positions m_path;
+  };
+
+  struct Solution {
+    using Input = RaceTrack;
+
+    static Input parse(const InputView &input);
+
+    static std::string solve_part_1(const Input &race_track);
+
+    static std::string solve_part_2(const Input &race_track);
+  };
+
   std::string part_1(const std::string &filepath);
 
   std::string part_2(const std::string &filepath);
@@ -1,20 +1,20 @@
-#include <core_lib.hpp> // for Position, Tile, get_lines_from_file
+#include <core_lib.hpp> // for Position, Tile, get_lines
 #include <d21.hpp>
-#include <map>      // for map, __map_const_iterator, operator!=
-#include <stddef.h> // for size_t
-#include <string>   // for operator+, basic_string, string, to_string
-#include <utility>  // for pair, make_pair, operator==
-#include <vector>   // for vector
+#include <input_view.hpp> // for InputView
+#include <map>            // for map, __map_const_iterator, operator!=
+#include <solver.hpp>     // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>       // for size_t
+#include <string>         // for operator+, basic_string, string, to_string
+#include <utility>        // for pair, make_pair, operator==
+#include <vector>         // for vector
 
 // clang-format off
 namespace d21 {
 // clang-format on
 
-using Sequence = std::string;
-using Sequences = std::vector<Sequence>;
-
 using Movement = std::pair<Position, Position>;
 using MemoizationKey = std::pair<Movement, size_t>;
+using LengthMemo = std::map<MemoizationKey, size_t>;
 
 constexpr Tile INVALID = 99;
 
@@ -138,11 +138,12 @@ size_t get_numeric_part(const Sequence &sequence) {
   return output;
 }
 
-std::map<MemoizationKey, size_t> previous_lengths;
-
+// The memo is owned by the caller rather than being global, so that both parts
+// can be solved at the same time on different threads
 size_t calc_length_at_level(const Position &start_position,
                             const Position &target_position,
-                            const size_t num_robots) {
+                            const size_t num_robots,
+                            LengthMemo &previous_lengths) {
 
   const auto movement = std::make_pair(start_position, target_position);
   const auto key = std::make_pair(movement, num_robots);
@@ -162,14 +163,16 @@ size_t calc_length_at_level(const Position &start_position,
   auto last_position = DIRECTION_PAD_POSITIONS.at(ENTER_KEY);
   for (const auto tile : sequence) {
     auto next_position = DIRECTION_PAD_POSITIONS.at(tile);
-    sum += calc_length_at_level(last_position, next_position, num_robots - 1);
+    sum += calc_length_at_level(last_position, next_position, num_robots - 1,
+                                previous_lengths);
     last_position = next_position;
   }
   previous_lengths[key] = sum;
   return sum;
 }
 
-size_t get_total_length(const Sequence &sequence, size_t num_robots) {
+size_t get_total_length(const Sequence &sequence, size_t num_robots,
+                        LengthMemo &previous_lengths) {
   auto last_position = NUMBER_PAD_POSITIONS.at(ENTER_KEY);
   size_t sum{};
   auto last_dir_position = DIRECTION_PAD_POSITIONS.at(ENTER_KEY);
@@ -180,7 +183,7 @@ size_t get_total_length(const Sequence &sequence, size_t num_robots) {
     for (const auto sequence_tile : number_sequence) {
       auto next_dir_position = DIRECTION_PAD_POSITIONS.at(sequence_tile);
       sum += calc_length_at_level(last_dir_position, next_dir_position,
-                                  num_robots - 1);
+                                  num_robots - 1, previous_lengths);
       last_dir_position = next_dir_position;
     }
     last_position = next_position;
@@ -188,30 +191,40 @@ size_t get_total_length(const Sequence &sequence, size_t num_robots) {
   return sum;
 }
 
-std::string part_1(const std::string &filepath) {
-  const auto sequences = get_lines_from_file(filepath);
+Sequences Solution::parse(const InputView &input) {
+  return get_lines(input);
+}
 
+std::string Solution::solve_part_1(const Sequences &sequences) {
+  LengthMemo previous_lengths;
   size_t complexity{};
   for (const auto &sequence : sequences) {
-    const size_t length = get_total_length(sequence, 2);
+    const size_t length = get_total_length(sequence, 2, previous_lengths);
     complexity += (length * get_numeric_part(sequence));
   }
 
   return std::to_string(complexity);
 }
 
-std::string part_2(const std::string &filepath) {
-  const auto sequences = get_lines_from_file(filepath);
-
+std::string Solution::solve_part_2(const Sequences &sequences) {
+  LengthMemo previous_lengths;
   size_t complexity{};
   for (const auto &sequence : sequences) {
-    const size_t length = get_total_length(sequence, 25);
+    const size_t length = get_total_length(sequence, 25, previous_lengths);
     complexity += (length * get_numeric_part(sequence));
   }
 
   return std::to_string(complexity);
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 // clang-format off
 } // namespace d21
 // clang-format on
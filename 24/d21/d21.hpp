@@ -1,10 +1,25 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 // clang-format off
 namespace d21 {
 
+  using Sequence = std::string;
+  using Sequences = std::vector<Sequence>;
+
+  struct Solution {
+    using Input = Sequences;
+
+    static Input parse(const InputView &input);
+
+    static std::string solve_part_1(const Input &sequences);
+
+    static std::string solve_part_2(const Input &sequences);
+  };
+
   std::string part_1(const std::string &filepath);
 
   std::string part_2(const std::string &filepath);
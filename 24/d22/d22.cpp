@@ -1,31 +1,40 @@
+#include <arena.hpp> // for Arena
+#include <cstdint>   // for uint32_t
 #include <d22.hpp>
-#include <fstream>  // for basic_istream, basic_ifstream, ifstream
-#include <map>      // for map
-#include <set>      // for set, __tree_const_iterator
-#include <stddef.h> // for size_t
-#include <tuple>    // for make_tuple, tuple
-#include <utility>  // for make_pair, pair
-#include <vector>   // for vector
+#include <input_view.hpp>    // for InputView
+#include <map>               // for map
+#include <multiversion.hpp>  // for AOC_TARGET_CLONES
+#include <record_stream.hpp> // for stream_records
+#include <scanner.hpp>       // for Scanner
+#include <set>               // for set, __tree_const_iterator
+#include <solver.hpp>        // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>          // for size_t
+#include <string>            // for string, to_string
+#include <string_view>       // for string_view
+#include <tuple>             // for make_tuple, tuple
+#include <utility>           // for make_pair, pair
+#include <vector>            // for vector
 
 // clang-format off
 namespace d22 {
 // clang-format on
 
-using Value = long long;
-
-using Values = std::vector<Value>;
-
-Values get_values_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+Values get_values(const InputView &input) {
+  Scanner scanner(input.data());
 
   Values values;
-  Value value;
-  while (in_stream >> value) {
-    values.push_back(value);
+  while (scanner.skip_to_int()) {
+    values.push_back(Value(scanner.next_int()));
   }
   return values;
 }
 
+Value parse_value(const std::string_view line) {
+  Scanner scanner(line);
+  scanner.skip_any(" ");
+  return Value(scanner.next_int());
+}
+
 Value mix(const Value left, const Value right) {
   return left ^ right;
 }
@@ -60,19 +69,52 @@ Value generate_next_secret_number(const Value value) {
   return output;
 }
 
-Value calc_nth_secret_number(const Value value, const size_t n) {
-  Value output = value;
-  for (size_t index{}; index < n; ++index) {
-    output = generate_next_secret_number(output);
+constexpr size_t NUM_SECRET_NUMBERS = 2000;
+
+// Buyers generated side by side at a time
+constexpr size_t SECRET_NUMBER_BATCH_SIZE = 1024;
+
+using SecretNumber = uint32_t;
+
+// Moves every buyer's secret number on steps times, all buyers in lock step
+// so that the inner loop runs across buyers in vector lanes. Every secret
+// number fits in 24 bits after pruning, so 32 bit lanes do: whatever a
+// multiply pushes past bit 32 would be pruned away anyway.
+AOC_TARGET_CLONES
+void advance_secret_numbers(SecretNumber *numbers, const size_t count,
+                            const size_t steps) {
+  constexpr SecretNumber PRUNE_MASK = 16777216U - 1;
+  for (size_t step{}; step < steps; ++step) {
+    for (size_t index{}; index < count; ++index) {
+      SecretNumber number = numbers[index];
+      number = (number ^ (number << 6)) & PRUNE_MASK;
+      number = (number ^ (number >> 5)) & PRUNE_MASK;
+      number = (number ^ (number << 11)) & PRUNE_MASK;
+      numbers[index] = number;
+    }
   }
-  return output;
 }
 
-Value get_total_sum_of_2000th_secret_number(const Values &values) {
+// Over either the parsed values or a stream of them
+template <typename ValueRange>
+Value get_total_sum_of_2000th_secret_number(ValueRange &&values) {
   Value output{};
+  std::vector<SecretNumber> batch;
+  batch.reserve(SECRET_NUMBER_BATCH_SIZE);
+  const auto sum_batch = [&]() {
+    advance_secret_numbers(batch.data(), batch.size(), NUM_SECRET_NUMBERS);
+    for (const auto number : batch) {
+      output += number;
+    }
+    batch.clear();
+  };
   for (const auto value : values) {
-    output += calc_nth_secret_number(value, 2000);
+    batch.push_back(SecretNumber(value));
+    if (batch.size() == SECRET_NUMBER_BATCH_SIZE) {
+      sum_batch();
+    }
   }
+  sum_batch();
   return output;
 }
 
@@ -95,15 +137,22 @@ calc_2000_secret_numbers_and_change_sequence(const Value value) {
   return std::make_pair(prices, changes);
 }
 
-Value get_most_bananas(const Values values) {
+// Only the totals per sequence are kept across buyers, of which there are at
+// most 19^4 however many buyers there are, so a stream of values works too
+template <typename ValueRange> Value get_most_bananas(ValueRange &&values) {
   using PriceChangeSequence = std::tuple<Value, Value, Value, Value>;
-  std::set<PriceChangeSequence> all_sequences;
-  std::map<PriceChangeSequence, Value> first_values;
-  std::set<PriceChangeSequence> seen;
+  Arena arena;
+  std::pmr::set<PriceChangeSequence> all_sequences(arena.resource());
+  std::pmr::map<PriceChangeSequence, Value> first_values(arena.resource());
+  // Only needed for one buyer at a time, so it gets an arena of its own that
+  // is emptied between buyers
+  Arena seen_arena;
+  std::pmr::set<PriceChangeSequence> seen(seen_arena.resource());
   for (const auto value : values) {
     const auto [prices, changes] =
         calc_2000_secret_numbers_and_change_sequence(value);
     seen.clear();
+    seen_arena.release();
     for (size_t index = 3; index < changes.size(); ++index) {
       PriceChangeSequence sequence =
           std::make_tuple(changes[index - 3], changes[index - 2],
@@ -127,18 +176,36 @@ Value get_most_bananas(const Values values) {
   return most_bananas;
 }
 
-std::string part_1(const std::string &filepath) {
-  const auto values = get_values_from_file(filepath);
+Values Solution::parse(const InputView &input) {
+  return get_values(input);
+}
 
+std::string Solution::solve_part_1(const Values &values) {
   return std::to_string(get_total_sum_of_2000th_secret_number(values));
 }
 
-std::string part_2(const std::string &filepath) {
-  const auto values = get_values_from_file(filepath);
-
+std::string Solution::solve_part_2(const Values &values) {
   return std::to_string(get_most_bananas(values));
 }
 
+std::string Solution::stream_part_1(const std::string &filepath) {
+  return std::to_string(get_total_sum_of_2000th_secret_number(
+      stream_records(filepath, parse_value)));
+}
+
+std::string Solution::stream_part_2(const std::string &filepath) {
+  return std::to_string(
+      get_most_bananas(stream_records(filepath, parse_value)));
+}
+
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 // clang-format off
 } // namespace d22
 // clang-format on
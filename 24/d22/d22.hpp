@@ -1,10 +1,31 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 // clang-format off
 namespace d22 {
 
+  using Value = long long;
+
+  using Values = std::vector<Value>;
+
+  struct Solution {
+    using Input = Values;
+
+    static Input parse(const InputView &input);
+
+    static std::string solve_part_1(const Input &values);
+
+    static std::string solve_part_2(const Input &values);
+
+    // Solved a buyer at a time off the file, in constant memory
+    static std::string stream_part_1(const std::string &filepath);
+
+    static std::string stream_part_2(const std::string &filepath);
+  };
+
   std::string part_1(const std::string &filepath);
 
   std::string part_2(const std::string &filepath);
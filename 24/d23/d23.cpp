@@ -1,50 +1,43 @@
 #include <algorithm> // for sort
+#include <arena.hpp> // for Arena
 #include <d23.hpp>
-#include <deque>    // for deque
-#include <fstream>  // for basic_istream, basic_ifstream, getline, ifstream
-#include <iterator> // for next
-#include <map>      // for map
-#include <numeric>  // for accumulate
-#include <set>      // for set, operator!=, __tree_const_iterator
-#include <stddef.h> // for size_t
-#include <string>   // for allocator, char_traits, string, basic_string
-#include <tuple>    // for make_tuple, tuple
-#include <utility>  // for pair
-#include <vector>   // for vector
+#include <deque>           // for deque
+#include <input_view.hpp>  // for InputView
+#include <iterator>        // for next
+#include <map>             // for map
+#include <memory_resource> // for memory_resource
+#include <numeric>         // for accumulate
+#include <set>             // for set, operator!=, __tree_const_iterator
+#include <solver.hpp>      // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>        // for size_t
+#include <string>          // for allocator, char_traits, string, basic_string
+#include <tuple>           // for make_tuple, tuple
+#include <utility>         // for pair
+#include <vector>          // for vector
 
 // clang-format off
 namespace d23 {
 // clang-format on
 
-using Computer = std::string;
-using Computers = std::vector<Computer>;
-using ConnectedGroup = std::set<Computer>;
 using Connection = std::pair<Computer, Computer>;
 using Connections = std::vector<Connection>;
 
-using AdjacencyList = std::map<Computer, ConnectedGroup>;
-
-using ConnectedGroups = std::set<ConnectedGroup>;
+// Working sets of a single solve, which all live in its arena
+using Clique = std::pmr::set<Computer>;
+using Cliques = std::pmr::set<Clique>;
 
 using ThreeSet = std::tuple<Computer, Computer, Computer>;
 
-using ThreeSets = std::set<ThreeSet>;
-
-struct Network {
-  Computers m_computers;
-  AdjacencyList m_edges;
-};
-
-Connections get_connections_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
+using ThreeSets = std::pmr::set<ThreeSet>;
 
+Connections get_connections(const InputView &input) {
   Connections connections;
 
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
+  for (const auto line : input.lines()) {
     size_t hyphen_pos = line.find("-");
-    Computer computer_a = line.substr(0, hyphen_pos);
-    Computer computer_b =
-        line.substr(hyphen_pos + 1, line.size() - hyphen_pos - 1);
+    Computer computer_a(line.substr(0, hyphen_pos));
+    Computer computer_b(
+        line.substr(hyphen_pos + 1, line.size() - hyphen_pos - 1));
     connections.emplace_back(computer_a, computer_b);
   }
 
@@ -68,8 +61,9 @@ Network create_network_from_connections(const Connections &connections) {
   return network;
 }
 
-ThreeSets find_all_three_sets(const Network &network) {
-  ThreeSets three_sets;
+ThreeSets find_all_three_sets(const Network &network,
+                              std::pmr::memory_resource *memory) {
+  ThreeSets three_sets(memory);
   for (const auto &first_computer : network.m_computers) {
     for (const auto &second_computer : network.m_edges.at(first_computer)) {
       for (const auto &third_computer : network.m_edges.at(second_computer)) {
@@ -90,10 +84,11 @@ ThreeSets find_all_three_sets(const Network &network) {
 }
 
 ThreeSets find_all_three_sets_starts_with(const Network &network,
-                                          const std::string &prefix) {
-  const ThreeSets all_three_sets = find_all_three_sets(network);
+                                          const std::string &prefix,
+                                          std::pmr::memory_resource *memory) {
+  const ThreeSets all_three_sets = find_all_three_sets(network, memory);
 
-  ThreeSets three_sets_starts_with;
+  ThreeSets three_sets_starts_with(memory);
   for (const auto &three_set : all_three_sets) {
     const auto &[computer_a, computer_b, computer_c] = three_set;
     bool does_start_with = (computer_a.find(prefix) == 0) ||
@@ -106,13 +101,14 @@ ThreeSets find_all_three_sets_starts_with(const Network &network,
   return three_sets_starts_with;
 }
 
-ConnectedGroups find_all_cliques(const Network &network) {
+Cliques find_all_cliques(const Network &network,
+                         std::pmr::memory_resource *memory) {
 
   // Want to find every group of computers that is connected to all other
   // computers
 
-  ConnectedGroups cliques;
-  ConnectedGroup in_clique;
+  Cliques cliques(memory);
+  Clique in_clique(memory);
 
   for (const auto &computer : network.m_computers) {
     // For each computer that we're connected to, check if they are all
@@ -127,8 +123,8 @@ ConnectedGroups find_all_cliques(const Network &network) {
         continue;
       }
       // Now found at least two computers not already in a clique
-      ConnectedGroup current_clique{computer, adjacent_computer};
-      std::deque<Computer> computers_to_try;
+      Clique current_clique({computer, adjacent_computer}, memory);
+      std::pmr::deque<Computer> computers_to_try(memory);
       for (const auto &clique_computer : current_clique) {
         const auto &adjacent_computers = network.m_edges.at(clique_computer);
         computers_to_try.insert(computers_to_try.end(),
@@ -168,11 +164,12 @@ ConnectedGroups find_all_cliques(const Network &network) {
   return cliques;
 }
 
-ConnectedGroup find_largest_clique(const Network &network) {
-  const ConnectedGroups all_cliques = find_all_cliques(network);
+Clique find_largest_clique(const Network &network,
+                           std::pmr::memory_resource *memory) {
+  const Cliques all_cliques = find_all_cliques(network, memory);
 
   size_t largest{};
-  ConnectedGroup largest_clique;
+  Clique largest_clique(memory);
   for (const auto &clique : all_cliques) {
     if (clique.size() > largest) {
       largest = clique.size();
@@ -182,24 +179,23 @@ ConnectedGroup find_largest_clique(const Network &network) {
   return largest_clique;
 }
 
-std::string part_1(const std::string &filepath) {
-
-  const auto connections = get_connections_from_file(filepath);
+Network Solution::parse(const InputView &input) {
+  const auto connections = get_connections(input);
 
-  const auto network = create_network_from_connections(connections);
+  return create_network_from_connections(connections);
+}
 
-  const auto three_sets = find_all_three_sets_starts_with(network, "t");
+std::string Solution::solve_part_1(const Network &network) {
+  Arena arena;
+  const auto three_sets =
+      find_all_three_sets_starts_with(network, "t", arena.resource());
 
   return std::to_string(three_sets.size());
 }
 
-std::string part_2(const std::string &filepath) {
-
-  const auto connections = get_connections_from_file(filepath);
-
-  const auto network = create_network_from_connections(connections);
-
-  const auto largest_clique = find_largest_clique(network);
+std::string Solution::solve_part_2(const Network &network) {
+  Arena arena;
+  const auto largest_clique = find_largest_clique(network, arena.resource());
 
   Computers clique(largest_clique.begin(), largest_clique.end());
   std::sort(clique.begin(), clique.end());
@@ -211,6 +207,14 @@ std::string part_2(const std::string &filepath) {
   return clique_names;
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 // clang-format off
 } // namespace d23
 // clang-format on
@@ -1,10 +1,35 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <map>            // for map
+#include <set>            // for set
+#include <string>         // for string
+#include <vector>         // for vector
 
 // clang-format off
 namespace d23 {
 
+  using Computer = std::string;
+  using Computers = std::vector<Computer>;
+  using ConnectedGroup = std::set<Computer>;
+
+  using AdjacencyList = std::map<Computer, ConnectedGroup>;
+
+  struct Network {
+    Computers m_computers;
+    AdjacencyList m_edges;
+  };
+
+  struct Solution {
+    using Input = Network;
+
+    static Input parse(const InputView &input);
+
+    static std::string solve_part_1(const Input &network);
+
+    static std::string solve_part_2(const Input &network);
+  };
+
   std::string part_1(const std::string &filepath);
 
   std::string part_2(const std::string &filepath);
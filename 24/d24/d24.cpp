@@ -2,14 +2,15 @@
 #include <core_lib.hpp> // for do_assert
 #include <d24.hpp>
 #include <deque>            // for deque
-#include <fstream>          // for basic_ostream, operator<<, basic_istream
 #include <initializer_list> // for initializer_list
-#include <iostream>         // for cout
+#include <input_view.hpp>   // for InputView
+#include <iostream>         // for basic_ostream, operator<<, cout
 #include <iterator>         // for back_insert_iterator, back_inserter, next
 #include <map>              // for __map_iterator, operator==, __map_const_...
 #include <memory>           // for unique_ptr
 #include <numeric>          // for accumulate
 #include <set>              // for set, __tree_const_iterator, operator!=
+#include <solver.hpp>       // for solve_part_1_from_file, solve_part_2_from...
 #include <stddef.h>         // for size_t
 #include <stdexcept>        // for runtime_error
 #include <string>           // for char_traits, string, allocator, basic_st...
@@ -22,12 +23,6 @@ namespace d24 {
 
 using FinalDecimal = unsigned long long;
 
-using Value = bool;
-
-using Name = std::string;
-
-enum Operation { AND, OR, XOR };
-
 std::string operation_to_string(const Operation operation) {
   switch (operation) {
   case Operation::AND:
@@ -41,68 +36,16 @@ std::string operation_to_string(const Operation operation) {
   }
 }
 
-struct IntermediateNode;
-
-struct Node {
-  Name m_name;
-  std::set<IntermediateNode *> m_output_nodes;
-
-  Node(const Name &name)
-      : m_name(name) {}
-
-  virtual ~Node() = default;
-
-  virtual Value get_value() const = 0;
-
-  virtual void print() const = 0;
-};
-
-using Nodes = std::map<Name, std::unique_ptr<Node>>;
-
-struct ValueNode : public Node {
-  Value m_value;
-
-  ValueNode(const Name &name, const Value value)
-      : Node(name)
-      , m_value(value) {}
-
-  Value get_value() const override {
-    return m_value;
-  }
-
-  void print() const override {
-    std::cout << m_name << " = " << m_value << std::endl;
-  }
-};
-
-struct IntermediateNode : public Node {
-  Operation m_operation;
-  Node *m_input_a;
-  Node *m_input_b;
-  bool m_is_solved;
-  Value m_final_value;
-
-  IntermediateNode(const Name &name, const Operation operation, Node *input_a,
-                   Node *input_b)
-      : Node(name)
-      , m_operation(operation)
-      , m_input_a(input_a)
-      , m_input_b(input_b)
-      , m_is_solved(false)
-      , m_final_value{} {}
-
-  Value get_value() const override {
-    do_assert(m_is_solved, "Expected this node to have already been solved!");
-    return m_final_value;
-  }
+void ValueNode::print() const {
+  std::cout << m_name << " = " << m_value << std::endl;
+}
 
-  void print() const override {
-    std::cout << m_input_a->m_name << " " << operation_to_string(m_operation)
-              << " " << m_input_b->m_name << " -> " << m_name << std::endl;
-    m_input_a->print();
-    m_input_b->print();
-  }
-};
+void IntermediateNode::print() const {
+  std::cout << m_input_a->m_name << " " << operation_to_string(m_operation)
+            << " " << m_input_b->m_name << " -> " << m_name << std::endl;
+  m_input_a->print();
+  m_input_b->print();
+}
 
 void parse_value_node(Nodes &nodes, const std::string &input) {
   size_t colon_pos = input.find(":");
@@ -168,22 +111,20 @@ bool parse_intermediate_node(Nodes &nodes, const std::string &input) {
   return true;
 }
 
-Nodes get_nodes_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
-
+Nodes get_nodes(const InputView &input) {
   Nodes nodes;
 
   bool consumed_all_values = false;
   std::deque<std::string> lines_to_parse;
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
+  for (const auto line : input.lines()) {
     if (line.size() == 0) {
       consumed_all_values = true;
       continue;
     }
     if (!consumed_all_values) {
-      parse_value_node(nodes, line);
+      parse_value_node(nodes, std::string(line));
     } else {
-      lines_to_parse.push_back(line);
+      lines_to_parse.emplace_back(line);
     }
   }
 
@@ -198,21 +139,20 @@ Nodes get_nodes_from_file(const std::string &filepath) {
   return nodes;
 }
 
-Value solve_node(IntermediateNode *);
+Value solve_node(const IntermediateNode *);
 
-Value get_value_from_node(Node *node) {
-  ValueNode *value_node = dynamic_cast<ValueNode *>(node);
+Value get_value_from_node(const Node *node) {
+  const ValueNode *value_node = dynamic_cast<const ValueNode *>(node);
   if (value_node != nullptr) {
     return value_node->m_value;
   }
-  IntermediateNode *int_node = dynamic_cast<IntermediateNode *>(node);
+  const IntermediateNode *int_node =
+      dynamic_cast<const IntermediateNode *>(node);
   do_assert(int_node != nullptr, "Unable to correctly cast!");
-  Value value = solve_node(int_node);
-  int_node->m_is_solved = true;
-  return value;
+  return solve_node(int_node);
 }
 
-Value solve_node(IntermediateNode *node) {
+Value solve_node(const IntermediateNode *node) {
 
   Value value_a = get_value_from_node(node->m_input_a);
 
@@ -239,23 +179,10 @@ Value solve_node(IntermediateNode *node) {
   return output;
 }
 
-void solve_for_values(Nodes &nodes) {
-  for (auto &[name, node] : nodes) {
-    IntermediateNode *int_node = dynamic_cast<IntermediateNode *>(node.get());
-    if (int_node == nullptr) {
-      continue;
-    }
-    if (int_node->m_is_solved) {
-      continue;
-    }
-    int_node->m_final_value = solve_node(int_node);
-    int_node->m_is_solved = true;
-  }
-}
-
-FinalDecimal get_final_z_decimal_value(Nodes &nodes) {
+// Evaluates just the z outputs, without writing anything back into the nodes
+FinalDecimal get_final_z_decimal_value(const Nodes &nodes) {
   FinalDecimal output{};
-  for (auto &[name, node] : nodes) {
+  for (const auto &[name, node] : nodes) {
     if (name.find("z") != 0) {
       continue;
     }
@@ -264,7 +191,7 @@ FinalDecimal get_final_z_decimal_value(Nodes &nodes) {
       continue;
     }
     FinalDecimal index = (10 * (name[1] - '0')) + (name[2] - '0');
-    output |= FinalDecimal(node->get_value()) << index;
+    output |= FinalDecimal(get_value_from_node(node.get())) << index;
   }
 
   return output;
@@ -488,19 +415,17 @@ std::set<Name> find_mismatched_nodes(const Nodes &nodes) {
   return mismatched;
 }
 
-std::string part_1(const std::string &filepath) {
-  auto nodes = get_nodes_from_file(filepath);
-
-  solve_for_values(nodes);
+Nodes Solution::parse(const InputView &input) {
+  return get_nodes(input);
+}
 
+std::string Solution::solve_part_1(const Nodes &nodes) {
   const auto output = get_final_z_decimal_value(nodes);
 
   return std::to_string(output);
 }
 
-std::string part_2(const std::string &filepath) {
-  auto nodes = get_nodes_from_file(filepath);
-
+std::string Solution::solve_part_2(const Nodes &nodes) {
   auto mismatched_set = find_mismatched_nodes(nodes);
   std::vector<Name> mismatched(mismatched_set.begin(), mismatched_set.end());
 
@@ -514,6 +439,14 @@ std::string part_2(const std::string &filepath) {
   return mismatched_names;
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 // clang-format off
 } // namespace d24
 // clang-format on
@@ -1,10 +1,72 @@
 #pragma once
 
-#include <string> // for string
+#include <input_view.hpp> // for InputView
+#include <map>            // for map
+#include <memory>         // for unique_ptr
+#include <set>            // for set
+#include <string>         // for string
 
 // clang-format off
 namespace d24 {
 
+  using Value = bool;
+
+  using Name = std::string;
+
+  enum Operation { AND, OR, XOR };
+
+  struct IntermediateNode;
+
+  struct Node {
+    Name m_name;
+    std::set<IntermediateNode *> m_output_nodes;
+
+    Node(const Name &name)
+        : m_name(name) {}
+
+    virtual ~Node() = default;
+
+    virtual void print() const = 0;
+  };
+
+  using Nodes = std::map<Name, std::unique_ptr<Node>>;
+
+  struct ValueNode : public Node {
+    Value m_value;
+
+    ValueNode(const Name &name, const Value value)
+        : Node(name)
+        , m_value(value) {}
+
+    void print() const override;
+  };
+
+  struct IntermediateNode : public Node {
+    Operation m_operation;
+    Node *m_input_a;
+    Node *m_input_b;
+
+    IntermediateNode(const Name &name, const Operation operation, Node *input_a,
+                     Node *input_b)
+        : Node(name)
+        , m_operation(operation)
+        , m_input_a(input_a)
+        , m_input_b(input_b) {}
+
+    void print() const override;
+  };
+
+  struct Solution {
+    // The whole circuit, which neither part modifies
+    using Input = Nodes;
+
+    static Input parse(const InputView &input);
+
+    static std::string solve_part_1(const Input &nodes);
+
+    static std::string solve_part_2(const Input &nodes);
+  };
+
   std::string part_1(const std::string &filepath);
 
   std::string part_2(const std::string &filepath);
@@ -1,25 +1,21 @@
+#include <algorithm>    // for sort, unique
 #include <array>        // for array
 #include <core_lib.hpp> // for Grid, Tile
+#include <cstdint>      // for uint8_t
 #include <d25.hpp>
-#include <fstream>  // for basic_istream, basic_ifstream, basic_ostream
-#include <iostream> // for cout
-#include <map>      // for map, __map_iterator
-#include <set>      // for set
-#include <stddef.h> // for size_t
-#include <string>   // for char_traits, string, basic_string, to_string
-#include <utility>  // for make_pair, pair
-#include <vector>   // for vector
+#include <input_view.hpp>   // for InputView
+#include <iostream>         // for cout
+#include <multiversion.hpp> // for AOC_TARGET_CLONES
+#include <solver.hpp>       // for solve_part_1_from_file, solve_part_2_from...
+#include <stddef.h>         // for size_t
+#include <string>           // for char_traits, string, basic_string, to_s...
+#include <utility>          // for move
+#include <vector>           // for vector
 
 // clang-format off
 namespace d25 {
 // clang-format on
 
-using KeyMap = Grid;
-using LockMap = Grid;
-
-using KeyMaps = std::vector<KeyMap>;
-using LockMaps = std::vector<LockMap>;
-
 constexpr size_t NUM_TUMBLERS = 5;
 constexpr size_t MAX_TUMBLER_HEIGHT = 5;
 
@@ -28,35 +24,14 @@ using TumblerHeights = std::array<size_t, NUM_TUMBLERS>;
 constexpr Tile SOLID_TILE = '#';
 constexpr Tile EMPTY_TILE = '#';
 
-TumblerHeights operator+(const TumblerHeights &left,
-                         const TumblerHeights &right) {
-  TumblerHeights out{};
-  for (size_t index{}; index < NUM_TUMBLERS; ++index) {
-    out[index] = left[index] + right[index];
-  }
-  return out;
-}
-
-bool is_valid_tumbler(const TumblerHeights &tumbler) {
-  for (size_t index{}; index < NUM_TUMBLERS; ++index) {
-    if (tumbler[index] > MAX_TUMBLER_HEIGHT) {
-      return false;
-    }
-  }
-  return true;
-}
-
-std::pair<KeyMaps, LockMaps>
-get_key_and_lock_maps_from_file(const std::string &filepath) {
-  std::ifstream in_stream(filepath);
-
+KeysAndLocks get_key_and_lock_maps(const InputView &input) {
   bool parsing_key = false;
   bool parsing_lock = false;
   KeyMaps keys;
   LockMaps locks;
   KeyMap current_key;
   LockMap current_lock;
-  for (std::string line; std::getline(in_stream, line); /*BLANK*/) {
+  for (const auto line : input.lines()) {
     if (line.size() == 0) {
       if (parsing_lock) {
         locks.push_back(current_lock);
@@ -77,9 +52,9 @@ get_key_and_lock_maps_from_file(const std::string &filepath) {
       }
     }
     if (parsing_lock) {
-      current_lock.push_back(line);
+      current_lock.emplace_back(line);
     } else {
-      current_key.push_back(line);
+      current_key.emplace_back(line);
     }
   }
   if (parsing_lock) {
@@ -87,7 +62,7 @@ get_key_and_lock_maps_from_file(const std::string &filepath) {
   } else if (parsing_key) {
     keys.push_back(current_key);
   }
-  return std::make_pair(keys, locks);
+  return {keys, locks};
 }
 
 TumblerHeights get_key_tumbler_heights(const KeyMap &key) {
@@ -123,9 +98,32 @@ void print_tumbler_heights(const TumblerHeights &tumbler_heights) {
   std::cout << std::endl;
 }
 
-size_t get_num_unique_matches(const KeyMaps &keys, const LockMaps &locks) {
+// How many of the locks key fits. Locks are laid out a tumbler at a time,
+// num_locks heights of the first tumbler then num_locks of the next, so that
+// the loop checks a vector of locks at once.
+AOC_TARGET_CLONES
+size_t count_fitting_locks(const uint8_t *key_heights,
+                           const uint8_t *lock_heights,
+                           const size_t num_locks) {
+  size_t count{};
+  for (size_t lock{}; lock < num_locks; ++lock) {
+    bool fits = true;
+    for (size_t tumbler{}; tumbler < NUM_TUMBLERS; ++tumbler) {
+      fits &= key_heights[tumbler] + lock_heights[tumbler * num_locks + lock] <=
+              MAX_TUMBLER_HEIGHT;
+    }
+    count += size_t(fits);
+  }
+  return count;
+}
+
+std::vector<TumblerHeights> sorted_unique(std::vector<TumblerHeights> heights) {
+  std::sort(heights.begin(), heights.end());
+  heights.erase(std::unique(heights.begin(), heights.end()), heights.end());
+  return heights;
+}
 
-  std::map<TumblerHeights, std::set<TumblerHeights>> keys_to_locks;
+size_t get_num_unique_matches(const KeyMaps &keys, const LockMaps &locks) {
 
   std::vector<TumblerHeights> key_tumblers;
   std::vector<TumblerHeights> lock_tumblers;
@@ -138,34 +136,55 @@ size_t get_num_unique_matches(const KeyMaps &keys, const LockMaps &locks) {
     lock_tumblers.push_back(get_lock_tumbler_heights(lock));
   }
 
-  for (const auto &key_tumbler : key_tumblers) {
-    for (const auto &lock_tumbler : lock_tumblers) {
-      TumblerHeights attempt = key_tumbler + lock_tumbler;
-      if (is_valid_tumbler(attempt)) {
-        keys_to_locks[key_tumbler].insert(lock_tumbler);
-      }
+  // Each distinct key and lock is only counted once
+  key_tumblers = sorted_unique(std::move(key_tumblers));
+  lock_tumblers = sorted_unique(std::move(lock_tumblers));
+
+  const size_t num_locks = lock_tumblers.size();
+  std::vector<uint8_t> lock_heights(NUM_TUMBLERS * num_locks);
+  for (size_t lock{}; lock < num_locks; ++lock) {
+    for (size_t tumbler{}; tumbler < NUM_TUMBLERS; ++tumbler) {
+      lock_heights[tumbler * num_locks + lock] =
+          uint8_t(lock_tumblers[lock][tumbler]);
     }
   }
+
   size_t num_valid{};
-  for (const auto &[key, valid_locks] : keys_to_locks) {
-    num_valid += valid_locks.size();
+  for (const auto &key_tumbler : key_tumblers) {
+    std::array<uint8_t, NUM_TUMBLERS> key_heights{};
+    for (size_t tumbler{}; tumbler < NUM_TUMBLERS; ++tumbler) {
+      key_heights[tumbler] = uint8_t(key_tumbler[tumbler]);
+    }
+    num_valid +=
+        count_fitting_locks(key_heights.data(), lock_heights.data(), num_locks);
   }
   return num_valid;
 }
 
-std::string part_1(const std::string &filepath) {
+KeysAndLocks Solution::parse(const InputView &input) {
+  return get_key_and_lock_maps(input);
+}
 
-  const auto [keys, locks] = get_key_and_lock_maps_from_file(filepath);
+std::string Solution::solve_part_1(const KeysAndLocks &keys_and_locks) {
+  const auto &[keys, locks] = keys_and_locks;
 
   size_t num_unique = get_num_unique_matches(keys, locks);
 
   return std::to_string(num_unique);
 }
 
-std::string part_2(const std::string &filepath) {
+std::string Solution::solve_part_2(const KeysAndLocks &keys_and_locks) {
   return std::string("Delivered!");
 }
 
+std::string part_1(const std::string &filepath) {
+  return solve_part_1_from_file<Solution>(filepath);
+}
+
+std::string part_2(const std::string &filepath) {
+  return solve_part_2_from_file<Solution>(filepath);
+}
+
 // clang-format off
 } // namespace d25
 // clang-format on
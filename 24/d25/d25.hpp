@@ -1,10 +1,34 @@
 #pragma once
 
-#include <string> // for string
+#include <core_lib.hpp>   // for Grid
+#include <input_view.hpp> // for InputView
+#include <string>         // for string
+#include <vector>         // for vector
 
 // clang-format off
 namespace d25 {
 
+  using KeyMap = Grid;
+  using LockMap = Grid;
+
+  using KeyMaps = std::vector<KeyMap>;
+  using LockMaps = std::vector<LockMap>;
+
+  struct KeysAndLocks {
+    KeyMaps m_keys;
+    LockMaps m_locks;
+  };
+
+  struct Solution {
+    using Input = KeysAndLocks;
+
+    static Input parse(const InputView &input);
+
+    static std::string solve_part_1(const Input &keys_and_locks);
+
+    static std::string solve_part_2(const Input &keys_and_locks);
+  };
+
   std::string part_1(const std::string &filepath);
 
   std::string part_2(const std::string &filepath);
@@ -0,0 +1,725 @@
+#include <algorithm>      // for min, max, sort, unique
+#include <array>          // for array
+#include <cmath>          // for sqrt, llround
+#include <cstddef>        // for size_t
+#include <cstdint>        // for int64_t, uint64_t
+#include <generators.hpp> // for Random, generate
+#include <optional>       // for optional, nullopt
+#include <ostream>        // for ostream, operator<<, basic_ostream
+#include <set>            // for set
+#include <stdexcept>      // for runtime_error
+#include <string>         // for string, operator+, to_string, stoull
+#include <tuple>          // for tuple
+#include <utility>        // for pair, swap, move, make_pair
+#include <vector>         // for vector
+
+using Grid = std::vector<std::string>;
+
+// How many lines (or numbers, or records) to write, for a puzzle with base of
+// them
+static size_t scaled(const size_t base, const double scale) {
+  return std::max<size_t>(1, size_t(std::llround(double(base) * scale)));
+}
+
+// The side of a square grid with scale times the cells of a base by base one
+static size_t scaled_side(const size_t base, const double scale) {
+  return std::max<size_t>(
+      5, size_t(std::llround(double(base) * std::sqrt(scale))));
+}
+
+static void write_grid(const Grid &grid, std::ostream &out) {
+  for (const auto &row : grid) {
+    out << row << '\n';
+  }
+}
+
+// A maze with exactly one path between any two open cells, carved by a depth
+// first walk over the odd rows and columns. side is rounded up to be odd.
+static Grid carve_maze(Random &random, size_t side) {
+  side |= 1;
+  Grid grid(side, std::string(side, '#'));
+  std::vector<std::pair<size_t, size_t>> stack{{1, 1}};
+  grid[1][1] = '.';
+  while (!stack.empty()) {
+    const auto [row, column] = stack.back();
+    std::vector<std::pair<size_t, size_t>> neighbours;
+    if (row > 2 && grid[row - 2][column] == '#') {
+      neighbours.emplace_back(row - 2, column);
+    }
+    if (row + 3 < side && grid[row + 2][column] == '#') {
+      neighbours.emplace_back(row + 2, column);
+    }
+    if (column > 2 && grid[row][column - 2] == '#') {
+      neighbours.emplace_back(row, column - 2);
+    }
+    if (column + 3 < side && grid[row][column + 2] == '#') {
+      neighbours.emplace_back(row, column + 2);
+    }
+    if (neighbours.empty()) {
+      stack.pop_back();
+      continue;
+    }
+    const auto [next_row, next_column] =
+        neighbours[size_t(random.integer(0, int64_t(neighbours.size()) - 1))];
+    grid[(row + next_row) / 2][(column + next_column) / 2] = '.';
+    grid[next_row][next_column] = '.';
+    stack.emplace_back(next_row, next_column);
+  }
+  return grid;
+}
+
+// Pairs of location ids, some of them repeated on the right
+static void generate_d01(Random &random, const double scale,
+                         std::ostream &out) {
+  constexpr std::array<int64_t, 4> REPEATED = {11111, 22222, 33333, 44444};
+  for (size_t line = 0; line < scaled(1000, scale); ++line) {
+    const int64_t left = random.integer(10000, 99999);
+    const int64_t right = random.chance(0.5)
+                              ? random.integer(10000, 99999)
+                              : REPEATED[size_t(random.integer(0, 3))];
+    out << left << "   " << right << '\n';
+  }
+}
+
+// Reports that mostly step steadily up or down, with the odd bad level
+static void generate_d02(Random &random, const double scale,
+                         std::ostream &out) {
+  constexpr std::array<int64_t, 9> STEPS = {1, 2, 3, 1, 2, 3, 0, 4, -1};
+  for (size_t line = 0; line < scaled(1000, scale); ++line) {
+    const size_t num_levels = size_t(random.integer(5, 8));
+    const int64_t direction = random.chance(0.5) ? 1 : -1;
+    std::vector<int64_t> levels{random.integer(40, 90)};
+    while (levels.size() < num_levels) {
+      levels.push_back(levels.back() +
+                       direction * STEPS[size_t(random.integer(0, 8))]);
+    }
+    if (random.chance(0.3)) {
+      levels[size_t(random.integer(0, int64_t(num_levels) - 1))] +=
+          random.integer(-5, 5);
+    }
+    for (size_t index = 0; index < levels.size(); ++index) {
+      out << (index == 0 ? "" : " ") << levels[index];
+    }
+    out << '\n';
+  }
+}
+
+// Corrupted memory: real instructions, near misses and junk
+static void generate_d03(Random &random, const double scale,
+                         std::ostream &out) {
+  std::string memory;
+  for (size_t token = 0; token < scaled(3000, scale); ++token) {
+    const int64_t kind = random.integer(0, 19);
+    if (kind < 6) {
+      memory += "mul(" + std::to_string(random.integer(1, 999)) + "," +
+                std::to_string(random.integer(1, 999)) + ")";
+    } else if (kind == 6) {
+      memory += "do()";
+    } else if (kind == 7) {
+      memory += "don't()";
+    } else if (kind == 8) {
+      memory += "mul(" + std::to_string(random.integer(1, 9999)) + "," +
+                std::to_string(random.integer(1, 99)) + "]";
+    } else if (kind == 9) {
+      memory += "mul ( " + std::to_string(random.integer(1, 9)) + "," +
+                std::to_string(random.integer(1, 9)) + ")";
+    } else {
+      for (int64_t length = random.integer(1, 6); length > 0; --length) {
+        memory += random.pick("xmul(,)[]!@#$%^&*<>?'d0123456789 ");
+      }
+    }
+  }
+  constexpr size_t LINE_LENGTH = 3000;
+  for (size_t start = 0; start < memory.size(); start += LINE_LENGTH) {
+    out << memory.substr(start, LINE_LENGTH) << '\n';
+  }
+}
+
+static void generate_d04(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t side = scaled_side(140, scale);
+  for (size_t row = 0; row < side; ++row) {
+    std::string line(side, ' ');
+    for (auto &letter : line) {
+      letter = random.pick("XMAS");
+    }
+    out << line << '\n';
+  }
+}
+
+// A rule for every pair of pages, all agreeing with one hidden order, then
+// updates of which some already follow it
+static void generate_d05(Random &random, const double scale,
+                         std::ostream &out) {
+  std::vector<int64_t> pages;
+  for (int64_t page = 10; page < 100; ++page) {
+    pages.push_back(page);
+  }
+  random.shuffle(pages);
+  pages.resize(49);
+
+  std::vector<std::pair<int64_t, int64_t>> rules;
+  for (size_t before = 0; before < pages.size(); ++before) {
+    for (size_t after = before + 1; after < pages.size(); ++after) {
+      rules.emplace_back(pages[before], pages[after]);
+    }
+  }
+  random.shuffle(rules);
+  for (const auto &[before, after] : rules) {
+    out << before << "|" << after << '\n';
+  }
+  out << '\n';
+
+  for (size_t line = 0; line < scaled(200, scale); ++line) {
+    // Indices into pages, so that sorting them puts the update in order
+    std::vector<size_t> update(pages.size());
+    for (size_t index = 0; index < update.size(); ++index) {
+      update[index] = index;
+    }
+    random.shuffle(update);
+    update.resize(size_t(2 * random.integer(2, 11) + 1));
+    if (random.chance(0.4)) {
+      std::sort(update.begin(), update.end());
+    }
+    for (size_t index = 0; index < update.size(); ++index) {
+      out << (index == 0 ? "" : ",") << pages[update[index]];
+    }
+    out << '\n';
+  }
+}
+
+// The first obstruction the guard turns at a second time, if they walk in a
+// loop
+static std::optional<std::pair<size_t, size_t>>
+find_loop_obstruction(const Grid &grid) {
+  constexpr std::array<int64_t, 4> ROW_STEPS = {-1, 0, 1, 0};
+  constexpr std::array<int64_t, 4> COLUMN_STEPS = {0, 1, 0, -1};
+  const int64_t side = int64_t(grid.size());
+  int64_t row = side / 2;
+  int64_t column = side / 2;
+  size_t heading = 0;
+  // Turns taken, by obstruction and heading
+  std::set<std::tuple<int64_t, int64_t, size_t>> turns;
+  while (true) {
+    const int64_t next_row = row + ROW_STEPS[heading];
+    const int64_t next_column = column + COLUMN_STEPS[heading];
+    if (next_row < 0 || next_row >= side || next_column < 0 ||
+        next_column >= side) {
+      return std::nullopt;
+    }
+    if (grid[size_t(next_row)][size_t(next_column)] != '#') {
+      row = next_row;
+      column = next_column;
+      continue;
+    }
+    if (!turns.emplace(next_row, next_column, heading).second) {
+      return std::make_pair(size_t(next_row), size_t(next_column));
+    }
+    heading = (heading + 1) % 4;
+  }
+}
+
+// The solution expects the guard to leave the lab, so obstructions are taken
+// out of any loop they walk into until they do
+static void generate_d06(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t side = scaled_side(130, scale);
+  Grid grid(side, std::string(side, '.'));
+  for (auto &row : grid) {
+    for (auto &cell : row) {
+      cell = random.chance(0.05) ? '#' : '.';
+    }
+  }
+  grid[side / 2][side / 2] = '^';
+  while (const auto obstruction = find_loop_obstruction(grid)) {
+    grid[obstruction->first][obstruction->second] = '.';
+  }
+  write_grid(grid, out);
+}
+
+// Equations built from their own operands, some of them then thrown off
+static void generate_d07(Random &random, const double scale,
+                         std::ostream &out) {
+  for (size_t line = 0; line < scaled(850, scale); ++line) {
+    std::vector<uint64_t> operands(size_t(random.integer(2, 9)));
+    for (auto &operand : operands) {
+      operand = uint64_t(random.integer(1, 99));
+    }
+    uint64_t value = operands.front();
+    for (size_t index = 1; index < operands.size(); ++index) {
+      const int64_t operation = random.integer(0, 4);
+      if (operation < 2) {
+        value += operands[index];
+      } else if (operation < 4) {
+        value *= operands[index];
+      } else {
+        value = std::stoull(std::to_string(value) +
+                            std::to_string(operands[index]));
+      }
+    }
+    if (random.chance(0.4)) {
+      value += uint64_t(random.integer(1, 5));
+    }
+    out << value << ":";
+    for (const auto operand : operands) {
+      out << " " << operand;
+    }
+    out << '\n';
+  }
+}
+
+static void generate_d08(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t side = scaled_side(50, scale);
+  Grid grid(side, std::string(side, '.'));
+  for (size_t antenna = 0; antenna < scaled(200, scale); ++antenna) {
+    grid[size_t(random.integer(0, int64_t(side) - 1))]
+        [size_t(random.integer(0, int64_t(side) - 1))] = random.pick(
+            "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
+  }
+  write_grid(grid, out);
+}
+
+// A disk map that starts and ends with a file
+static void generate_d09(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t length = scaled(19999, scale) | 1;
+  std::string disk_map(length, '0');
+  for (size_t index = 0; index < length; ++index) {
+    disk_map[index] = char('0' + random.integer(index % 2 == 0 ? 1 : 0, 9));
+  }
+  out << disk_map << '\n';
+}
+
+// Heights that mostly climb diagonally, so that trails run a long way
+static void generate_d10(Random &random, const double scale,
+                         std::ostream &out) {
+  constexpr std::array<int64_t, 5> NOISE = {0, 0, 0, 1, -1};
+  const size_t side = scaled_side(50, scale);
+  Grid grid(side, std::string(side, '0'));
+  for (size_t row = 0; row < side; ++row) {
+    for (size_t column = 0; column < side; ++column) {
+      const int64_t height =
+          int64_t(row + column) + NOISE[size_t(random.integer(0, 4))];
+      grid[row][column] = char('0' + (height % 10 + 10) % 10);
+    }
+  }
+  write_grid(grid, out);
+}
+
+static void generate_d11(Random &random, const double scale,
+                         std::ostream &out) {
+  for (size_t stone = 0; stone < scaled(8, scale); ++stone) {
+    out << (stone == 0 ? "" : " ") << random.integer(0, 999999);
+  }
+  out << '\n';
+}
+
+// Random plots smeared downwards a few times, so that regions grow into
+// irregular shapes
+static void generate_d12(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t side = scaled_side(140, scale);
+  Grid grid(side, std::string(side, 'A'));
+  for (auto &row : grid) {
+    for (auto &plot : row) {
+      plot = random.pick("ABCDE");
+    }
+  }
+  for (size_t pass = 0; pass < 4; ++pass) {
+    Grid smeared = grid;
+    for (size_t row = 1; row < side; ++row) {
+      for (size_t column = 0; column < side; ++column) {
+        if (!random.chance(0.5)) {
+          smeared[row][column] = grid[row - 1][column];
+        }
+      }
+    }
+    grid = std::move(smeared);
+  }
+  write_grid(grid, out);
+}
+
+// Claw machines whose prize can mostly be reached
+static void generate_d13(Random &random, const double scale,
+                         std::ostream &out) {
+  for (size_t machine = 0; machine < scaled(320, scale); ++machine) {
+    const int64_t a_x = random.integer(10, 99);
+    const int64_t a_y = random.integer(10, 99);
+    const int64_t b_x = random.integer(10, 99);
+    const int64_t b_y = random.integer(10, 99);
+    const int64_t a_presses = random.integer(1, 100);
+    const int64_t b_presses = random.integer(1, 100);
+    int64_t prize_x = a_x * a_presses + b_x * b_presses;
+    const int64_t prize_y = a_y * a_presses + b_y * b_presses;
+    if (random.chance(0.4)) {
+      prize_x += random.integer(1, 50);
+    }
+    out << (machine == 0 ? "" : "\n") << "Button A: X+" << a_x << ", Y+" << a_y
+        << "\nButton B: X+" << b_x << ", Y+" << b_y << "\nPrize: X=" << prize_x
+        << ", Y=" << prize_y << '\n';
+  }
+}
+
+// Robots on the solution's fixed 101 by 103 floor. The first twenty line up
+// in a row after some number of seconds, to give part 2 something to find.
+static void generate_d14(Random &random, const double scale,
+                         std::ostream &out) {
+  constexpr int64_t WIDTH = 101;
+  constexpr int64_t HEIGHT = 103;
+  const int64_t seconds = random.integer(50, 300);
+  for (size_t robot = 0; robot < scaled(500, scale); ++robot) {
+    const int64_t velocity_x = random.integer(-99, 99);
+    const int64_t velocity_y = random.integer(-99, 99);
+    const int64_t target_x =
+        robot < 20 ? 30 + int64_t(robot) : random.integer(0, WIDTH - 1);
+    const int64_t target_y = robot < 20 ? 40 : random.integer(0, HEIGHT - 1);
+    // Walk back from the target, keeping the position positive
+    const int64_t x =
+        ((target_x - seconds * velocity_x) % WIDTH + WIDTH) % WIDTH;
+    const int64_t y =
+        ((target_y - seconds * velocity_y) % HEIGHT + HEIGHT) % HEIGHT;
+    out << "p=" << x << "," << y << " v=" << velocity_x << "," << velocity_y
+        << '\n';
+  }
+}
+
+static void generate_d15(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t side = scaled_side(50, scale);
+  Grid grid(side, std::string(side, '.'));
+  for (size_t row = 0; row < side; ++row) {
+    for (size_t column = 0; column < side; ++column) {
+      if (row == 0 || column == 0 || row + 1 == side || column + 1 == side ||
+          random.chance(0.05)) {
+        grid[row][column] = '#';
+      } else if (random.chance(0.2)) {
+        grid[row][column] = 'O';
+      }
+    }
+  }
+  grid[side / 2][side / 2] = '@';
+  write_grid(grid, out);
+  out << '\n';
+
+  constexpr size_t LINE_LENGTH = 1000;
+  const size_t num_moves = scaled(20000, scale);
+  for (size_t move = 0; move < num_moves; ++move) {
+    out << random.pick("<>^v");
+    if ((move + 1) % LINE_LENGTH == 0 || move + 1 == num_moves) {
+      out << '\n';
+    }
+  }
+}
+
+// A maze with some walls knocked through, so that there are many equally good
+// paths
+static void generate_d16(Random &random, const double scale,
+                         std::ostream &out) {
+  Grid grid = carve_maze(random, scaled_side(141, scale));
+  const size_t side = grid.size();
+  for (size_t hole = 0; hole < side * side / 30; ++hole) {
+    grid[size_t(random.integer(1, int64_t(side) - 2))]
+        [size_t(random.integer(1, int64_t(side) - 2))] = '.';
+  }
+  grid[side - 2][1] = 'S';
+  grid[1][side - 2] = 'E';
+  write_grid(grid, out);
+}
+
+// The program is fixed, as part 2 relies on its shape, so only the starting
+// register changes
+static void generate_d17(Random &random, const double,
+                         std::ostream &out) {
+  out << "Register A: " << random.integer(1, int64_t(1) << 40)
+      << "\nRegister B: 0\nRegister C: 0\n\n"
+      << "Program: 2,4,1,3,7,5,0,3,1,5,4,4,5,5,3,0\n";
+}
+
+// Whether there is still a way from the top left to the bottom right corner of
+// a side by side memory space once the first num_fallen bytes have fallen
+static bool is_passable(const std::vector<std::pair<int64_t, int64_t>> &bytes,
+                        const size_t num_fallen, const int64_t side) {
+  std::vector<bool> blocked(size_t(side * side));
+  for (size_t index = 0; index < num_fallen; ++index) {
+    blocked[size_t(bytes[index].second * side + bytes[index].first)] = true;
+  }
+  constexpr std::array<std::pair<int64_t, int64_t>, 4> STEPS = {
+      {{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+  std::vector<int64_t> queue{0};
+  blocked[0] = true;
+  for (size_t next = 0; next < queue.size(); ++next) {
+    const int64_t x = queue[next] % side;
+    const int64_t y = queue[next] / side;
+    if (x == side - 1 && y == side - 1) {
+      return true;
+    }
+    for (const auto &[step_x, step_y] : STEPS) {
+      const int64_t new_x = x + step_x;
+      const int64_t new_y = y + step_y;
+      if (new_x < 0 || new_x >= side || new_y < 0 || new_y >= side ||
+          blocked[size_t(new_y * side + new_x)]) {
+        continue;
+      }
+      blocked[size_t(new_y * side + new_x)] = true;
+      queue.push_back(new_y * side + new_x);
+    }
+  }
+  return false;
+}
+
+// The solution fixes the memory space at 71 by 71, so there is no more room
+// to fill at larger scales. Part 1 needs a way through after the first
+// kilobyte has fallen, and part 2 a byte that cuts it off later, which about
+// one shuffle in six misses, so those are shuffled again.
+static void generate_d18(Random &random, const double, std::ostream &out) {
+  constexpr int64_t SIDE = 71;
+  constexpr size_t NUM_BYTES = 3450;
+  constexpr size_t ONE_KILOBYTE = 1024;
+  std::vector<std::pair<int64_t, int64_t>> bytes;
+  for (int64_t x = 0; x < SIDE; ++x) {
+    for (int64_t y = 0; y < SIDE; ++y) {
+      if ((x != 0 || y != 0) && (x != SIDE - 1 || y != SIDE - 1)) {
+        bytes.emplace_back(x, y);
+      }
+    }
+  }
+  do {
+    random.shuffle(bytes);
+  } while (!is_passable(bytes, ONE_KILOBYTE, SIDE) ||
+           is_passable(bytes, NUM_BYTES, SIDE));
+  bytes.resize(NUM_BYTES);
+  for (const auto &[x, y] : bytes) {
+    out << x << "," << y << '\n';
+  }
+}
+
+// Designs made of the towel patterns, some of them then spoiled. No pattern is
+// all green, so a run of green stripes is hard to make.
+static void generate_d19(Random &random, const double scale,
+                         std::ostream &out) {
+  std::set<std::string> unique_patterns;
+  for (size_t pattern = 0; pattern < 150; ++pattern) {
+    std::string stripes;
+    for (int64_t length = random.integer(1, 5); length > 0; --length) {
+      stripes += random.pick("wubrg");
+    }
+    if (stripes.find_first_not_of('g') != std::string::npos) {
+      unique_patterns.insert(stripes);
+    }
+  }
+  const std::vector<std::string> patterns(unique_patterns.begin(),
+                                          unique_patterns.end());
+  for (size_t index = 0; index < patterns.size(); ++index) {
+    out << (index == 0 ? "" : ", ") << patterns[index];
+  }
+  out << "\n\n";
+
+  for (size_t line = 0; line < scaled(400, scale); ++line) {
+    std::string design;
+    for (int64_t count = random.integer(3, 10); count > 0; --count) {
+      design += patterns[size_t(
+          random.integer(0, int64_t(patterns.size()) - 1))];
+    }
+    if (random.chance(0.3)) {
+      design += "ggg";
+    }
+    out << design << '\n';
+  }
+}
+
+static void generate_d20(Random &random, const double scale,
+                         std::ostream &out) {
+  Grid grid = carve_maze(random, scaled_side(141, scale));
+  const size_t side = grid.size();
+  grid[1][1] = 'S';
+  grid[side - 2][side - 2] = 'E';
+  write_grid(grid, out);
+}
+
+static void generate_d21(Random &random, const double scale,
+                         std::ostream &out) {
+  for (size_t line = 0; line < scaled(5, scale); ++line) {
+    out << random.integer(0, 9) << random.integer(0, 9)
+        << random.integer(1, 9) << "A\n";
+  }
+}
+
+static void generate_d22(Random &random, const double scale,
+                         std::ostream &out) {
+  for (size_t line = 0; line < scaled(2000, scale); ++line) {
+    out << random.integer(1, 16777215) << '\n';
+  }
+}
+
+// A sparse random graph with one planted 13 node clique. Names get as many
+// letters as it takes to keep them unique.
+static void generate_d23(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t num_computers = scaled(520, scale);
+  size_t name_length = 2;
+  for (size_t names = 26 * 26; names < 4 * num_computers; names *= 26) {
+    ++name_length;
+  }
+
+  std::set<std::string> unique_names;
+  std::vector<std::string> names;
+  while (names.size() < num_computers) {
+    std::string name;
+    for (size_t letter = 0; letter < name_length; ++letter) {
+      name += random.pick("abcdefghijklmnopqrstuvwxyz");
+    }
+    if (unique_names.insert(name).second) {
+      names.push_back(name);
+    }
+  }
+
+  const auto random_computer = [&]() {
+    return size_t(random.integer(0, int64_t(num_computers) - 1));
+  };
+
+  // Stored lowest first so that duplicates sort next to each other
+  std::vector<std::pair<size_t, size_t>> edges;
+  const auto add_edge = [&](const size_t first, const size_t second) {
+    if (first != second) {
+      edges.emplace_back(std::min(first, second), std::max(first, second));
+    }
+  };
+  for (size_t edge = 0; edge < scaled(3380, scale); ++edge) {
+    add_edge(random_computer(), random_computer());
+  }
+  std::vector<size_t> clique(13);
+  for (auto &computer : clique) {
+    computer = random_computer();
+  }
+  for (size_t first = 0; first < clique.size(); ++first) {
+    for (size_t second = first + 1; second < clique.size(); ++second) {
+      add_edge(clique[first], clique[second]);
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  random.shuffle(edges);
+
+  for (auto [first, second] : edges) {
+    if (random.chance(0.5)) {
+      std::swap(first, second);
+    }
+    out << names[first] << "-" << names[second] << '\n';
+  }
+}
+
+// A ripple carry adder with the outputs of four pairs of gates swapped. The
+// solution reads its z wires into 64 bits, which caps the adder at 63 bits.
+static void generate_d24(Random &random, const double scale,
+                         std::ostream &out) {
+  const size_t num_bits =
+      std::clamp<size_t>(size_t(std::llround(45 * scale)), 8, 63);
+  const auto wire = [](const char prefix, const size_t bit) {
+    return prefix + std::string(bit < 10 ? "0" : "") + std::to_string(bit);
+  };
+
+  for (const char prefix : {'x', 'y'}) {
+    for (size_t bit = 0; bit < num_bits; ++bit) {
+      out << wire(prefix, bit) << ": " << random.integer(0, 1) << '\n';
+    }
+  }
+  out << '\n';
+
+  std::set<std::string> used_names;
+  const auto new_name = [&]() {
+    while (true) {
+      std::string name;
+      for (size_t letter = 0; letter < 3; ++letter) {
+        name += random.pick("abcdefghjkmnpqrstvw");
+      }
+      if (used_names.insert(name).second) {
+        return name;
+      }
+    }
+  };
+
+  std::set<size_t> swapped_bits;
+  while (swapped_bits.size() < 4) {
+    swapped_bits.insert(size_t(random.integer(2, int64_t(num_bits) - 3)));
+  }
+
+  struct Gate {
+    std::string input_a;
+    std::string operation;
+    std::string input_b;
+    std::string output;
+  };
+  std::vector<Gate> gates;
+  std::string carry;
+  for (size_t bit = 0; bit < num_bits; ++bit) {
+    const std::string x = wire('x', bit);
+    const std::string y = wire('y', bit);
+    if (bit == 0) {
+      carry = new_name();
+      gates.push_back({x, "XOR", y, wire('z', 0)});
+      gates.push_back({x, "AND", y, carry});
+      continue;
+    }
+    const std::string half_sum = new_name();
+    const std::string half_carry = new_name();
+    const std::string carried = new_name();
+    const std::string next_carry =
+        bit + 1 == num_bits ? wire('z', num_bits) : new_name();
+    Gate sum{half_sum, "XOR", carry, wire('z', bit)};
+    Gate carry_through{half_sum, "AND", carry, carried};
+    if (swapped_bits.contains(bit)) {
+      std::swap(sum.output, carry_through.output);
+    }
+    gates.push_back({x, "XOR", y, half_sum});
+    gates.push_back({x, "AND", y, half_carry});
+    gates.push_back(sum);
+    gates.push_back(carry_through);
+    gates.push_back({half_carry, "OR", carried, next_carry});
+    carry = next_carry;
+  }
+
+  random.shuffle(gates);
+  for (const auto &gate : gates) {
+    out << gate.input_a << " " << gate.operation << " " << gate.input_b
+        << " -> " << gate.output << '\n';
+  }
+}
+
+static void generate_d25(Random &random, const double scale,
+                         std::ostream &out) {
+  for (size_t schematic = 0; schematic < scaled(250, scale); ++schematic) {
+    std::array<int64_t, 5> heights;
+    for (auto &height : heights) {
+      height = random.integer(0, 5);
+    }
+    const bool is_lock = random.chance(0.5);
+    out << (schematic == 0 ? "" : "\n");
+    for (int64_t row = 0; row < 7; ++row) {
+      for (const auto height : heights) {
+        // Locks hang down from the top row, keys stand up from the bottom one
+        const bool filled = is_lock ? row <= height : row >= 6 - height;
+        out << (filled ? '#' : '.');
+      }
+      out << '\n';
+    }
+  }
+}
+
+using Generator = void (*)(Random &, const double, std::ostream &);
+
+constexpr std::array<Generator, 25> GENERATORS = {
+    generate_d01, generate_d02, generate_d03, generate_d04, generate_d05,
+    generate_d06, generate_d07, generate_d08, generate_d09, generate_d10,
+    generate_d11, generate_d12, generate_d13, generate_d14, generate_d15,
+    generate_d16, generate_d17, generate_d18, generate_d19, generate_d20,
+    generate_d21, generate_d22, generate_d23, generate_d24, generate_d25,
+};
+
+void generate(const int day, Random &random, const double scale,
+              std::ostream &out) {
+  if (day < 1 || day > int(GENERATORS.size())) {
+    throw std::runtime_error("No generator for day " + std::to_string(day));
+  }
+  GENERATORS[size_t(day - 1)](random, scale, out);
+}
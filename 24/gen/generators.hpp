@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t, uint64_t
+#include <ostream>     // for ostream
+#include <random>      // for mt19937_64
+#include <string_view> // for string_view
+#include <utility>     // for swap
+#include <vector>      // for vector
+
+// Source of randomness for the generators. Only the raw output of the engine is
+// used, which the standard pins down exactly: the standard distributions and
+// std::shuffle are free to differ between standard libraries, which would make
+// the same seed give different inputs on different machines.
+class Random {
+public:
+  explicit Random(const uint64_t seed) : m_engine(seed) {}
+
+  // Uniform over [low, high], give or take a modulo bias too small to matter
+  int64_t integer(const int64_t low, const int64_t high) {
+    return low + int64_t(m_engine() % uint64_t(high - low + 1));
+  }
+
+  bool chance(const double probability) {
+    // The top 53 bits as a double in [0, 1)
+    return double(m_engine() >> 11) * 0x1.0p-53 < probability;
+  }
+
+  char pick(const std::string_view choices) {
+    return choices[size_t(integer(0, int64_t(choices.size()) - 1))];
+  }
+
+  template <typename Value>
+  void shuffle(std::vector<Value> &values) {
+    for (size_t index = values.size(); index > 1; --index) {
+      std::swap(values[index - 1],
+                values[size_t(integer(0, int64_t(index) - 1))]);
+    }
+  }
+
+private:
+  std::mt19937_64 m_engine;
+};
+
+// Writes a random input for the given day, in the puzzle's own format. A scale
+// of 1 gives about as much input as the puzzle itself, and the amount of input
+// (lines, cells, digits) grows linearly with scale from there. Grids keep their
+// shape, so their sides grow with the square root of scale.
+//
+// A few days cannot grow, because the solutions fix part of the input: d14 and
+// d18 hard code their grid sizes, d17 runs one fixed program and d24 reads
+// every output into 64 bits. Those get more of whatever is free to grow, up to
+// the limit, or ignore scale altogether.
+//
+// Throws for days outside 1 to 25.
+void generate(const int day, Random &random, const double scale,
+              std::ostream &out);
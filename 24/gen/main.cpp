@@ -0,0 +1,300 @@
+#include <chrono>          // for duration, steady_clock
+#include <cmath>           // for log
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint64_t
+#include <d01.hpp>         // for Solution
+#include <d02.hpp>         // for Solution
+#include <d03.hpp>         // for Solution
+#include <d04.hpp>         // for Solution
+#include <d05.hpp>         // for Solution
+#include <d06.hpp>         // for Solution
+#include <d07.hpp>         // for Solution
+#include <d08.hpp>         // for Solution
+#include <d09.hpp>         // for Solution
+#include <d10.hpp>         // for Solution
+#include <d11.hpp>         // for Solution
+#include <d12.hpp>         // for Solution
+#include <d13.hpp>         // for Solution
+#include <d14.hpp>         // for Solution
+#include <d15.hpp>         // for Solution
+#include <d16.hpp>         // for Solution
+#include <d17.hpp>         // for Solution
+#include <d18.hpp>         // for Solution
+#include <d19.hpp>         // for Solution
+#include <d20.hpp>         // for Solution
+#include <d21.hpp>         // for Solution
+#include <d22.hpp>         // for Solution
+#include <d23.hpp>         // for Solution
+#include <d24.hpp>         // for Solution
+#include <d25.hpp>         // for Solution
+#include <exception>       // for exception
+#include <filesystem>      // for path, create_directories, file_size, remove
+#include <fstream>         // for ofstream
+#include <generators.hpp>  // for Random, generate
+#include <input_view.hpp>  // for InputView
+#include <iomanip>         // for operator<<, setw, setprecision
+#include <ios>             // for fixed
+#include <iostream>        // for basic_ostream, operator<<, endl, cerr, cout
+#include <null_buffer.hpp> // for NullBuffer
+#include <optional>        // for optional, nullopt
+#include <ostream>         // for ostream
+#include <set>             // for set
+#include <solver.hpp>      // for Solver
+#include <sstream>         // for stringstream
+#include <stdexcept>       // for runtime_error
+#include <string>          // for string, stoul, stod, operator+, getline
+#include <vector>          // for vector
+
+// Writes random inputs for any day, at any size, from a seed. The same seed and
+// scale always give the same input, so a slow case can be handed around as a
+// command line rather than a file.
+//
+// Usage: aoc-gen [--seed N] [--scale X] [--day N]... [--output-root DIR]
+//        aoc-gen --fit [--seed N] [--scales X,Y,...] [--day N]...
+//
+// With a single --day and no --output-root, the input goes to stdout. With
+// --output-root it goes to DIR/dNN/input.txt for each day asked for, or every
+// day if none are, which is the layout aoc-bench and aoc-all read from.
+//
+// --fit runs each day on inputs at each of the scales instead, times its
+// phases, and fits the exponent k in time ~ bytes^k to them. Anything well
+// above 1 points at a part that will not keep up with bigger inputs. The times
+// of phases that only take microseconds are mostly noise, so fit over scales
+// large enough to take a few milliseconds.
+
+struct Options {
+  uint64_t seed = 1;
+  double scale = 1.0;
+  std::set<int> days;
+  std::string output_root;
+  bool fit = false;
+  std::vector<double> scales = {1, 2, 4, 8};
+};
+
+std::vector<double> parse_scales(const std::string &value) {
+  std::vector<double> scales;
+  std::stringstream stream(value);
+  std::string scale;
+  while (std::getline(stream, scale, ',')) {
+    scales.push_back(std::stod(scale));
+  }
+  return scales;
+}
+
+Options parse_options(int argc, char *argv[]) {
+  Options options;
+  for (int index = 1; index < argc; ++index) {
+    const std::string arg = argv[index];
+    if (arg == "--fit") {
+      options.fit = true;
+      continue;
+    }
+    if (index + 1 >= argc) {
+      throw std::runtime_error("Missing value for " + arg);
+    }
+    const std::string value = argv[++index];
+    if (arg == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (arg == "--scale") {
+      options.scale = std::stod(value);
+    } else if (arg == "--scales") {
+      options.scales = parse_scales(value);
+    } else if (arg == "--day") {
+      options.days.insert(std::stoi(value));
+    } else if (arg == "--output-root") {
+      options.output_root = value;
+    } else {
+      throw std::runtime_error("Unknown option: " + arg);
+    }
+  }
+  for (const double scale : options.scales) {
+    if (!(scale > 0)) {
+      throw std::runtime_error("Scales have to be positive");
+    }
+  }
+  if (!(options.scale > 0)) {
+    throw std::runtime_error("Scale has to be positive");
+  }
+  if (!options.fit && options.output_root.empty() && options.days.size() != 1) {
+    throw std::runtime_error("Need exactly one --day to write to stdout");
+  }
+  return options;
+}
+
+std::string day_name(const int day) {
+  return std::string(day < 10 ? "d0" : "d") + std::to_string(day);
+}
+
+void write_input(const int day, const uint64_t seed, const double scale,
+                 const std::filesystem::path &filepath) {
+  std::filesystem::create_directories(filepath.parent_path());
+  std::ofstream file(filepath);
+  Random random(seed);
+  generate(day, random, scale, file);
+  if (!file) {
+    throw std::runtime_error("Could not write " + filepath.string());
+  }
+}
+
+struct PhaseTimes {
+  double parse_ms;
+  double part_1_ms;
+  double part_2_ms;
+};
+
+template <typename Function>
+double time_ms(const Function &function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <Solver Solution>
+PhaseTimes time_day(const std::string &filepath) {
+  const InputView input(filepath);
+  std::optional<typename Solution::Input> parsed;
+  PhaseTimes times{};
+  times.parse_ms = time_ms([&]() { parsed.emplace(Solution::parse(input)); });
+  times.part_1_ms = time_ms([&]() { Solution::solve_part_1(*parsed); });
+  times.part_2_ms = time_ms([&]() { Solution::solve_part_2(*parsed); });
+  return times;
+}
+
+using TimeFunction = PhaseTimes (*)(const std::string &);
+
+struct Day {
+  int number;
+  TimeFunction time;
+};
+
+const std::vector<Day> DAYS = {
+    {1, time_day<d01::Solution>},  {2, time_day<d02::Solution>},
+    {3, time_day<d03::Solution>},  {4, time_day<d04::Solution>},
+    {5, time_day<d05::Solution>},  {6, time_day<d06::Solution>},
+    {7, time_day<d07::Solution>},  {8, time_day<d08::Solution>},
+    {9, time_day<d09::Solution>},  {10, time_day<d10::Solution>},
+    {11, time_day<d11::Solution>}, {12, time_day<d12::Solution>},
+    {13, time_day<d13::Solution>}, {14, time_day<d14::Solution>},
+    {15, time_day<d15::Solution>}, {16, time_day<d16::Solution>},
+    {17, time_day<d17::Solution>}, {18, time_day<d18::Solution>},
+    {19, time_day<d19::Solution>}, {20, time_day<d20::Solution>},
+    {21, time_day<d21::Solution>}, {22, time_day<d22::Solution>},
+    {23, time_day<d23::Solution>}, {24, time_day<d24::Solution>},
+    {25, time_day<d25::Solution>},
+};
+
+// Least squares slope of log(time) against log(size)
+std::optional<double> fit_exponent(const std::vector<double> &sizes,
+                                   const std::vector<double> &times) {
+  if (sizes.size() < 2) {
+    return std::nullopt;
+  }
+  double mean_x{};
+  double mean_y{};
+  for (size_t index = 0; index < sizes.size(); ++index) {
+    mean_x += std::log(sizes[index]) / double(sizes.size());
+    mean_y += std::log(times[index]) / double(sizes.size());
+  }
+  double covariance{};
+  double variance{};
+  for (size_t index = 0; index < sizes.size(); ++index) {
+    const double x = std::log(sizes[index]) - mean_x;
+    covariance += x * (std::log(times[index]) - mean_y);
+    variance += x * x;
+  }
+  if (variance == 0) {
+    return std::nullopt;
+  }
+  return covariance / variance;
+}
+
+void fit_day(std::ostream &out, const Day &day, const Options &options) {
+  const std::string name = day_name(day.number);
+  const auto filepath =
+      std::filesystem::temp_directory_path() / ("aoc-gen-" + name + ".txt");
+
+  out << name << std::endl;
+  out << std::setw(10) << "scale" << std::setw(14) << "bytes" << std::setw(12)
+      << "parse_ms" << std::setw(12) << "part_1_ms" << std::setw(12)
+      << "part_2_ms" << std::endl;
+
+  std::vector<double> sizes;
+  std::vector<std::vector<double>> times(3);
+  for (const double scale : options.scales) {
+    write_input(day.number, options.seed, scale, filepath);
+    const auto bytes = std::filesystem::file_size(filepath);
+    out << std::setw(10) << scale << std::setw(14) << bytes;
+    try {
+      const auto phase_times = day.time(filepath.string());
+      out << std::fixed << std::setprecision(3) << std::setw(12)
+          << phase_times.parse_ms << std::setw(12) << phase_times.part_1_ms
+          << std::setw(12) << phase_times.part_2_ms << std::defaultfloat
+          << std::endl;
+      sizes.push_back(double(bytes));
+      times[0].push_back(phase_times.parse_ms);
+      times[1].push_back(phase_times.part_1_ms);
+      times[2].push_back(phase_times.part_2_ms);
+    } catch (const std::exception &error) {
+      out << "  error: " << error.what() << std::endl;
+    }
+  }
+  std::filesystem::remove(filepath);
+
+  out << std::setw(24) << "exponent" << std::fixed << std::setprecision(2);
+  for (const auto &phase_times : times) {
+    const auto exponent = fit_exponent(sizes, phase_times);
+    out << std::setw(12);
+    if (exponent) {
+      out << *exponent;
+    } else {
+      out << "-";
+    }
+  }
+  out << std::defaultfloat << std::endl << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << std::endl;
+    return -1;
+  }
+
+  try {
+    if (!options.fit && options.output_root.empty()) {
+      Random random(options.seed);
+      generate(*options.days.begin(), random, options.scale, std::cout);
+      return 0;
+    }
+
+    if (!options.fit) {
+      for (const auto &day : DAYS) {
+        if (options.days.empty() || options.days.contains(day.number)) {
+          write_input(day.number, options.seed, options.scale,
+                      std::filesystem::path(options.output_root) /
+                          day_name(day.number) / "input.txt");
+        }
+      }
+      return 0;
+    }
+
+    std::ostream out(std::cout.rdbuf());
+    NullBuffer null_buffer;
+    std::cout.rdbuf(&null_buffer);
+    for (const auto &day : DAYS) {
+      if (options.days.empty() || options.days.contains(day.number)) {
+        fit_day(out, day, options);
+      }
+    }
+    std::cout.rdbuf(out.rdbuf());
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
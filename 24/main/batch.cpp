@@ -0,0 +1,142 @@
+#include "batch.hpp"
+#include "answer_cache.hpp"     // for AnswerCache, AnswerKey, hash_bytes
+#include "input_prefetcher.hpp" // for InputPrefetcher
+#include "input_view.hpp"       // for InputView
+#include "registry.hpp"         // for RegisteredDay, DayResult
+#include <algorithm>            // for min, sort
+#include <atomic>               // for atomic
+#include <cstdio>               // for snprintf
+#include <exception>            // for exception
+#include <filesystem>           // for directory_iterator, is_directory, is_...
+#include <mutex>                // for mutex, lock_guard
+#include <ostream>              // for basic_ostream, operator<<, endl, ostream
+#include <sstream>              // for basic_ostringstream, ostringstream
+#include <stdexcept>            // for runtime_error
+#include <string>               // for string, operator+
+#include <thread>               // for thread
+#include <vector>               // for vector
+
+std::vector<std::string>
+expand_batch_paths(const std::vector<std::string> &paths) {
+  std::vector<std::string> filepaths;
+  for (const auto &path : paths) {
+    if (!std::filesystem::is_directory(path)) {
+      filepaths.push_back(path);
+      continue;
+    }
+    std::vector<std::string> directory_files;
+    for (const auto &entry : std::filesystem::directory_iterator(path)) {
+      if (entry.is_regular_file()) {
+        directory_files.push_back(entry.path().string());
+      }
+    }
+    std::sort(directory_files.begin(), directory_files.end());
+    filepaths.insert(filepaths.end(), directory_files.begin(),
+                     directory_files.end());
+  }
+  return filepaths;
+}
+
+static std::string json_string(const std::string &text) {
+  std::string output = "\"";
+  for (const char character : text) {
+    switch (character) {
+    case '"':
+      output += "\\\"";
+      break;
+    case '\\':
+      output += "\\\\";
+      break;
+    case '\n':
+      output += "\\n";
+      break;
+    case '\t':
+      output += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(character) < 0x20) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+        output += escaped;
+      } else {
+        output += character;
+      }
+    }
+  }
+  return output + "\"";
+}
+
+// The whole line for one input, built up before taking the lock on out
+static std::string solve_to_json(const RegisteredDay &day,
+                                 const InputPrefetcher::Loaded &loaded,
+                                 const AnswerCache *cache, bool &failed) {
+  std::ostringstream line;
+  line << "{\"day\": " << json_string(day.id)
+       << ", \"file\": " << json_string(loaded.filepath);
+  try {
+    if (!loaded.input) {
+      throw std::runtime_error(loaded.error);
+    }
+    const InputView &input = *loaded.input;
+    DayResult result;
+    bool cached = false;
+    if (cache) {
+      const AnswerKey key{day.id, day.build_id, hash_bytes(input.data())};
+      auto part_1 = cache->find(key, 1);
+      auto part_2 = cache->find(key, 2);
+      if (part_1 && part_2) {
+        result.part_1 = *part_1;
+        result.part_2 = *part_2;
+        cached = true;
+      } else {
+        result = day.solve(input);
+        cache->store(key, 1, result.part_1);
+        cache->store(key, 2, result.part_2);
+      }
+    } else {
+      result = day.solve(input);
+    }
+    line << ", \"part_1\": " << json_string(result.part_1)
+         << ", \"part_2\": " << json_string(result.part_2)
+         << ", \"parse_ms\": " << result.parse_ms
+         << ", \"part_1_ms\": " << result.part_1_ms
+         << ", \"part_2_ms\": " << result.part_2_ms
+         << ", \"cached\": " << (cached ? "true" : "false");
+    failed = false;
+  } catch (const std::exception &error) {
+    line << ", \"error\": " << json_string(error.what());
+    failed = true;
+  }
+  line << "}";
+  return line.str();
+}
+
+size_t run_batch(const RegisteredDay &day,
+                 const std::vector<std::string> &filepaths,
+                 const size_t num_threads, const AnswerCache *cache,
+                 std::ostream &out) {
+  // Inputs are read ahead, a few per worker, and each worker takes whichever
+  // has been read first, so that reading overlaps with solving
+  InputPrefetcher prefetcher(filepaths, 2 * num_threads);
+  std::atomic<size_t> num_failed{};
+  std::mutex out_mutex;
+  auto worker = [&]() {
+    while (auto loaded = prefetcher.next()) {
+      bool failed = false;
+      const std::string line = solve_to_json(day, *loaded, cache, failed);
+      num_failed += size_t(failed);
+      const std::lock_guard<std::mutex> lock(out_mutex);
+      out << line << std::endl;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < std::min(num_threads, filepaths.size());
+       ++index) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return num_failed;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <iosfwd>  // for ostream
+#include <string>  // for string
+#include <vector>  // for vector
+
+class AnswerCache;
+struct RegisteredDay;
+
+// Every regular file in paths, with each directory swapped for the regular
+// files directly inside it, in sorted order
+std::vector<std::string>
+expand_batch_paths(const std::vector<std::string> &paths);
+
+// Solves the day on every input in filepaths over a pool of threads, writing
+// one JSON object per input to out, on a line of its own, as each one
+// finishes:
+//
+//   {"day": "d07", "file": "...", "part_1": "...", "part_2": "...",
+//    "parse_ms": 0.1, "part_1_ms": 1.0, "part_2_ms": 33.4, "cached": false}
+//
+// An input that fails has "error" in place of the answers and timings.
+// Returns how many failed.
+size_t run_batch(const RegisteredDay &day,
+                 const std::vector<std::string> &filepaths,
+                 const size_t num_threads, const AnswerCache *cache,
+                 std::ostream &out);
@@ -1,24 +1,142 @@
-#include "core_lib.hpp" // for greet_day
-#include AOC_DAY_FILE   // for part_1, part_2 // IWYU pragma: keep
-#include <iostream>     // for char_traits, basic_ostream, operator<<, endl
-
-#define MY_XSTR(a) MY_STR(a)
-#define MY_STR(a) #a
-#define AOC_DAY_ID_STR MY_XSTR(AOC_DAY_ID)
+#include "allocation_counter.hpp" // for ALLOCATION_COUNTING, format_bytes
+#include "answer_cache.hpp"       // for AnswerCache
+#include "batch.hpp"              // for expand_batch_paths, run_batch
+#include "core_lib.hpp"           // for greet_day
+#include "multiversion.hpp"       // for multiversion_level
+#include "null_buffer.hpp"        // for NullBuffer
+#include "perf_counters.hpp"      // for PerfCounters
+#include "registry.hpp"           // for RegisteredDay, RunOptions, find_re...
+#include <algorithm>              // for max
+#include <cstddef>                // for size_t
+#include <iostream>               // for char_traits, basic_ostream, operat...
+#include <optional>               // for optional
+#include <ostream>                // for ostream
+#include <string>                 // for string, operator==, basic_string
+#include <thread>                 // for thread
+#include <vector>                 // for vector
 
+// Usage: aoc [--counters] [--stream] [--no-cache] dNN filepath
+//        aoc --batch [--threads N] [--no-cache] dNN path...
+//        aoc --list
+//
+// Runs any day linked into the binary: all of them for aoc, just the one for
+// each dNN, which can leave the day out.
+//
+// --stream solves each part that the day can stream straight off the file a
+// record at a time, in constant memory, instead of parsing the whole input.
+//
+// --counters wraps each part in hardware performance counters and prints IPC
+// and miss rates after its answer.
+//
+// --batch solves the day on every path given, or every file in each directory
+// given, on a pool of N threads (one per core by default) in this one process.
+// Prints a JSON line per input as each finishes, with its answers and how long
+// the parse and each part took, and exits non zero if any input failed.
+//
+// With AOC_CACHE_DIR set, answers are looked up in and saved to an
+// AnswerCache there, by the day's build and a hash of the input. --no-cache
+// solves every part regardless.
+//
+// --list prints the days linked in, and which build of the multiversioned
+// kernels this CPU runs.
+//
+// A build with AOC_COUNT_ALLOCATIONS on also prints the heap allocations of
+// the parse and of each part, and the peak resident set at the end.
 int main(int argc, char *argv[]) {
-  greet_day(AOC_DAY_ID_STR);
-  if (argc <= 1) {
+  RunOptions options;
+  bool with_counters = false;
+  bool list = false;
+  bool with_cache = true;
+  bool batch = false;
+  size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::string> positional;
+  for (int index = 1; index < argc; ++index) {
+    const std::string arg = argv[index];
+    if (arg == "--counters") {
+      with_counters = true;
+    } else if (arg == "--stream") {
+      options.stream = true;
+    } else if (arg == "--no-cache") {
+      with_cache = false;
+    } else if (arg == "--list") {
+      list = true;
+    } else if (arg == "--batch") {
+      batch = true;
+    } else if (arg == "--threads" && index + 1 < argc) {
+      num_threads = std::max(1ul, std::stoul(argv[++index]));
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  const auto &days = registered_days();
+  if (list) {
+    for (const auto &day : days) {
+      std::cout << day.id << std::endl;
+    }
+    std::cout << "Kernels: " << multiversion_level() << std::endl;
+    return 0;
+  }
+
+  // The day comes first, unless it is the only one linked in
+  const RegisteredDay *day = nullptr;
+  if (days.size() == 1 &&
+      (positional.empty() || find_registered_day(positional[0]) == nullptr)) {
+    day = &days.front();
+  } else if (!positional.empty()) {
+    day = find_registered_day(positional[0]);
+    if (day == nullptr) {
+      std::cerr << "No day " << positional[0] << " in this binary!"
+                << std::endl;
+      return -1;
+    }
+    positional.erase(positional.begin());
+  }
+  if (day == nullptr) {
+    std::cerr << "Must provide day and filepath!" << std::endl;
+    return -1;
+  }
+  if (positional.empty() || (!batch && positional.size() > 1)) {
     std::cerr << "Must provide filepath!" << std::endl;
     return -1;
   }
 
-  std::cout << "Part 1: " << AOC_DAY_ID::part_1(argv[1]) << std::endl;
+  std::optional<AnswerCache> cache;
+  if (with_cache) {
+    cache = AnswerCache::from_environment();
+    options.cache = cache ? &*cache : nullptr;
+  }
+
+  if (batch) {
+    // Anything the days print of their own would break up the JSON lines
+    std::ostream out(std::cout.rdbuf());
+    NullBuffer null_buffer;
+    std::cout.rdbuf(&null_buffer);
+    const size_t num_failed =
+        run_batch(*day, expand_batch_paths(positional), num_threads,
+                  options.cache, out);
+    std::cout.rdbuf(out.rdbuf());
+    return num_failed == 0 ? 0 : 1;
+  }
+
+  options.filepath = positional.front();
 
-  std::cout << "Part 2: " << AOC_DAY_ID::part_2(argv[1]) << std::endl;
+  greet_day(day->id.c_str());
+
+  std::optional<PerfCounters> counters;
+  if (with_counters) {
+    counters.emplace();
+    if (!counters->status().empty()) {
+      std::cerr << counters->status() << std::endl;
+    }
+    options.counters = &*counters;
+  }
+
+  day->run(*day, options);
+
+  if constexpr (ALLOCATION_COUNTING) {
+    std::cout << "Peak RSS: " << format_bytes(peak_rss_bytes()) << std::endl;
+  }
 
   return 0;
 }
-
-#undef MY_STR
-#undef MY_XSTR
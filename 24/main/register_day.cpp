@@ -0,0 +1,19 @@
+#include "registry.hpp"        // for DayRegistrar
+#include "run_day.hpp"         // for run_day, solve_day
+#include AOC_DAY_BUILD_ID_FILE // for AOC_DAY_BUILD_ID // IWYU pragma: keep
+#include AOC_DAY_FILE          // for Solution // IWYU pragma: keep
+
+#define MY_XSTR(a) MY_STR(a)
+#define MY_STR(a) #a
+#define AOC_DAY_ID_STR MY_XSTR(AOC_DAY_ID)
+
+// Compiled once per day, with AOC_DAY_ID and AOC_DAY_FILE naming it, into an
+// object of its own that adds the day to the registry of whichever binary
+// links it in. AOC_DAY_BUILD_ID_FILE is generated by cmake/BuildId.cmake once
+// the day's library is built.
+static const DayRegistrar registrar(AOC_DAY_ID_STR, AOC_DAY_BUILD_ID,
+                                    run_day<AOC_DAY_ID::Solution>,
+                                    solve_day<AOC_DAY_ID::Solution>);
+
+#undef MY_STR
+#undef MY_XSTR
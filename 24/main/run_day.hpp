@@ -0,0 +1,168 @@
+#pragma once
+
+#include "allocation_counter.hpp" // for AllocationCounter, ALLOCATION_COU...
+#include "answer_cache.hpp"       // for AnswerCache, AnswerKey, hash_bytes
+#include "input_view.hpp"         // for InputView
+#include "instrument.hpp"         // for AOC_SCOPE
+#include "perf_counters.hpp"      // for PerfCounters
+#include "registry.hpp"           // for RegisteredDay, RunOptions, DayResult
+#include "solver.hpp"             // for Solver, StreamingBothParts, Stre...
+#include <chrono>                 // for duration, steady_clock
+#include <iostream>               // for char_traits, basic_ostream, operat...
+#include <optional>               // for optional
+#include <string>                 // for string
+#include <utility>                // for move
+
+// Streams the part straight off the file when asked to and the day can,
+// otherwise solves it from the parsed input
+template <Solver Solution>
+std::string
+solve_or_stream_part_1(const std::string &filepath, const bool stream,
+                       const std::optional<typename Solution::Input> &parsed) {
+  if constexpr (StreamingPart1<Solution>) {
+    if (stream) {
+      return Solution::stream_part_1(filepath);
+    }
+  }
+  return Solution::solve_part_1(*parsed);
+}
+
+template <Solver Solution>
+std::string
+solve_or_stream_part_2(const std::string &filepath, const bool stream,
+                       const std::optional<typename Solution::Input> &parsed) {
+  if constexpr (StreamingPart2<Solution>) {
+    if (stream) {
+      return Solution::stream_part_2(filepath);
+    }
+  }
+  return Solution::solve_part_2(*parsed);
+}
+
+// Parses the input once and prints the answer to each part, along with
+// whatever else options asks for. Registered for every day by
+// main/register_day.cpp.
+template <Solver Solution>
+void run_day(const RegisteredDay &day, const RunOptions &options) {
+  const std::string &filepath = options.filepath;
+  PerfCounters *const counters = options.counters;
+
+  // A part already in the cache is neither parsed for nor solved
+  std::optional<InputView> input;
+  std::optional<AnswerKey> key;
+  std::optional<std::string> cached_part_1;
+  std::optional<std::string> cached_part_2;
+  if (options.cache) {
+    input.emplace(filepath);
+    key = AnswerKey{day.id, day.build_id, hash_bytes(input->data())};
+    cached_part_1 = options.cache->find(*key, 1);
+    cached_part_2 = options.cache->find(*key, 2);
+  }
+
+  const bool stream_part_1 = options.stream && StreamingPart1<Solution>;
+  const bool stream_part_2 = options.stream && StreamingPart2<Solution>;
+  if (options.stream && !(stream_part_1 && stream_part_2)) {
+    std::cerr << "Not every part of " << day.id
+              << " streams, parsing the whole input" << std::endl;
+  }
+
+  // Parsed once and shared by both parts, unless neither needs it
+  const bool parse_for_part_1 = !stream_part_1 && !cached_part_1;
+  const bool parse_for_part_2 = !stream_part_2 && !cached_part_2;
+  std::optional<typename Solution::Input> parsed;
+  if (parse_for_part_1 || parse_for_part_2) {
+    if (!input) {
+      input.emplace(filepath);
+    }
+    AllocationCounter parse_allocations;
+    {
+      AOC_SCOPE("parse");
+      parsed.emplace(Solution::parse(*input));
+    }
+    if constexpr (ALLOCATION_COUNTING) {
+      std::cout << "Parse: " << parse_allocations.stop().summary()
+                << std::endl;
+    }
+  }
+
+  // A day that streams both parts in one pass gives both answers in part 1,
+  // the second kept for part 2, which then takes no time
+  std::optional<std::string> streamed_part_2;
+  const auto solve_part_1 = [&]() {
+    if constexpr (StreamingBothParts<Solution>) {
+      if (stream_part_1 && stream_part_2 && !cached_part_2) {
+        auto answers = Solution::stream_both_parts(filepath);
+        streamed_part_2 = std::move(answers.second);
+        return answers.first;
+      }
+    }
+    return solve_or_stream_part_1<Solution>(filepath, stream_part_1, parsed);
+  };
+
+  const auto solve_part_2 = [&]() {
+    if (streamed_part_2) {
+      return *streamed_part_2;
+    }
+    return solve_or_stream_part_2<Solution>(filepath, stream_part_2, parsed);
+  };
+
+  // The counters only run around the solve, so that printing is not counted
+  const auto run_part = [&](const int part, const auto solve,
+                            const std::optional<std::string> &cached) {
+    std::cout << "Part " << part << ": ";
+    if (cached) {
+      std::cout << *cached << std::endl;
+      return;
+    }
+    AllocationCounter allocations;
+    if (counters) {
+      counters->start();
+    }
+    const std::string answer = solve();
+    const auto readings =
+        counters ? counters->stop() : PerfCounters::Readings{};
+    const auto allocation_stats = allocations.stop();
+
+    std::cout << answer << std::endl;
+    if (counters) {
+      std::cout << "  " << readings.summary() << std::endl;
+    }
+    if constexpr (ALLOCATION_COUNTING) {
+      std::cout << "  " << allocation_stats.summary() << std::endl;
+    }
+    if (options.cache) {
+      options.cache->store(*key, part, answer);
+    }
+  };
+
+  {
+    AOC_SCOPE("part_1");
+    run_part(1, solve_part_1, cached_part_1);
+  }
+
+  {
+    AOC_SCOPE("part_2");
+    run_part(2, solve_part_2, cached_part_2);
+  }
+}
+
+template <typename Function> double time_ms(const Function &function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Parses and solves both parts, timing each. Everything a day keeps is local
+// to the call, so inputs can be solved on as many threads as there are.
+template <Solver Solution> DayResult solve_day(const InputView &input) {
+  DayResult result;
+  std::optional<typename Solution::Input> parsed;
+  result.parse_ms = time_ms([&]() { parsed.emplace(Solution::parse(input)); });
+  result.part_1_ms =
+      time_ms([&]() { result.part_1 = Solution::solve_part_1(*parsed); });
+  result.part_2_ms =
+      time_ms([&]() { result.part_2 = Solution::solve_part_2(*parsed); });
+  return result;
+}
@@ -0,0 +1,184 @@
+#include <bit_grid.hpp>  // for BitGrid
+#include <core_lib.hpp>  // for FlatOffset
+#include <cstddef>       // for size_t
+#include <gtest/gtest.h> // for Test, Message, EXPECT_EQ, TestInfo (ptr only)
+#include <random>        // for mt19937_64
+#include <stdexcept>     // for runtime_error
+#include <vector>        // for vector
+
+// BitGrid against a plain vector of bools per row, over widths either side of
+// the 64 bit words and shifts across them
+
+using Cells = std::vector<std::vector<bool>>;
+
+// Widths that end a word early, exactly on one, and just past one
+constexpr size_t WIDTHS[] = {1, 5, 63, 64, 65, 127, 128, 130, 200};
+
+Cells random_cells(std::mt19937_64 &engine, const size_t height,
+                   const size_t width) {
+  Cells cells(height, std::vector<bool>(width));
+  for (auto &row : cells) {
+    for (size_t col = 0; col < width; ++col) {
+      row[col] = engine() % 3 == 0;
+    }
+  }
+  return cells;
+}
+
+BitGrid to_bit_grid(const Cells &cells, const size_t width) {
+  BitGrid grid(cells.size(), width);
+  for (size_t row = 0; row < cells.size(); ++row) {
+    for (size_t col = 0; col < width; ++col) {
+      if (cells[row][col]) {
+        grid.set(row, col);
+      }
+    }
+  }
+  return grid;
+}
+
+// Cell for cell, and no bit set past the width of a row
+void expect_matches(const BitGrid &grid, const Cells &cells) {
+  size_t num_set{};
+  for (size_t row = 0; row < cells.size(); ++row) {
+    for (size_t col = 0; col < grid.width(); ++col) {
+      EXPECT_EQ(grid.test(row, col), cells[row][col])
+          << "at " << row << "," << col << " of width " << grid.width();
+      num_set += cells[row][col];
+    }
+  }
+  EXPECT_EQ(grid.count(), num_set);
+  EXPECT_EQ(grid.none(), num_set == 0);
+  grid.for_each_set([&](const size_t row, const size_t col) {
+    EXPECT_LT(row, grid.height());
+    EXPECT_LT(col, grid.width());
+  });
+}
+
+Cells shift_columns(const Cells &cells, const FlatOffset offset) {
+  Cells shifted(cells.size(), std::vector<bool>(cells.front().size()));
+  const FlatOffset width = FlatOffset(cells.front().size());
+  for (size_t row = 0; row < cells.size(); ++row) {
+    for (FlatOffset col = 0; col < width; ++col) {
+      if (col + offset >= 0 && col + offset < width) {
+        shifted[row][size_t(col + offset)] = cells[row][size_t(col)];
+      }
+    }
+  }
+  return shifted;
+}
+
+Cells shift_rows(const Cells &cells, const FlatOffset offset) {
+  Cells shifted(cells.size(), std::vector<bool>(cells.front().size()));
+  const FlatOffset height = FlatOffset(cells.size());
+  for (FlatOffset row = 0; row < height; ++row) {
+    if (row + offset >= 0 && row + offset < height) {
+      shifted[size_t(row + offset)] = cells[size_t(row)];
+    }
+  }
+  return shifted;
+}
+
+// Across no words, part of one, exactly one, and more, either way, as well as
+// the whole width and past it
+std::vector<FlatOffset> offsets_for(const size_t extent) {
+  std::vector<FlatOffset> offsets;
+  for (const FlatOffset distance :
+       {FlatOffset(0), FlatOffset(1), FlatOffset(3), FlatOffset(63),
+        FlatOffset(64), FlatOffset(65), FlatOffset(100), FlatOffset(extent - 1),
+        FlatOffset(extent), FlatOffset(extent + 1), FlatOffset(2 * extent)}) {
+    offsets.push_back(distance);
+    offsets.push_back(-distance);
+  }
+  return offsets;
+}
+
+TEST(BitGrid, ShiftColumns) {
+  std::mt19937_64 engine(1);
+  for (const size_t width : WIDTHS) {
+    const Cells cells = random_cells(engine, 3, width);
+    for (const FlatOffset offset : offsets_for(width)) {
+      BitGrid grid = to_bit_grid(cells, width);
+      grid.shift_columns(offset);
+      expect_matches(grid, shift_columns(cells, offset));
+    }
+  }
+}
+
+TEST(BitGrid, ShiftRows) {
+  std::mt19937_64 engine(2);
+  for (const size_t width : WIDTHS) {
+    const size_t height = 7;
+    const Cells cells = random_cells(engine, height, width);
+    for (const FlatOffset offset :
+         {0, 1, -1, 3, -3, 6, -6, 7, -7, 8, -8, 20, -20}) {
+      BitGrid grid = to_bit_grid(cells, width);
+      grid.shift_rows(offset);
+      expect_matches(grid, shift_rows(cells, offset));
+    }
+  }
+}
+
+// Shifting east and back west leaves only what did not fall off the east end
+TEST(BitGrid, ShiftColumnsThereAndBack) {
+  std::mt19937_64 engine(3);
+  for (const size_t width : WIDTHS) {
+    const Cells cells = random_cells(engine, 2, width);
+    for (const FlatOffset offset : offsets_for(width)) {
+      BitGrid grid = to_bit_grid(cells, width);
+      grid.shift_columns(offset);
+      grid.shift_columns(-offset);
+      expect_matches(grid,
+                     shift_columns(shift_columns(cells, offset), -offset));
+    }
+  }
+}
+
+TEST(BitGrid, CombineGridsAndRows) {
+  std::mt19937_64 engine(4);
+  for (const size_t width : WIDTHS) {
+    const Cells left = random_cells(engine, 3, width);
+    const Cells right = random_cells(engine, 3, width);
+    Cells either = left;
+    Cells both = left;
+    for (size_t row = 0; row < 3; ++row) {
+      for (size_t col = 0; col < width; ++col) {
+        either[row][col] = left[row][col] || right[row][col];
+        both[row][col] = left[row][col] && right[row][col];
+      }
+    }
+
+    BitGrid grid = to_bit_grid(left, width);
+    grid |= to_bit_grid(right, width);
+    expect_matches(grid, either);
+
+    grid = to_bit_grid(left, width);
+    grid &= to_bit_grid(right, width);
+    expect_matches(grid, both);
+
+    // Row 1 of the left with row 2 of the right, leaving the rest alone
+    Cells expected = left;
+    grid = to_bit_grid(left, width);
+    grid.or_row(1, to_bit_grid(right, width), 2);
+    for (size_t col = 0; col < width; ++col) {
+      expected[1][col] = left[1][col] || right[2][col];
+    }
+    expect_matches(grid, expected);
+
+    expected = left;
+    grid = to_bit_grid(left, width);
+    grid.and_row(1, to_bit_grid(right, width), 2);
+    for (size_t col = 0; col < width; ++col) {
+      expected[1][col] = left[1][col] && right[2][col];
+    }
+    expect_matches(grid, expected);
+  }
+}
+
+TEST(BitGrid, CombineRejectsOtherSizes) {
+  BitGrid grid(2, 64);
+  EXPECT_THROW(grid |= BitGrid(2, 65), std::runtime_error);
+  EXPECT_THROW(grid &= BitGrid(3, 64), std::runtime_error);
+  EXPECT_THROW(grid.or_row(0, BitGrid(1, 63), 0), std::runtime_error);
+  EXPECT_THROW(grid.and_row(0, BitGrid(1, 65), 0), std::runtime_error);
+}
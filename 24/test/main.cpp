@@ -1,33 +1,47 @@
-#include <d01.hpp>       // for part_1, part_2
-#include <d02.hpp>       // for part_1, part_2
-#include <d03.hpp>       // for part_1, part_2
-#include <d04.hpp>       // for part_1, part_2
-#include <d05.hpp>       // for part_1, part_2
-#include <d06.hpp>       // for part_1, part_2
-#include <d07.hpp>       // for part_1, part_2
-#include <d08.hpp>       // for part_1, part_2
-#include <d09.hpp>       // for part_1, part_2
-#include <d10.hpp>       // for part_1, part_2
-#include <d11.hpp>       // for part_1, part_2
-#include <d12.hpp>       // for part_1, part_2
-#include <d13.hpp>       // for part_1, part_2
-#include <d14.hpp>       // for part_1, part_2
-#include <d15.hpp>       // for part_1, part_2
-#include <d16.hpp>       // for part_1, part_2
-#include <d17.hpp>       // for part_1, part_2
-#include <d18.hpp>       // for part_1, part_2
-#include <d19.hpp>       // for part_1, part_2
-#include <d20.hpp>       // for part_1, part_2
-#include <d21.hpp>       // for part_1, part_2
-#include <d22.hpp>       // for part_1, part_2
-#include <d23.hpp>       // for part_1, part_2
-#include <d24.hpp>       // for part_1, part_2
-#include <d25.hpp>       // for part_1, part_2
-#include <fstream>       // for basic_ifstream, getline, basic_ostream, endl
-#include <gtest/gtest.h> // for Test, Message, EXPECT_EQ, TestInfo (ptr only)
-#include <iostream>      // for cout
-#include <string>        // for char_traits, operator+, string, basic_string
-#include <utility>       // for make_pair, pair
+#include <algorithm>        // for copy, find, sort
+#include <answer_cache.hpp> // for AnswerCache, AnswerKey, hash_bytes
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint64_t
+#include <d01.hpp>          // for Solution, Lists, OnlineLists
+#include <d02.hpp>          // for Solution, DampenedChecker
+#include <d03.hpp>          // for Solution
+#include <d04.hpp>          // for Solution
+#include <d05.hpp>          // for Solution
+#include <d06.hpp>          // for Solution
+#include <d07.hpp>          // for Solution
+#include <d08.hpp>          // for Solution
+#include <d09.hpp>          // for Solution
+#include <d10.hpp>          // for Solution
+#include <d11.hpp>          // for Solution
+#include <d12.hpp>          // for Solution
+#include <d13.hpp>          // for Solution
+#include <d14.hpp>          // for Solution
+#include <d15.hpp>          // for Solution
+#include <d16.hpp>          // for Solution
+#include <d17.hpp>          // for Solution
+#include <d18.hpp>          // for Solution
+#include <d19.hpp>          // for Solution
+#include <d20.hpp>          // for Solution
+#include <d21.hpp>          // for Solution
+#include <d22.hpp>          // for Solution
+#include <d23.hpp>          // for Solution
+#include <d24.hpp>          // for Solution
+#include <d25.hpp>          // for Solution
+#include <fstream>          // for basic_ifstream, getline, basic_ostream, endl
+#include <generators.hpp>   // for Random, generate
+#include <gtest/gtest.h>    // for Test, Message, EXPECT_EQ, TestInfo (ptr only)
+#include <input_view.hpp>   // for InputView
+#include <iostream>         // for cout
+#include <limits>           // for numeric_limits
+#include <memory>           // for make_unique
+#include <optional>         // for optional
+#include <registry.hpp>     // for RegisteredDay, find_registered_day
+#include <solver.hpp>       // for Solver
+#include <sstream>          // for stringstream
+#include <stdexcept>        // for runtime_error
+#include <string>           // for char_traits, operator+, string, basic_string
+#include <utility>          // for make_pair, pair, move
+#include <vector>           // for vector
 
 std::pair<std::string, std::string> get_answers(const std::string &filepath) {
   std::ifstream in_stream(filepath);
@@ -43,16 +57,47 @@ std::pair<std::string, std::string> get_answers(const std::string &filepath) {
   return std::make_pair(part_1, part_2);
 }
 
+// From AOC_CACHE_DIR, unless the tests were run with --no-cache
+std::optional<AnswerCache> answer_cache;
+
+// Both answers for the day on the input, from the cache when it has them for
+// this build of the day, otherwise parsed and solved then cached
+template <Solver Solution>
+std::pair<std::string, std::string>
+solve_with_cache(const std::string &day_id, const std::string &filepath) {
+  const InputView input(filepath);
+  std::optional<AnswerKey> key;
+  if (answer_cache) {
+    const RegisteredDay *day = find_registered_day(day_id);
+    if (day == nullptr) {
+      throw std::runtime_error("No registration for " + day_id);
+    }
+    key = AnswerKey{day_id, day->build_id, hash_bytes(input.data())};
+    auto part_1 = answer_cache->find(*key, 1);
+    auto part_2 = answer_cache->find(*key, 2);
+    if (part_1 && part_2) {
+      return std::make_pair(*part_1, *part_2);
+    }
+  }
+  const auto parsed = Solution::parse(input);
+  auto part_1 = Solution::solve_part_1(parsed);
+  auto part_2 = Solution::solve_part_2(parsed);
+  if (answer_cache) {
+    answer_cache->store(*key, 1, part_1);
+    answer_cache->store(*key, 2, part_2);
+  }
+  return std::make_pair(part_1, part_2);
+}
+
 #define MY_XSTR(a) MY_STR(a)
 #define MY_STR(a) #a
 
 #define MY_TEST(DAY_ID)                                                        \
   std::string full_filepath(AOC_TOP_DIR);                                      \
   full_filepath += "/";                                                        \
-  const auto part_1 =                                                          \
-      d##DAY_ID::part_1(full_filepath + "d" MY_XSTR(DAY_ID) "/input.txt");     \
-  const auto part_2 =                                                          \
-      d##DAY_ID::part_2(full_filepath + "d" MY_XSTR(DAY_ID) "/input.txt");     \
+  const auto [part_1, part_2] = solve_with_cache<d##DAY_ID::Solution>(         \
+      "d" MY_XSTR(DAY_ID),                                                     \
+      full_filepath + "d" MY_XSTR(DAY_ID) "/input.txt");                       \
                                                                                \
   const auto [part_1_expected, part_2_expected] =                              \
       get_answers(full_filepath + "d" MY_XSTR(DAY_ID) "/answer.txt");          \
@@ -161,6 +206,191 @@ TEST(Daily, D25) {
   MY_TEST(25);
 }
 
+// Built up a pair at a time, paired differently than sorted, then taken apart
+// again
+TEST(Online, D01) {
+  std::vector<d01::LocationId> list_0;
+  std::vector<d01::LocationId> list_1;
+  d01::OnlineLists online(10);
+
+  // Both answers, against sorting what is left afresh
+  const auto expect_matches_resort = [&]() {
+    d01::Lists lists{list_0, list_1};
+    std::sort(lists.m_list_0.begin(), lists.m_list_0.end());
+    std::sort(lists.m_list_1.begin(), lists.m_list_1.end());
+    EXPECT_EQ(online.size(), list_0.size());
+    EXPECT_EQ(std::to_string(online.total_distance()),
+              d01::Solution::solve_part_1(lists));
+    EXPECT_EQ(std::to_string(online.similarity_score()),
+              d01::Solution::solve_part_2(lists));
+  };
+
+  // The balance crosses zero back and forth, over both single ids and whole
+  // nodes of the tree, and ids repeat within and across the lists
+  const std::vector<std::pair<d01::LocationId, d01::LocationId>> pairs{
+      {3, 9}, {1, 3}, {5, 0}, {6, 0}, {0, 4},
+      {4, 3}, {3, 3}, {9, 5}, {7, 1}, {2, 7}};
+  for (const auto &[id_0, id_1] : pairs) {
+    online.insert(id_0, id_1);
+    list_0.push_back(id_0);
+    list_1.push_back(id_1);
+    expect_matches_resort();
+  }
+
+  EXPECT_THROW(online.erase(8, 3), std::runtime_error);
+  EXPECT_THROW(online.erase(3, 8), std::runtime_error);
+  EXPECT_THROW(online.erase(10, 3), std::runtime_error);
+  expect_matches_resort();
+
+  // Erased in pairs other than the ones they were inserted in
+  const std::vector<std::pair<d01::LocationId, d01::LocationId>> erased{
+      {9, 3}, {3, 0}, {0, 9}, {3, 3}, {7, 5},
+      {1, 1}, {5, 4}, {4, 3}, {2, 0}, {6, 7}};
+  for (const auto &[id_0, id_1] : erased) {
+    online.erase(id_0, id_1);
+    list_0.erase(std::find(list_0.begin(), list_0.end(), id_0));
+    list_1.erase(std::find(list_1.begin(), list_1.end(), id_1));
+    expect_matches_resort();
+  }
+  EXPECT_EQ(online.total_distance(), 0u);
+  EXPECT_EQ(online.similarity_score(), 0u);
+}
+
+TEST(Dampened, D02) {
+  d02::DampenedChecker tolerate_one(1);
+  d02::DampenedChecker tolerate_two(2);
+
+  // Safe as it is
+  const std::vector<int> safe{7, 6, 4, 2, 1};
+  EXPECT_EQ(tolerate_one.check(safe)->num_removed, 0u);
+  EXPECT_EQ(tolerate_one.check(safe)->first_removed, safe.size());
+
+  // The 9 has to go
+  const std::vector<int> one_bad{1, 2, 9, 3, 4};
+  EXPECT_EQ(tolerate_one.check(one_bad)->first_removed, 2u);
+
+  // As do both 9s, and only a tolerance of two allows it
+  const std::vector<int> two_bad{1, 9, 2, 3, 9, 4};
+  EXPECT_FALSE(tolerate_one.check(two_bad));
+  EXPECT_EQ(tolerate_two.check(two_bad)->num_removed, 2u);
+  EXPECT_EQ(tolerate_two.check(two_bad)->first_removed, 1u);
+
+  // Dropping levels off either end
+  const std::vector<int> ends{9, 1, 2, 3, 0};
+  EXPECT_FALSE(tolerate_one.check(ends));
+  EXPECT_EQ(tolerate_two.check(ends)->first_removed, 0u);
+
+  const std::vector<int> unsafe{1, 2, 7, 8, 20, 30};
+  EXPECT_FALSE(tolerate_two.check(unsafe));
+}
+
+// Some shuffles of the bytes leave no way through once the first kilobyte has
+// fallen, which the generator has to weed out
+TEST(Generated, D18) {
+  for (const double scale : {1.0, 2.0}) {
+    for (uint64_t seed = 1; seed <= 40; ++seed) {
+      std::stringstream stream;
+      Random random(seed);
+      generate(18, random, scale, stream);
+      const std::string text = stream.str();
+      auto buffer = std::make_unique<char[]>(text.size());
+      std::copy(text.begin(), text.end(), buffer.get());
+      const InputView input(std::move(buffer), text.size());
+
+      EXPECT_NE(d18::Solution::solve_part_1(d18::Solution::parse(input)),
+                std::to_string(std::numeric_limits<size_t>::max()))
+          << "aoc-gen --day 18 --scale " << scale << " --seed " << seed;
+    }
+  }
+}
+
+#define MY_STREAM_TEST(DAY_ID, PART)                                           \
+  std::string full_filepath(AOC_TOP_DIR);                                      \
+  full_filepath += "/";                                                        \
+  const auto answer = d##DAY_ID::Solution::stream_part_##PART(                 \
+      full_filepath + "d" MY_XSTR(DAY_ID) "/input.txt");                       \
+                                                                               \
+  const auto answers =                                                         \
+      get_answers(full_filepath + "d" MY_XSTR(DAY_ID) "/answer.txt");          \
+                                                                               \
+  EXPECT_EQ(answer, PART == 1 ? answers.first : answers.second);
+
+TEST(Streaming, D01Part1) {
+  MY_STREAM_TEST(01, 1);
+}
+
+TEST(Streaming, D01Part2) {
+  MY_STREAM_TEST(01, 2);
+}
+
+TEST(Streaming, D01BothParts) {
+  std::string full_filepath(AOC_TOP_DIR);
+  full_filepath += "/d01/";
+  const auto answers =
+      d01::Solution::stream_both_parts(full_filepath + "input.txt");
+  EXPECT_EQ(answers, get_answers(full_filepath + "answer.txt"));
+}
+
+TEST(Streaming, D02Part1) {
+  MY_STREAM_TEST(02, 1);
+}
+
+TEST(Streaming, D02Part2) {
+  MY_STREAM_TEST(02, 2);
+}
+
+TEST(Streaming, D07Part1) {
+  MY_STREAM_TEST(07, 1);
+}
+
+TEST(Streaming, D07Part2) {
+  MY_STREAM_TEST(07, 2);
+}
+
+TEST(Streaming, D13Part1) {
+  MY_STREAM_TEST(13, 1);
+}
+
+TEST(Streaming, D13Part2) {
+  MY_STREAM_TEST(13, 2);
+}
+
+TEST(Streaming, D14Part1) {
+  MY_STREAM_TEST(14, 1);
+}
+
+TEST(Streaming, D19Part1) {
+  MY_STREAM_TEST(19, 1);
+}
+
+TEST(Streaming, D19Part2) {
+  MY_STREAM_TEST(19, 2);
+}
+
+TEST(Streaming, D22Part1) {
+  MY_STREAM_TEST(22, 1);
+}
+
+TEST(Streaming, D22Part2) {
+  MY_STREAM_TEST(22, 2);
+}
+
 #undef MY_XSTR
 #undef MY_STR
 #undef MY_TEST
+#undef MY_STREAM_TEST
+
+// Usage: all_tests [gtest flags] [--no-cache]
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  bool with_cache = true;
+  for (int index = 1; index < argc; ++index) {
+    if (std::string(argv[index]) == "--no-cache") {
+      with_cache = false;
+    }
+  }
+  if (with_cache) {
+    answer_cache = AnswerCache::from_environment();
+  }
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,328 @@
+#include <algorithm>      // for sort
+#include <chrono>         // for duration, steady_clock
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <cstdlib>        // for getenv
+#include <d01.hpp>        // for Solution
+#include <d02.hpp>        // for Solution
+#include <d03.hpp>        // for Solution
+#include <d04.hpp>        // for Solution
+#include <d05.hpp>        // for Solution
+#include <d06.hpp>        // for Solution
+#include <d07.hpp>        // for Solution
+#include <d08.hpp>        // for Solution
+#include <d09.hpp>        // for Solution
+#include <d10.hpp>        // for Solution
+#include <d11.hpp>        // for Solution
+#include <d12.hpp>        // for Solution
+#include <d13.hpp>        // for Solution
+#include <d14.hpp>        // for Solution
+#include <d15.hpp>        // for Solution
+#include <d16.hpp>        // for Solution
+#include <d17.hpp>        // for Solution
+#include <d18.hpp>        // for Solution
+#include <d19.hpp>        // for Solution
+#include <d20.hpp>        // for Solution
+#include <d21.hpp>        // for Solution
+#include <d22.hpp>        // for Solution
+#include <d23.hpp>        // for Solution
+#include <d24.hpp>        // for Solution
+#include <d25.hpp>        // for Solution
+#include <filesystem>     // for path, temp_directory_path, remove
+#include <fstream>        // for basic_ofstream, basic_ifstream, getline
+#include <generators.hpp> // for Random, generate
+#include <gtest/gtest.h>  // for Test, Message, ADD_FAILURE, GTEST_SKIP
+#include <input_view.hpp> // for InputView
+#include <iomanip>        // for operator<<, setprecision
+#include <ios>            // for fixed
+#include <map>            // for map
+#include <optional>       // for optional
+#include <random>         // for mt19937_64
+#include <solver.hpp>     // for Solver
+#include <string>         // for string, operator+, stod, stoul, getline
+#include <vector>         // for vector
+
+// Performance regression tests. Each day is timed on an input from the aoc-gen
+// generators, at a scale big enough for every phase to take a while, so that a
+// phase going from linear to quadratic shows up as a many times slowdown. The
+// times are checked against test/perf_baseline.json.
+//
+// Times only compare within one build profile, so everything is skipped
+// unless the baseline was recorded with this build's profile. To allow for
+// faster and slower machines, expected times are scaled by how long a fixed
+// calibration workload takes here against how long it took when the baseline
+// was recorded. The calibration is rerun before every day, as a shared machine
+// can speed up and slow down over the course of a run.
+//
+// The baseline holds the median run of each phase. A phase fails when even
+// the fastest of its runs now is more than the tolerance slower than that.
+// Noise only ever makes a run slower, so a lucky slow run cannot fail a phase,
+// and a lucky fast one when recording cannot set an unreachable baseline.
+//
+// Environment:
+//   AOC_PERF_RECORD=1       record a new baseline instead of checking
+//   AOC_PERF_TOLERANCE=N    allowed slowdown in percent, 50 by default
+//   AOC_PERF_SAMPLES=N      timed runs of each phase, 5 by default
+//   AOC_PERF_BASELINE=FILE  baseline to check or record, instead of the
+//                           checked in one
+
+// Slowdowns smaller than this are put down to timer noise, however large
+// they are relative to a phase that only takes microseconds
+constexpr double MIN_REGRESSION_MS = 0.05;
+
+std::string get_env(const char *name, const std::string &fallback) {
+  const char *value = std::getenv(name);
+  return value == nullptr ? fallback : std::string(value);
+}
+
+template <typename Function>
+double time_ms(const Function &function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// A warmup run, then the given number of timed ones, sorted
+template <typename Function>
+std::vector<double> sample_ms(const size_t num_samples,
+                              const Function &function) {
+  function();
+  std::vector<double> samples;
+  for (size_t index = 0; index < num_samples; ++index) {
+    samples.push_back(time_ms(function));
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples;
+}
+
+double median(const std::vector<double> &sorted_samples) {
+  return sorted_samples[sorted_samples.size() / 2];
+}
+
+// Sorting a fixed set of random numbers: memory and compare bound, like most
+// of the days, and independent of anything in this tree
+void run_calibration() {
+  std::mt19937_64 engine(1);
+  std::vector<uint64_t> numbers(size_t(1) << 16);
+  for (auto &number : numbers) {
+    number = engine();
+  }
+  std::sort(numbers.begin(), numbers.end());
+}
+
+// Holds the baseline for the whole run, and in record mode collects the new
+// one and writes it out at the end
+class PerfEnvironment : public ::testing::Environment {
+public:
+  void SetUp() override {
+    m_filepath = get_env("AOC_PERF_BASELINE",
+                         std::string(AOC_TOP_DIR) + "/test/perf_baseline.json");
+    m_is_recording = get_env("AOC_PERF_RECORD", "0") != "0";
+    m_tolerance = std::stod(get_env("AOC_PERF_TOLERANCE", "50")) / 100;
+    m_num_samples = std::stoul(get_env("AOC_PERF_SAMPLES", "5"));
+    if (!m_is_recording) {
+      read_baseline();
+    }
+  }
+
+  void TearDown() override {
+    if (m_is_recording) {
+      write_baseline();
+    }
+  }
+
+  // Why the run cannot be checked, if it cannot
+  std::optional<std::string> skip_reason() const {
+    if (m_is_recording) {
+      return std::nullopt;
+    }
+    if (m_baseline_profile.empty()) {
+      return "No baseline at " + m_filepath;
+    }
+    if (m_baseline_profile != AOC_BUILD_PROFILE) {
+      return "Baseline was recorded with the " + m_baseline_profile +
+             " profile, this is a " + AOC_BUILD_PROFILE + " build";
+    }
+    return std::nullopt;
+  }
+
+  // Times the calibration workload ahead of a day's phases, and, or in record
+  // mode records, how much slower the machine is now than for the baseline
+  void calibrate(const std::string &name) {
+    const std::string key = name + "/calibration";
+    const double calibration_ms =
+        median(sample_ms(m_num_samples, run_calibration));
+    if (m_is_recording) {
+      m_phase_ms[key] = calibration_ms;
+      return;
+    }
+    m_machine_factor =
+        m_phase_ms.contains(key) ? calibration_ms / m_phase_ms.at(key) : 1.0;
+  }
+
+  // Times one phase, then checks it against the baseline, or in record mode
+  // records it
+  template <typename Function>
+  void check(const std::string &phase, const Function &function) {
+    auto samples = sample_ms(m_num_samples, function);
+    if (m_is_recording) {
+      m_phase_ms[phase] = median(samples);
+      return;
+    }
+    if (!m_phase_ms.contains(phase)) {
+      ADD_FAILURE() << "No baseline for " << phase
+                    << ", record one with AOC_PERF_RECORD=1";
+      return;
+    }
+    const double expected_ms = m_phase_ms.at(phase) * m_machine_factor;
+    const double limit_ms = expected_ms * (1 + m_tolerance);
+    const auto is_over_limit = [&]() {
+      return samples.front() > limit_ms &&
+             samples.front() - expected_ms > MIN_REGRESSION_MS;
+    };
+    // A slow stretch on a shared machine can cover every run of a phase, so
+    // a regression has to show up twice in a row
+    if (is_over_limit()) {
+      samples = sample_ms(m_num_samples, function);
+    }
+    if (is_over_limit()) {
+      ADD_FAILURE() << std::fixed << std::setprecision(3) << phase
+                    << " took " << samples.front() << " ms at best (median "
+                    << median(samples) << " ms), over the limit of "
+                    << limit_ms << " ms: a baseline of "
+                    << m_phase_ms.at(phase) << " ms, times "
+                    << m_machine_factor << " for this machine, plus "
+                    << 100 * m_tolerance << "%";
+    }
+  }
+
+private:
+  // Only reads back what write_baseline writes: one "key": value per line
+  void read_baseline() {
+    std::ifstream in_stream(m_filepath);
+    std::string line;
+    while (std::getline(in_stream, line)) {
+      const size_t key_start = line.find('"');
+      const size_t key_end = line.find('"', key_start + 1);
+      const size_t colon = line.find(':', key_end);
+      if (key_start == std::string::npos || key_end == std::string::npos ||
+          colon == std::string::npos) {
+        continue;
+      }
+      const std::string key =
+          line.substr(key_start + 1, key_end - key_start - 1);
+      const std::string value = line.substr(colon + 1);
+      if (key == "profile") {
+        const size_t value_start = value.find('"') + 1;
+        m_baseline_profile = value.substr(
+            value_start, value.find('"', value_start) - value_start);
+      } else if (key != "phases") {
+        m_phase_ms[key] = std::stod(value);
+      }
+    }
+  }
+
+  void write_baseline() const {
+    std::ofstream out_stream(m_filepath);
+    out_stream << std::fixed << std::setprecision(4);
+    out_stream << "{" << std::endl;
+    out_stream << "  \"profile\": \"" << AOC_BUILD_PROFILE << "\","
+               << std::endl;
+    out_stream << "  \"phases\": {" << std::endl;
+    size_t index = 0;
+    for (const auto &[phase, phase_ms] : m_phase_ms) {
+      out_stream << "    \"" << phase << "\": " << phase_ms
+                 << (++index < m_phase_ms.size() ? "," : "") << std::endl;
+    }
+    out_stream << "  }" << std::endl;
+    out_stream << "}" << std::endl;
+  }
+
+  std::string m_filepath;
+  bool m_is_recording{};
+  double m_tolerance{};
+  size_t m_num_samples{};
+
+  std::string m_baseline_profile;
+  // Median time of each phase, keyed "dNN/phase", including the calibration
+  // run ahead of each day
+  std::map<std::string, double> m_phase_ms;
+  // Of the day being checked
+  double m_machine_factor = 1.0;
+};
+
+PerfEnvironment *const ENVIRONMENT = static_cast<PerfEnvironment *>(
+    ::testing::AddGlobalTestEnvironment(new PerfEnvironment));
+
+template <Solver Solution>
+void check_day(const std::string &name, const double scale) {
+  if (const auto reason = ENVIRONMENT->skip_reason()) {
+    GTEST_SKIP() << *reason;
+  }
+
+  const auto filepath =
+      std::filesystem::temp_directory_path() / ("aoc-perf-" + name + ".txt");
+  {
+    std::ofstream out_stream(filepath);
+    Random random(1);
+    generate(std::stoi(name.substr(1)), random, scale, out_stream);
+  }
+
+  ENVIRONMENT->calibrate(name);
+
+  const InputView input(filepath.string());
+  std::optional<typename Solution::Input> parsed;
+  // Keep the answers alive so that the calls cannot be optimized out
+  std::string answer;
+
+  ENVIRONMENT->check(name + "/parse",
+                     [&]() { parsed.emplace(Solution::parse(input)); });
+  ENVIRONMENT->check(name + "/part_1",
+                     [&]() { answer = Solution::solve_part_1(*parsed); });
+  ENVIRONMENT->check(name + "/part_2",
+                     [&]() { answer = Solution::solve_part_2(*parsed); });
+
+  std::filesystem::remove(filepath);
+}
+
+#define MY_XSTR(a) MY_STR(a)
+#define MY_STR(a) #a
+
+// The scale of each day's input is picked so that its slowest phase takes
+// milliseconds to tens of milliseconds on a Release build
+#define PERF_TEST(DAY_ID, SCALE)                                               \
+  TEST(Perf, D##DAY_ID) {                                                      \
+    check_day<d##DAY_ID::Solution>("d" MY_XSTR(DAY_ID), SCALE);                \
+  }
+
+PERF_TEST(01, 4)
+PERF_TEST(02, 4)
+PERF_TEST(03, 4)
+PERF_TEST(04, 2)
+PERF_TEST(05, 2)
+PERF_TEST(06, 1)
+PERF_TEST(07, 0.5)
+PERF_TEST(08, 4)
+PERF_TEST(09, 1)
+PERF_TEST(10, 4)
+PERF_TEST(11, 1)
+PERF_TEST(12, 1)
+PERF_TEST(13, 8)
+PERF_TEST(14, 2)
+PERF_TEST(15, 4)
+PERF_TEST(16, 0.5)
+PERF_TEST(17, 1)
+PERF_TEST(18, 1)
+PERF_TEST(19, 1)
+PERF_TEST(20, 0.5)
+PERF_TEST(21, 1)
+PERF_TEST(22, 0.1)
+PERF_TEST(23, 1)
+PERF_TEST(24, 1)
+PERF_TEST(25, 2)
+
+#undef MY_XSTR
+#undef MY_STR
+#undef PERF_TEST
@@ -0,0 +1,256 @@
+#include <algorithm>     // for sort, min
+#include <array>         // for array
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint32_t, uint64_t
+#include <gtest/gtest.h> // for Test, Message, EXPECT_EQ, TestInfo (ptr only)
+#include <random>        // for mt19937_64
+#include <search.hpp>    // for SearchState, StateId, NO_STATE, RadixHeap
+#include <span>          // for span
+#include <stdexcept>     // for runtime_error
+#include <utility>       // for pair
+#include <vector>        // for vector
+
+// The searches against relaxing every edge of small graphs until nothing
+// changes, which is too slow for a day but leaves no room for doubt
+
+using Distance = uint32_t;
+
+constexpr Distance UNREACHED = SearchState<Distance>::UNREACHED;
+
+// Directed, as the neighbours of each state with the weight of the step there
+using Edges = std::vector<std::vector<std::pair<StateId, Distance>>>;
+
+std::vector<Distance> brute_force_distances(const Edges &edges,
+                                            std::span<const StateId> sources) {
+  std::vector<Distance> distances(edges.size(), UNREACHED);
+  for (const StateId source : sources) {
+    distances[source] = 0;
+  }
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (StateId state = 0; state < edges.size(); ++state) {
+      if (distances[state] == UNREACHED) {
+        continue;
+      }
+      for (const auto &[neighbour, weight] : edges[state]) {
+        if (distances[state] + weight < distances[neighbour]) {
+          distances[neighbour] = distances[state] + weight;
+          changed = true;
+        }
+      }
+    }
+  }
+  return distances;
+}
+
+// Weights drawn from low to high, and about degree steps out of each state
+Edges random_edges(std::mt19937_64 &engine, const size_t num_states,
+                   const size_t degree, const Distance low,
+                   const Distance high) {
+  Edges edges(num_states);
+  for (auto &neighbours : edges) {
+    for (size_t edge = 0; edge < degree; ++edge) {
+      neighbours.emplace_back(StateId(engine() % num_states),
+                              Distance(low + engine() % (high - low + 1)));
+    }
+  }
+  return edges;
+}
+
+auto unweighted_neighbours(const Edges &edges) {
+  return [&edges](const StateId state, const auto &visit) {
+    for (const auto &[neighbour, weight] : edges[state]) {
+      visit(neighbour);
+    }
+  };
+}
+
+auto weighted_neighbours(const Edges &edges) {
+  return [&edges](const StateId state, const auto &visit) {
+    for (const auto &[neighbour, weight] : edges[state]) {
+      visit(neighbour, weight);
+    }
+  };
+}
+
+// Every state's distance as expected, and the path to each reached state runs
+// from a source along edges adding up to it
+void expect_matches(const SearchState<Distance> &search, const Edges &edges,
+                    const std::vector<Distance> &expected) {
+  for (StateId state = 0; state < edges.size(); ++state) {
+    EXPECT_EQ(search.is_reached(state), expected[state] != UNREACHED);
+    EXPECT_EQ(search.distance(state), expected[state]);
+    if (!search.is_reached(state)) {
+      EXPECT_TRUE(search.path_to(state).empty());
+      continue;
+    }
+    const auto path = search.path_to(state);
+    EXPECT_EQ(expected[path.front()], 0u);
+    EXPECT_EQ(path.back(), state);
+    Distance length{};
+    for (size_t step = 1; step < path.size(); ++step) {
+      Distance cheapest = UNREACHED;
+      for (const auto &[neighbour, weight] : edges[path[step - 1]]) {
+        if (neighbour == path[step]) {
+          cheapest = std::min(cheapest, weight);
+        }
+      }
+      ASSERT_NE(cheapest, UNREACHED);
+      length += cheapest;
+    }
+    EXPECT_EQ(length, expected[state]);
+  }
+}
+
+// 0 -> 1 -> 2 -> 3 -> 6, with 4 stepping to both 0 and 3, and 5 to 0 but
+// never reached itself
+const Edges HAND_BUILT = {
+    {{1, 1}}, {{2, 1}}, {{3, 1}}, {{6, 1}}, {{3, 1}, {0, 1}}, {{0, 1}}, {}};
+
+TEST(Search, BreadthFirstHandBuilt) {
+  SearchState<Distance> search(HAND_BUILT.size());
+  const std::array<StateId, 2> sources{0, 4};
+  EXPECT_EQ(breadth_first_search(search, sources,
+                                 unweighted_neighbours(HAND_BUILT)),
+            NO_STATE);
+  expect_matches(search, HAND_BUILT,
+                 brute_force_distances(HAND_BUILT, sources));
+  EXPECT_EQ(search.distance(3), 1u);
+  EXPECT_EQ(search.distance(6), 2u);
+  EXPECT_FALSE(search.is_reached(5));
+
+  // Stops at the first target settled, the nearer of the two
+  EXPECT_EQ(breadth_first_search(
+                search, std::array<StateId, 1>{0},
+                unweighted_neighbours(HAND_BUILT),
+                [](const StateId state) { return state == 3 || state == 6; }),
+            3u);
+  EXPECT_EQ(search.distance(3), 3u);
+  EXPECT_EQ(search.path_to(3), (std::vector<StateId>{0, 1, 2, 3}));
+}
+
+TEST(Search, BreadthFirstRandom) {
+  std::mt19937_64 engine(1);
+  for (size_t graph = 0; graph < 200; ++graph) {
+    const Edges edges = random_edges(engine, 12, 2, 1, 1);
+    const std::array<StateId, 2> sources{StateId(engine() % 12),
+                                         StateId(engine() % 12)};
+    SearchState<Distance> search(edges.size());
+    breadth_first_search(search, sources, unweighted_neighbours(edges));
+    expect_matches(search, edges, brute_force_distances(edges, sources));
+  }
+}
+
+TEST(Search, ZeroOneBreadthFirstRandom) {
+  std::mt19937_64 engine(2);
+  // Shared across graphs, as the days share one across searches
+  SearchState<Distance> search(12);
+  for (size_t graph = 0; graph < 200; ++graph) {
+    const Edges edges = random_edges(engine, 12, 3, 0, 1);
+    const std::array<StateId, 2> sources{StateId(engine() % 12),
+                                         StateId(engine() % 12)};
+    const auto expected = brute_force_distances(edges, sources);
+    zero_one_breadth_first_search(search, sources, weighted_neighbours(edges));
+    expect_matches(search, edges, expected);
+
+    // Stopping at a target settles it at its shortest distance
+    const StateId target = StateId(engine() % 12);
+    const StateId found = zero_one_breadth_first_search(
+        search, sources, weighted_neighbours(edges),
+        [target](const StateId state) { return state == target; });
+    if (expected[target] == UNREACHED) {
+      EXPECT_EQ(found, NO_STATE);
+    } else {
+      EXPECT_EQ(found, target);
+      EXPECT_EQ(search.distance(target), expected[target]);
+    }
+  }
+}
+
+TEST(Search, ZeroOneBreadthFirstRejectsHeavierSteps) {
+  SearchState<Distance> search(2);
+  const Edges edges = {{{1, 2}}, {}};
+  EXPECT_THROW(zero_one_breadth_first_search(search, std::array<StateId, 1>{0},
+                                             weighted_neighbours(edges)),
+               std::runtime_error);
+}
+
+TEST(Search, DijkstraAndAStarRandom) {
+  std::mt19937_64 engine(3);
+  SearchState<Distance> search(15);
+  for (size_t graph = 0; graph < 200; ++graph) {
+    const Edges edges = random_edges(engine, 15, 3, 0, 20);
+    const std::array<StateId, 2> sources{StateId(engine() % 15),
+                                         StateId(engine() % 15)};
+    const auto expected = brute_force_distances(edges, sources);
+    dijkstra_search(search, sources, weighted_neighbours(edges));
+    expect_matches(search, edges, expected);
+
+    // The exact distance left to the target is the best consistent heuristic,
+    // and half of it a weaker one. States the target cannot be reached from
+    // get more than any path's length, as dropping to nothing at them would
+    // not be consistent.
+    const StateId target = StateId(engine() % 15);
+    Edges reversed(edges.size());
+    for (StateId state = 0; state < edges.size(); ++state) {
+      for (const auto &[neighbour, weight] : edges[state]) {
+        reversed[neighbour].emplace_back(state, weight);
+      }
+    }
+    const auto distances_left =
+        brute_force_distances(reversed, std::array<StateId, 1>{target});
+    for (const uint64_t divisor : {1, 2}) {
+      const StateId found = a_star_search(
+          search, sources, weighted_neighbours(edges),
+          [&](const StateId state) {
+            return distances_left[state] == UNREACHED
+                       ? uint64_t(15 * 20 + 1)
+                       : distances_left[state] / divisor;
+          },
+          [target](const StateId state) { return state == target; });
+      if (expected[target] == UNREACHED) {
+        EXPECT_EQ(found, NO_STATE);
+      } else {
+        EXPECT_EQ(found, target);
+        EXPECT_EQ(search.distance(target), expected[target]);
+      }
+    }
+  }
+}
+
+TEST(Search, RadixHeapPopsInOrder) {
+  std::mt19937_64 engine(4);
+  RadixHeap<size_t> heap;
+  // The key of every value pushed, and those not yet popped
+  std::vector<uint64_t> keys;
+  std::vector<uint64_t> left;
+  uint64_t last{};
+  for (size_t round = 0; round < 1000; ++round) {
+    // Keys anywhere at or above the last pop, far apart and close together
+    for (size_t push = engine() % 4; push > 0; --push) {
+      const uint64_t key =
+          last + (engine() % 2 == 0 ? engine() % 8 : engine() >> 20);
+      heap.push(key, keys.size());
+      keys.push_back(key);
+      left.push_back(key);
+    }
+    if (heap.empty()) {
+      EXPECT_TRUE(left.empty());
+      continue;
+    }
+    const auto [key, value] = heap.pop();
+    std::sort(left.begin(), left.end());
+    EXPECT_EQ(key, left.front());
+    EXPECT_EQ(keys[value], key);
+    left.erase(left.begin());
+    last = key;
+  }
+}
+
+TEST(Search, RadixHeapRejectsKeysBelowLastPop) {
+  RadixHeap<size_t> heap;
+  heap.push(10, 0);
+  heap.pop();
+  EXPECT_THROW(heap.push(9, 1), std::runtime_error);
+}